@@ -0,0 +1,196 @@
+#include "BlockDecoder.hpp"
+#include <algorithm>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#elif defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+namespace southbound {
+
+namespace {
+
+constexpr bool LITTLE_ENDIAN_HOST = __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__;
+
+inline uint16_t swap16(uint16_t v) {
+    return static_cast<uint16_t>((v << 8) | (v >> 8));
+}
+
+/**
+ * 将寄存器重排为小端主机上 W 个寄存器宽的数值的内存表示
+ * 高字在前（ABCD/BADC）时反转每组 W 个寄存器的顺序；BADC/DCBA 交换每个寄存器的两个字节。
+ * 向量宽度（8 或 16 个寄存器）是 W 的整数倍，重排不会跨越数值边界。
+ * @param src 寄存器
+ * @param dst 输出字节
+ * @param registers 寄存器个数（W 的整数倍）
+ */
+template <int W>
+void reorder(const uint16_t* src, uint8_t* dst, size_t registers, bool reverse_words, bool swap_bytes) {
+    size_t i = 0;
+#if defined(__ARM_NEON)
+    for (; i + 8 <= registers; i += 8) {
+        uint16x8_t v = vld1q_u16(src + i);
+        if constexpr (W == 2) {
+            if (reverse_words) v = vrev32q_u16(v);
+        } else if constexpr (W == 4) {
+            if (reverse_words) v = vrev64q_u16(v);
+        }
+        if (swap_bytes) {
+            v = vreinterpretq_u16_u8(vrev16q_u8(vreinterpretq_u8_u16(v)));
+        }
+        vst1q_u8(dst + 2 * i, vreinterpretq_u8_u16(v));
+    }
+#elif defined(__AVX2__)
+    for (; i + 16 <= registers; i += 16) {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        if constexpr (W == 2) {
+            if (reverse_words) v = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(v, 0xB1), 0xB1);
+        } else if constexpr (W == 4) {
+            if (reverse_words) v = _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(v, 0x1B), 0x1B);
+        }
+        if (swap_bytes) {
+            v = _mm256_or_si256(_mm256_slli_epi16(v, 8), _mm256_srli_epi16(v, 8));
+        }
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + 2 * i), v);
+    }
+#elif defined(__SSE2__)
+    for (; i + 8 <= registers; i += 8) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        if constexpr (W == 2) {
+            if (reverse_words) v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0xB1), 0xB1);
+        } else if constexpr (W == 4) {
+            if (reverse_words) v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, 0x1B), 0x1B);
+        }
+        if (swap_bytes) {
+            v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + 2 * i), v);
+    }
+#endif
+    for (; i < registers; i += W) {
+        for (int k = 0; k < W; ++k) {
+            uint16_t word = src[i + (reverse_words ? W - 1 - k : k)];
+            if (swap_bytes) {
+                word = swap16(word);
+            }
+            std::memcpy(dst + 2 * (i + k), &word, sizeof(word));
+        }
+    }
+}
+
+/**
+ * 由组合好的位模式得到 T
+ */
+template <typename T>
+T from_bits(uint64_t v) {
+    using Bits = std::conditional_t<sizeof(T) == 2, uint16_t, std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>;
+    Bits bits = static_cast<Bits>(v);
+    T out;
+    std::memcpy(&out, &bits, sizeof(T));
+    return out;
+}
+
+/**
+ * 分段解码到栈上缓冲，再转换为数据值的变体类型 V
+ */
+template <typename T, typename V>
+void decode_values_as(const uint16_t* registers, size_t count, ByteOrder order, DataValue* const* values) {
+    constexpr size_t CHUNK = 64;
+    constexpr size_t W = sizeof(T) / 2;
+    T buffer[CHUNK];
+    for (size_t base = 0; base < count; base += CHUNK) {
+        size_t n = std::min(CHUNK, count - base);
+        decode_block(registers + base * W, n, order, buffer);
+        for (size_t i = 0; i < n; ++i) {
+            values[base + i]->value = static_cast<V>(buffer[i]);
+        }
+    }
+}
+
+} // namespace
+
+/**
+ * 批量解码一段连续存放的同类型数值
+ * @param registers 寄存器
+ * @param count 数值个数
+ * @param order 字节序
+ * @param out 输出
+ */
+template <typename T>
+void decode_block(const uint16_t* registers, size_t count, ByteOrder order, T* out) {
+    if constexpr (!LITTLE_ENDIAN_HOST) {
+        decode_block_scalar(registers, count, order, out);
+    } else {
+        constexpr int W = sizeof(T) / 2;
+        bool reverse_words = order == ByteOrder::ABCD || order == ByteOrder::BADC;
+        bool swap_bytes = order == ByteOrder::BADC || order == ByteOrder::DCBA;
+        reorder<W>(registers, reinterpret_cast<uint8_t*>(out), count * W, reverse_words, swap_bytes);
+    }
+}
+
+/**
+ * 标量参考实现
+ * 按字序取出每个寄存器（必要时交换字节），由高到低移位组合。
+ * @param registers 寄存器
+ * @param count 数值个数
+ * @param order 字节序
+ * @param out 输出
+ */
+template <typename T>
+void decode_block_scalar(const uint16_t* registers, size_t count, ByteOrder order, T* out) {
+    constexpr int W = sizeof(T) / 2;
+    bool low_first = order == ByteOrder::CDAB || order == ByteOrder::DCBA;
+    bool swap_bytes = order == ByteOrder::BADC || order == ByteOrder::DCBA;
+    for (size_t n = 0; n < count; ++n) {
+        const uint16_t* r = registers + n * W;
+        uint64_t v = 0;
+        for (int k = 0; k < W; ++k) {
+            uint16_t word = r[low_first ? W - 1 - k : k];
+            v = (v << 16) | (swap_bytes ? swap16(word) : word);
+        }
+        out[n] = from_bits<T>(v);
+    }
+}
+
+template void decode_block<int16_t>(const uint16_t*, size_t, ByteOrder, int16_t*);
+template void decode_block<uint16_t>(const uint16_t*, size_t, ByteOrder, uint16_t*);
+template void decode_block<int32_t>(const uint16_t*, size_t, ByteOrder, int32_t*);
+template void decode_block<uint32_t>(const uint16_t*, size_t, ByteOrder, uint32_t*);
+template void decode_block<float>(const uint16_t*, size_t, ByteOrder, float*);
+template void decode_block<int64_t>(const uint16_t*, size_t, ByteOrder, int64_t*);
+template void decode_block<double>(const uint16_t*, size_t, ByteOrder, double*);
+
+template void decode_block_scalar<int16_t>(const uint16_t*, size_t, ByteOrder, int16_t*);
+template void decode_block_scalar<uint16_t>(const uint16_t*, size_t, ByteOrder, uint16_t*);
+template void decode_block_scalar<int32_t>(const uint16_t*, size_t, ByteOrder, int32_t*);
+template void decode_block_scalar<uint32_t>(const uint16_t*, size_t, ByteOrder, uint32_t*);
+template void decode_block_scalar<float>(const uint16_t*, size_t, ByteOrder, float*);
+template void decode_block_scalar<int64_t>(const uint16_t*, size_t, ByteOrder, int64_t*);
+template void decode_block_scalar<double>(const uint16_t*, size_t, ByteOrder, double*);
+
+/**
+ * 将一段连续存放的同类型标签解码为数据值
+ * @param registers 第一个标签的起始寄存器
+ * @param count 标签个数
+ * @param type 数据类型
+ * @param order 字节序
+ * @param values 输出数据值
+ */
+void decode_values(const uint16_t* registers, size_t count, DataType type, ByteOrder order, DataValue* const* values) {
+    switch (type) {
+        case DataType::Int16: decode_values_as<int16_t, int32_t>(registers, count, order, values); break;
+        case DataType::Uint16: decode_values_as<uint16_t, uint32_t>(registers, count, order, values); break;
+        case DataType::Int32: decode_values_as<int32_t, int32_t>(registers, count, order, values); break;
+        case DataType::Uint32: decode_values_as<uint32_t, uint32_t>(registers, count, order, values); break;
+        case DataType::Float32: decode_values_as<float, float>(registers, count, order, values); break;
+        case DataType::Int64: decode_values_as<int64_t, int64_t>(registers, count, order, values); break;
+        case DataType::Float64: decode_values_as<double, double>(registers, count, order, values); break;
+        case DataType::Register:
+        default: decode_values_as<uint16_t, int32_t>(registers, count, order, values); break;
+    }
+}
+
+} // namespace southbound
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "TagDescriptor.hpp"
+#include <southbound/Types.hpp>
+#include <cstddef>
+#include <cstdint>
+
+namespace southbound {
+
+/**
+ * @brief 批量解码一段连续存放的同类型数值
+ * 第 i 个数值占用 registers[i * W .. i * W + W)，W = sizeof(T) / 2。
+ * 小端主机上先按字节序对整段寄存器做字/字节重排（NEON、AVX2 或 SSE2，按编译目标选择），
+ * 结果即为 T 的内存表示；其余情况使用标量实现。
+ * T 为 int16_t、uint16_t、int32_t、uint32_t、float、int64_t、double 之一。
+ * @param registers 寄存器（libmodbus 已转换为主机字节序的 16 位值）
+ * @param count 数值个数
+ * @param order 字节序
+ * @param out 输出，至少 count 个
+ */
+template <typename T>
+void decode_block(const uint16_t* registers, size_t count, ByteOrder order, T* out);
+
+/**
+ * @brief decode_block 的标量参考实现，逐个数值按算术方式组合，与主机字节序无关
+ */
+template <typename T>
+void decode_block_scalar(const uint16_t* registers, size_t count, ByteOrder order, T* out);
+
+/**
+ * @brief 将一段连续存放的同类型标签解码为数据值
+ * 与 TagDescriptor::decode 结果一致（Int16/Register 存为 int32_t，Uint16 存为 uint32_t），
+ * 不设置时间戳与质量。
+ * @param registers 第一个标签的起始寄存器
+ * @param count 标签个数，第 i 个标签起始于 registers + i * register_width(type)
+ * @param type 数据类型
+ * @param order 字节序
+ * @param values 输出，values[i] 为第 i 个标签的数据值
+ */
+void decode_values(const uint16_t* registers, size_t count, DataType type, ByteOrder order, DataValue* const* values);
+
+} // namespace southbound
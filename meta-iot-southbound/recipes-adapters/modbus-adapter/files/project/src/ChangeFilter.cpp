@@ -0,0 +1,126 @@
+#include "ChangeFilter.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <string>
+
+namespace southbound {
+
+namespace {
+
+/**
+ * 解析浮点属性，缺失或非法时保留原值
+ */
+void parse_double(const DeviceTag& tag, const char* key, double& out) {
+    auto it = tag.attributes.find(key);
+    if (it == tag.attributes.end()) {
+        return;
+    }
+    char* end = nullptr;
+    double value = std::strtod(it->second.c_str(), &end);
+    if (end != it->second.c_str() && *end == '\0' && value >= 0.0) {
+        out = value;
+    }
+}
+
+/**
+ * 取数值型变体的 double 值
+ * @return 非数值类型（bool/string）返回 false
+ */
+bool as_number(const DataValue& value, double& out) {
+    if (const auto* v = std::get_if<int32_t>(&value.value)) { out = *v; return true; }
+    if (const auto* v = std::get_if<uint32_t>(&value.value)) { out = *v; return true; }
+    if (const auto* v = std::get_if<int64_t>(&value.value)) { out = static_cast<double>(*v); return true; }
+    if (const auto* v = std::get_if<float>(&value.value)) { out = *v; return true; }
+    if (const auto* v = std::get_if<double>(&value.value)) { out = *v; return true; }
+    return false;
+}
+
+} // namespace
+
+/**
+ * 重置过滤器
+ * @param specs 与订阅标签一一对应的上报参数
+ */
+void ChangeFilter::reset(const std::vector<DeadbandSpec>& specs) {
+    m_states.assign(specs.size(), State());
+    for (size_t i = 0; i < specs.size(); ++i) {
+        m_states[i].spec = specs[i];
+    }
+}
+
+/**
+ * 判断新值是否需要上报
+ * 首次读到、质量变化、数据变化超过死区或静默超过 max_silence 时上报。
+ * @param index 标签下标
+ * @param value 新读取的值
+ * @param now_ms 单调时钟当前时间（毫秒）
+ * @return 需要上报返回 true
+ */
+bool ChangeFilter::update(size_t index, const DataValue& value, uint64_t now_ms) {
+    if (index >= m_states.size()) {
+        return true;
+    }
+
+    State& state = m_states[index];
+    bool report = !state.reported
+        || state.last.quality != value.quality
+        || changed(state.spec, state.last, value)
+        || (state.spec.max_silence_ms > 0 && now_ms - state.last_report_ms >= state.spec.max_silence_ms);
+
+    if (report) {
+        state.last = value;
+        state.last_report_ms = now_ms;
+        state.reported = true;
+    }
+    return report;
+}
+
+/**
+ * 比较新旧值
+ * 数值类型在配置了死区时须同时超过所有已配置的死区才视为变化；未配置死区时任何变化都上报。
+ * 其他类型（bool/string）以及类型不同时按精确比较。
+ */
+bool ChangeFilter::changed(const DeadbandSpec& spec, const DataValue& last, const DataValue& value) {
+    double previous = 0.0;
+    double current = 0.0;
+    if (last.value.index() != value.value.index()) {
+        return true;
+    }
+    if (!as_number(last, previous) || !as_number(value, current)) {
+        return last.value != value.value;
+    }
+
+    if (std::isnan(previous) || std::isnan(current)) {
+        return std::isnan(previous) != std::isnan(current);
+    }
+
+    double delta = std::fabs(current - previous);
+    if (spec.absolute <= 0.0 && spec.percent <= 0.0) {
+        return delta > 0.0;
+    }
+    if (spec.absolute > 0.0 && delta <= spec.absolute) {
+        return false;
+    }
+    if (spec.percent > 0.0 && delta <= std::fabs(previous) * spec.percent / 100.0) {
+        return false;
+    }
+    return true;
+}
+
+/**
+ * 从标签属性解析上报参数
+ * @param tag 设备标签
+ * @param defaults 设备级默认参数
+ * @return 上报参数
+ */
+DeadbandSpec ChangeFilter::parse_spec(const DeviceTag& tag, const DeadbandSpec& defaults) {
+    DeadbandSpec spec = defaults;
+    parse_double(tag, "deadband", spec.absolute);
+    parse_double(tag, "deadband_percent", spec.percent);
+    double silence = spec.max_silence_ms;
+    parse_double(tag, "max_silence", silence);
+    spec.max_silence_ms = static_cast<uint32_t>(silence);
+    return spec;
+}
+
+} // namespace southbound
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <southbound/Types.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace southbound {
+
+/**
+ * @brief 单个标签的变化上报参数
+ */
+struct DeadbandSpec {
+    double absolute{0.0};        // 绝对死区，变化量超过该值才上报
+    double percent{0.0};         // 百分比死区，相对上次上报值的变化率（%）超过该值才上报
+    uint32_t max_silence_ms{0};  // 最长静默时间，超过后即使未变化也上报一次；0 表示不强制
+};
+
+/**
+ * @brief 按例外上报（report-by-exception）过滤器
+ * 为每个订阅标签记录上次上报的值，模拟量按死区判断变化，开关量与字符串按精确比较。
+ */
+class ChangeFilter {
+public:
+    /**
+     * @brief 重置过滤器并设置每个标签的上报参数
+     * @param specs 与订阅标签一一对应的上报参数
+     */
+    void reset(const std::vector<DeadbandSpec>& specs);
+
+    /**
+     * @brief 判断新值是否需要上报，需要时记为上次上报值
+     * @param index 标签下标
+     * @param value 新读取的值
+     * @param now_ms 单调时钟当前时间（毫秒）
+     * @return 需要上报返回 true
+     */
+    bool update(size_t index, const DataValue& value, uint64_t now_ms);
+
+    /**
+     * @brief 从标签属性解析上报参数
+     * 属性 deadband、deadband_percent、max_silence（毫秒）缺省时取 defaults 中的值。
+     * @param tag 设备标签
+     * @param defaults 设备级默认参数
+     * @return 上报参数
+     */
+    static DeadbandSpec parse_spec(const DeviceTag& tag, const DeadbandSpec& defaults);
+
+private:
+    struct State {
+        DeadbandSpec spec;
+        DataValue last;
+        uint64_t last_report_ms{0};
+        bool reported{false};
+    };
+
+    std::vector<State> m_states;
+
+    static bool changed(const DeadbandSpec& spec, const DataValue& last, const DataValue& value);
+};
+
+} // namespace southbound
@@ -0,0 +1,235 @@
+#include "IoActor.hpp"
+#include <algorithm>
+
+namespace southbound {
+
+/**
+ * 析构函数
+ * 执行完剩余请求后停止 I/O 线程。
+ */
+IoActor::~IoActor() {
+    stop();
+}
+
+/**
+ * 启动 I/O 线程
+ * 线程标识在状态锁内记录：I/O 线程须先取得该锁才能执行请求，因此其执行的请求总能识别出自身。
+ */
+void IoActor::start() {
+    std::shared_ptr<State> current = state();
+    std::lock_guard<std::mutex> lock(current->mutex);
+    if (current->running) {
+        return;
+    }
+    current->running = true;
+    m_thread = std::thread(&IoActor::worker, current);
+    m_io_thread.store(m_thread.get_id());
+}
+
+/**
+ * 停止 I/O 线程
+ * 已入队的请求全部执行后线程退出，等待中的调用方都能得到结果。
+ * 在 I/O 线程上调用时分离线程并原子地换用新的状态，线程及正在等待的调用方持有原状态的引用，
+ * 本对象随后析构也不影响其退出；此后的调用进入新的（未运行的）状态，返回 NotConnected。
+ */
+void IoActor::stop() {
+    std::shared_ptr<State> current = state();
+    {
+        std::lock_guard<std::mutex> lock(current->mutex);
+        current->running = false;
+    }
+    current->cv.notify_one();
+    if (!m_thread.joinable()) {
+        return;
+    }
+    if (m_thread.get_id() == std::this_thread::get_id()) {
+        m_thread.detach(); // 线程标识保留到下次 start()：剩余请求内的嵌套调用仍在当前线程执行
+        std::atomic_store(&m_state, std::make_shared<State>());
+        return;
+    }
+    m_thread.join();
+    m_io_thread.store(std::thread::id());
+}
+
+/**
+ * 同步请求入队并等待全部步骤完成
+ * 完成标志在调用方栈上，由 I/O 线程在状态锁下置位后通过 done_cv 唤醒。
+ * 调用方持有所入队状态的引用，等待期间 stop() 换用新状态也不影响本次请求完成。
+ * @param kind 请求类别
+ * @param invoke 执行一步
+ * @param target 调用方的可调用对象
+ * @return StatusCode::OK 已执行完成；I/O 线程未启动或已停止时返回 NotConnected
+ */
+StatusCode IoActor::wait(IoKind kind, bool (*invoke)(void*), void* target) {
+    bool done = false;
+    Request request;
+    request.kind = kind;
+    request.invoke = invoke;
+    request.target = target;
+    request.done = &done;
+    std::shared_ptr<State> current = state();
+    {
+        std::unique_lock<std::mutex> lock(current->mutex);
+        if (!current->running) {
+            return StatusCode::NotConnected;
+        }
+        request.queued = clock::now();
+        (kind == IoKind::Write ? current->urgent : current->queue).push_back(std::move(request));
+        current->cv.notify_one();
+        current->done_cv.wait(lock, [&done] { return done; });
+    }
+    return StatusCode::OK;
+}
+
+/**
+ * 入队分步请求，不等待完成
+ * 写请求进入优先通道，其余进入普通通道。
+ * @param kind 请求类别
+ * @param step 执行一步
+ * @return 是否已入队
+ */
+bool IoActor::post(IoKind kind, std::function<bool()> step) {
+    std::shared_ptr<State> current = state();
+    {
+        std::lock_guard<std::mutex> lock(current->mutex);
+        if (!current->running) {
+            return false;
+        }
+        Request request;
+        request.kind = kind;
+        request.step = std::move(step);
+        request.queued = clock::now();
+        (kind == IoKind::Write ? current->urgent : current->queue).push_back(std::move(request));
+    }
+    current->cv.notify_one();
+    return true;
+}
+
+/**
+ * 通道统计
+ * @param urgent 是否为优先通道
+ * @return 统计快照
+ */
+IoLaneStatistics IoActor::statistics(bool urgent) {
+    std::shared_ptr<State> current = state();
+    std::lock_guard<std::mutex> lock(current->mutex);
+    return urgent ? current->urgent_stats : current->normal_stats;
+}
+
+/**
+ * I/O 线程工作函数
+ * 优先通道非空时先执行其中的请求，各通道内按入队顺序执行。分步请求每执行一步后放回所在通道的队首，
+ * 其间到达的优先请求先执行；停止后先清空队列再退出。只通过 state 访问共享状态，不访问 IoActor 对象。
+ * @param state 共享状态
+ */
+void IoActor::worker(std::shared_ptr<State> state) {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    for (;;) {
+        state->cv.wait(lock, [&state] { return !state->urgent.empty() || !state->queue.empty() || !state->running; });
+        bool urgent = !state->urgent.empty();
+        if (!urgent && state->queue.empty()) {
+            break;
+        }
+        Lane& queue = urgent ? state->urgent : state->queue;
+        Request request = queue.pop_front();
+
+        lock.unlock();
+        bool more = execute(request);
+        lock.lock();
+        if (more) {
+            queue.push_front(std::move(request));
+        } else {
+            record(*state, request, urgent);
+            if (request.done) {
+                *request.done = true;
+                state->done_cv.notify_all();
+            }
+        }
+    }
+}
+
+/**
+ * 执行请求的一步并累计服务时间
+ * @param request 请求
+ * @return 还有后续步骤返回 true
+ */
+bool IoActor::execute(Request& request) {
+    clock::time_point start = clock::now();
+    if (request.started == clock::time_point()) {
+        request.started = start;
+    }
+    bool more = request.invoke ? request.invoke(request.target) : request.step();
+    request.service += clock::now() - start;
+    return more;
+}
+
+/**
+ * 记录已完成请求的排队与服务时间，调用方持有状态锁
+ * @param state 共享状态
+ * @param request 请求
+ * @param urgent 是否来自优先通道
+ */
+void IoActor::record(State& state, const Request& request, bool urgent) {
+    auto to_us = [](clock::duration d) {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(d).count());
+    };
+    IoLaneStatistics& stats = urgent ? state.urgent_stats : state.normal_stats;
+    stats.requests++;
+    stats.last_queue_us = to_us(request.started - request.queued);
+    stats.max_queue_us = std::max(stats.max_queue_us, stats.last_queue_us);
+    stats.total_queue_us += stats.last_queue_us;
+    stats.last_service_us = to_us(request.service);
+    stats.max_service_us = std::max(stats.max_service_us, stats.last_service_us);
+    stats.total_service_us += stats.last_service_us;
+}
+
+/**
+ * 入队到队尾
+ * @param request 请求
+ */
+void IoActor::Lane::push_back(Request&& request) {
+    if (m_size == m_slots.size()) {
+        grow();
+    }
+    m_slots[(m_head + m_size) % m_slots.size()] = std::move(request);
+    ++m_size;
+}
+
+/**
+ * 放回队首（分步请求的下一步）
+ * @param request 请求
+ */
+void IoActor::Lane::push_front(Request&& request) {
+    if (m_size == m_slots.size()) {
+        grow();
+    }
+    m_head = (m_head + m_slots.size() - 1) % m_slots.size();
+    m_slots[m_head] = std::move(request);
+    ++m_size;
+}
+
+/**
+ * 取出队首请求，调用方保证队列非空
+ * @return 队首请求
+ */
+IoActor::Request IoActor::Lane::pop_front() {
+    Request request = std::move(m_slots[m_head]);
+    m_slots[m_head].step = nullptr;
+    m_head = (m_head + 1) % m_slots.size();
+    --m_size;
+    return request;
+}
+
+/**
+ * 容量翻倍，按出队顺序重新排列
+ */
+void IoActor::Lane::grow() {
+    std::vector<Request> slots(std::max<size_t>(m_slots.size() * 2, 8));
+    for (size_t i = 0; i < m_size; ++i) {
+        slots[i] = std::move(m_slots[(m_head + i) % m_slots.size()]);
+    }
+    m_slots.swap(slots);
+    m_head = 0;
+}
+
+} // namespace southbound
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <southbound/Types.hpp>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace southbound {
+
+/**
+ * @brief I/O 请求类别
+ */
+enum class IoKind {
+    Read,       // 同步读取
+    Write,      // 写入与写后读，走优先通道
+    Scan,       // 订阅扫描
+    Control     // 连接建立、断开与重连后的上下文替换
+};
+
+/**
+ * @brief 一条通道的排队与服务时间统计（微秒）
+ */
+struct IoLaneStatistics {
+    uint64_t requests{0};
+    uint64_t last_queue_us{0};      // 入队到开始执行
+    uint64_t max_queue_us{0};
+    uint64_t total_queue_us{0};
+    uint64_t last_service_us{0};    // 开始执行到完成
+    uint64_t max_service_us{0};
+    uint64_t total_service_us{0};
+};
+
+/**
+ * @brief 单线程 I/O 执行器
+ * 每个适配器一个。读、写、扫描与连接管理请求进入队列，由唯一的 I/O 线程按序执行，
+ * 上下文及其附属状态（当前从站、连接池、流水线、链路失败计数）只在该线程上访问；
+ * 调用方不在 I/O 期间持有任何锁，同步调用即入队并等待完成。
+ * 写请求进入优先通道：空闲时先于普通请求执行。读取与扫描按块分步提交（call_steps），每步结束后
+ * I/O 线程先执行优先通道中等待的请求再继续下一步，写请求的最坏等待因此不超过一次块读事务，
+ * 而不是整个扫描周期；写请求不嵌套在读取之内执行，两条通道的统计各自只计本请求的耗时。
+ * 同步调用的可调用对象与完成标志都留在调用方栈上，队列为跨请求复用的环形缓冲区，稳态下每次调用不分配内存。
+ * 队列与统计放在与 I/O 线程共享的状态中：在 I/O 线程自身的请求内停止（例如其中析构了所属对象）时，
+ * 线程被分离并在执行完剩余请求后退出，不会留下可 join 的线程对象。
+ * 共享状态的指针与 I/O 线程的标识都以原子方式读写，其他线程上的 call()/post()/statistics() 可以与
+ * start()/stop() 并发（start() 与 stop() 之间由所有者串行调用）；I/O 线程未运行时同步调用返回 NotConnected。
+ */
+class IoActor {
+public:
+    IoActor() = default;
+    ~IoActor();
+
+    IoActor(const IoActor&) = delete;
+    IoActor& operator=(const IoActor&) = delete;
+
+    /**
+     * @brief 启动 I/O 线程（已启动时无操作）
+     */
+    void start();
+
+    /**
+     * @brief 执行完队列中剩余的请求后停止 I/O 线程
+     * 在 I/O 线程上调用时不等待：线程被分离，当前请求返回后继续执行剩余请求再退出，
+     * 因此剩余请求不得再访问本对象的所有者。
+     */
+    void stop();
+
+    /**
+     * @brief 入队并等待完成
+     * 在 I/O 线程上调用（请求内嵌套）时直接在当前线程执行。
+     * @param kind 请求类别
+     * @param work 请求内容（返回 StatusCode 的可调用对象），返回值即本函数的返回值
+     * @return work 的返回值；I/O 线程未启动或已停止时返回 NotConnected，work 不会执行
+     */
+    template <typename Work>
+    StatusCode call(IoKind kind, Work&& work) {
+        StatusCode result = StatusCode::OK;
+        StatusCode queued = call_steps(kind, [&work, &result] {
+            result = work();
+            return false;
+        });
+        return queued == StatusCode::OK ? result : queued;
+    }
+
+    /**
+     * @brief 分步请求：入队并等待全部步骤完成
+     * 每步执行一次 step()，返回 true 表示还有后续步骤。两步之间 I/O 线程先执行优先通道中等待的请求，
+     * 再继续本请求（同一通道的其他请求不会插入）。在 I/O 线程上调用（请求内嵌套）时在当前线程连续执行。
+     * step 不被复制，在调用返回前一直留在调用方栈上。
+     * @param kind 请求类别
+     * @param step 执行一步（返回 bool 的可调用对象）
+     * @return StatusCode::OK 全部步骤已执行；I/O 线程未启动或已停止时返回 NotConnected，step 不会执行
+     */
+    template <typename Step>
+    StatusCode call_steps(IoKind kind, Step&& step) {
+        if (on_io_thread()) {
+            while (step()) {} // 请求内嵌套调用：在当前线程连续执行，避免自身等待
+            return StatusCode::OK;
+        }
+        using Target = std::remove_reference_t<Step>;
+        auto invoke = [](void* target) -> bool { return (*static_cast<Target*>(target))(); };
+        return wait(kind, invoke, const_cast<void*>(static_cast<const void*>(&step)));
+    }
+
+    /**
+     * @brief 入队分步请求，不等待完成
+     * @param kind 请求类别
+     * @param step 执行一步，返回 true 表示还有后续步骤
+     * @return 已入队返回 true；I/O 线程未启动时返回 false，step 不会执行
+     */
+    bool post(IoKind kind, std::function<bool()> step);
+
+    /**
+     * @brief 通道统计
+     * @param urgent true 为优先通道（写），false 为普通通道（读、扫描与连接管理）
+     */
+    IoLaneStatistics statistics(bool urgent);
+
+private:
+    using clock = std::chrono::steady_clock;
+
+    struct Request {
+        IoKind kind{IoKind::Control};
+        bool (*invoke)(void*){nullptr}; // 同步请求：调用方栈上的步骤
+        void* target{nullptr};
+        bool* done{nullptr};            // 同步请求的完成标志，由状态锁保护
+        std::function<bool()> step;     // post() 入队的步骤
+        clock::time_point queued{};
+        clock::time_point started{};    // 首步开始执行的时间
+        clock::duration service{};      // 各步执行时间之和，不含两步之间执行的其他请求
+    };
+
+    /**
+     * @brief 请求队列（环形缓冲区）
+     * 容量只增不减，出队后槽位留给后续请求复用。
+     */
+    class Lane {
+    public:
+        bool empty() const { return m_size == 0; }
+        void push_back(Request&& request);
+        void push_front(Request&& request);
+        Request pop_front();
+
+    private:
+        std::vector<Request> m_slots;
+        size_t m_head{0};
+        size_t m_size{0};
+
+        void grow();
+    };
+
+    /**
+     * @brief 与 I/O 线程共享的状态
+     */
+    struct State {
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::condition_variable done_cv;    // 同步请求完成通知
+        Lane queue;                         // 普通通道，由 mutex 保护
+        Lane urgent;                        // 优先通道，由 mutex 保护
+        bool running{false};                // 由 mutex 保护
+        IoLaneStatistics normal_stats;      // 由 mutex 保护
+        IoLaneStatistics urgent_stats;      // 由 mutex 保护
+    };
+
+    std::shared_ptr<State> m_state{std::make_shared<State>()}; // I/O 线程另持有一份引用；经 std::atomic_load/atomic_store 访问
+    std::thread m_thread;                       // 只由 start()/stop() 访问
+    std::atomic<std::thread::id> m_io_thread{}; // 当前 I/O 线程的标识，未启动时为空
+
+    bool on_io_thread() const { return m_io_thread.load() == std::this_thread::get_id(); }
+    std::shared_ptr<State> state() const { return std::atomic_load(&m_state); }
+    StatusCode wait(IoKind kind, bool (*invoke)(void*), void* target);
+    static void worker(std::shared_ptr<State> state);
+    static bool execute(Request& request);
+    static void record(State& state, const Request& request, bool urgent);
+};
+
+} // namespace southbound
@@ -0,0 +1,150 @@
+#include "LastValueCache.hpp"
+#include <algorithm>
+
+namespace southbound {
+
+/**
+ * 写入一组读取结果
+ * @param tags 标签描述符
+ * @param values 读取到的值
+ * @param results 读取结果
+ */
+void LastValueCache::store(const std::vector<TagDescriptor>& tags, const std::vector<DataValue>& values,
+                           const std::vector<StatusCode>& results) {
+    clock::time_point now = clock::now();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (size_t i = 0; i < tags.size(); ++i) {
+        if (results[i] == StatusCode::OK) {
+            store_locked(tags[i], values[i], now);
+        }
+    }
+}
+
+/**
+ * 写入一组读取结果中的部分标签
+ * @param tags 标签描述符
+ * @param values 读取到的值
+ * @param results 读取结果
+ * @param indices 待写入的标签下标
+ */
+void LastValueCache::store(const std::vector<TagDescriptor>& tags, const std::vector<DataValue>& values,
+                           const std::vector<StatusCode>& results, const std::vector<size_t>& indices) {
+    clock::time_point now = clock::now();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (size_t i : indices) {
+        if (results[i] == StatusCode::OK) {
+            store_locked(tags[i], values[i], now);
+        }
+    }
+}
+
+/**
+ * 查找未超过 max_age 的缓存值
+ * @param tags 标签描述符
+ * @param results 编译结果
+ * @param max_age 允许的最长缓存时间
+ * @param values 输出命中的值
+ * @param misses 输出未命中的标签下标
+ */
+void LastValueCache::lookup(const std::vector<TagDescriptor>& tags, const std::vector<StatusCode>& results,
+                            std::chrono::milliseconds max_age, std::vector<DataValue>& values,
+                            std::vector<size_t>& misses) {
+    clock::time_point oldest = clock::now() - max_age;
+    size_t hits = 0;
+    misses.clear();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (size_t i = 0; i < tags.size(); ++i) {
+        if (results[i] != StatusCode::OK) {
+            continue;
+        }
+        auto it = m_entries.find(key(tags[i]));
+        if (it != m_entries.end() && it->second.updated >= oldest) {
+            values[i] = to_data_value(it->second.value);
+            ++hits;
+        } else {
+            misses.push_back(i);
+        }
+    }
+    m_hits += hits;
+    m_misses += misses.size();
+}
+
+/**
+ * 使与写入地址范围重叠的缓存项失效
+ * 从起始地址向前回溯最大占用数，覆盖起点在写入范围之前的多寄存器标签。
+ * 线圈写使线圈表（FC1）项失效，寄存器写使保持寄存器表（FC3）项失效。
+ * @param slave_id 从站 ID
+ * @param coils 是否为线圈表
+ * @param address 起始地址
+ * @param count 写入数量
+ */
+void LastValueCache::invalidate(int slave_id, bool coils, int address, int count) {
+    const int function_code = coils ? 1 : 3;
+    const int last = address + count - 1;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto it = m_entries.lower_bound(key(slave_id, function_code, std::max(0, address - m_max_count + 1)));
+    auto end = m_entries.upper_bound(key(slave_id, function_code, last) | 0xFFFFFFFFull);
+    while (it != end) {
+        int entry_address = static_cast<int>((it->first >> 32) & 0xFFFF);
+        if (entry_address + it->second.count - 1 >= address) {
+            it = m_entries.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+/**
+ * 清空缓存
+ */
+void LastValueCache::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_entries.clear();
+    m_max_count = 1;
+}
+
+/**
+ * 缓存项数
+ */
+size_t LastValueCache::size() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_entries.size();
+}
+
+/**
+ * 写入一个缓存项，调用方须持有 m_mutex
+ * 无法以紧凑形式保存的值（字符串）不缓存。
+ */
+void LastValueCache::store_locked(const TagDescriptor& tag, const DataValue& value, clock::time_point now) {
+    CompactValue compact;
+    if (!to_compact(value, compact)) {
+        return;
+    }
+    Entry& entry = m_entries[key(tag)];
+    entry.value = compact;
+    entry.updated = now;
+    entry.count = tag.count;
+    m_max_count = std::max(m_max_count, tag.count);
+}
+
+/**
+ * 缓存键：高 32 位依次为从站、功能码、地址，低 32 位区分同一地址上的不同解释
+ * （数据类型、字节序、寄存器位与数量）
+ */
+uint64_t LastValueCache::key(const TagDescriptor& tag) {
+    return key(tag.slave_id, tag.function_code, tag.address)
+        | static_cast<uint64_t>(static_cast<uint8_t>(tag.data_type) & 0x0F) << 28
+        | static_cast<uint64_t>(static_cast<uint8_t>(tag.byte_order) & 0x0F) << 24
+        | static_cast<uint64_t>(static_cast<uint8_t>(tag.bit)) << 16
+        | tag.count;
+}
+
+uint64_t LastValueCache::key(int slave_id, int function_code, int address) {
+    return static_cast<uint64_t>(slave_id & 0xFF) << 56
+        | static_cast<uint64_t>(function_code & 0xFF) << 48
+        | static_cast<uint64_t>(address & 0xFFFF) << 32;
+}
+
+} // namespace southbound
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "TagDescriptor.hpp"
+#include <southbound/CompactValue.hpp>
+#include <southbound/Types.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace southbound {
+
+/**
+ * @brief 设备级最新值缓存
+ * 扫描与同步读取成功后写入，按编译后的标签（从站、功能码、地址、类型、字节序、位、数量）索引，
+ * 同一点位的不同属性写法共享缓存项。带 max_age 的读取先查缓存，只有过期或缺失的标签才访问总线。
+ * 写入后按地址范围失效，避免读到写入前的值。
+ * 缓存项以 16 字节的 CompactValue 保存数值（本适配器不产生字符串值，字符串值不缓存）。
+ */
+class LastValueCache {
+public:
+    using clock = std::chrono::steady_clock;
+
+    /**
+     * @brief 写入一组读取结果（只写入结果为 OK 的标签）
+     * @param tags 标签描述符
+     * @param values 读取到的值，与 tags 一一对应
+     * @param results 读取结果，与 tags 一一对应
+     */
+    void store(const std::vector<TagDescriptor>& tags, const std::vector<DataValue>& values,
+               const std::vector<StatusCode>& results);
+
+    /**
+     * @brief 写入一组读取结果中的部分标签
+     * @param indices 待写入的标签下标
+     */
+    void store(const std::vector<TagDescriptor>& tags, const std::vector<DataValue>& values,
+               const std::vector<StatusCode>& results, const std::vector<size_t>& indices);
+
+    /**
+     * @brief 查找未超过 max_age 的缓存值
+     * 只查找编译结果为 OK 的标签，命中的值写入 values。
+     * @param tags 标签描述符
+     * @param results 编译结果，与 tags 一一对应
+     * @param max_age 允许的最长缓存时间
+     * @param values 输出命中的值，与 tags 一一对应（须已分配）
+     * @param misses 输出未命中（过期或缺失）的标签下标
+     */
+    void lookup(const std::vector<TagDescriptor>& tags, const std::vector<StatusCode>& results,
+                std::chrono::milliseconds max_age, std::vector<DataValue>& values, std::vector<size_t>& misses);
+
+    /**
+     * @brief 使与写入地址范围重叠的缓存项失效
+     * @param slave_id 从站 ID
+     * @param coils true 为线圈表（FC1），false 为保持寄存器表（FC3）
+     * @param address 起始地址
+     * @param count 写入的线圈或寄存器数量
+     */
+    void invalidate(int slave_id, bool coils, int address, int count);
+
+    /**
+     * @brief 清空缓存
+     */
+    void clear();
+
+    /**
+     * @brief 缓存项数
+     */
+    size_t size();
+
+    /**
+     * @brief 累计命中与未命中的标签数
+     */
+    uint64_t hits() const { return m_hits; }
+    uint64_t misses() const { return m_misses; }
+
+private:
+    struct Entry {
+        CompactValue value;
+        clock::time_point updated;
+        uint16_t count;     // 占用的寄存器或位数，用于失效判断
+    };
+
+    std::mutex m_mutex;
+    std::map<uint64_t, Entry> m_entries;    // 按 (从站, 功能码, 地址, ...) 排序，便于按地址范围失效
+    uint16_t m_max_count{1};                // 缓存项的最大占用数，限定失效时的回溯范围
+    std::atomic<uint64_t> m_hits{0};
+    std::atomic<uint64_t> m_misses{0};
+
+    void store_locked(const TagDescriptor& tag, const DataValue& value, clock::time_point now);
+    static uint64_t key(const TagDescriptor& tag);
+    static uint64_t key(int slave_id, int function_code, int address);
+};
+
+} // namespace southbound
@@ -1,11 +1,102 @@
 #include "ModbusAdapter.hpp"
+#include "BlockDecoder.hpp"
+#include <algorithm>
 #include <iostream>
+#include <sstream>
 #include <chrono>
+#include <cerrno>
 #include <cstring>
 #include <vector>
 
 namespace southbound {
 
+namespace {
+
+/**
+ * 请求与应答帧的近似总字节数（RTU 帧，用于估算串口传输时间）
+ * @param function_code 功能码
+ * @param count 寄存器或位数量
+ */
+int frame_bytes(int function_code, int count) {
+    switch (function_code) {
+        case 1:
+        case 2: return 8 + 5 + (count + 7) / 8;
+        case 3:
+        case 4: return 8 + 5 + 2 * count;
+        case 15: return 9 + (count + 7) / 8 + 8;
+        case 16: return 9 + 2 * count + 8;
+        case 22: return 10 + 10;
+        default: return 8 + 8; // FC5/FC6 请求与应答各 8 字节
+    }
+}
+
+// 批量解码的最短标签串，更短时逐标签解码
+constexpr size_t BLOCK_DECODE_MIN_RUN = 8;
+
+/**
+ * 从 items[first] 起地址首尾相接、数据类型与字节序相同的标签个数（寄存器位标签不参与）
+ * @param tags 标签描述符
+ * @param items 块内标签下标（按地址升序）
+ * @param first 起始位置
+ */
+size_t block_decode_run(const std::vector<TagDescriptor>& tags, const std::vector<size_t>& items, size_t first) {
+    const TagDescriptor& head = tags[items[first]];
+    int width = register_width(head.data_type);
+    size_t run = 1;
+    while (head.bit < 0 && first + run < items.size()) {
+        const TagDescriptor& tag = tags[items[first + run]];
+        if (tag.bit >= 0 || tag.data_type != head.data_type || tag.byte_order != head.byte_order
+            || tag.address != head.address + static_cast<int>(run) * width) {
+            break;
+        }
+        ++run;
+    }
+    return run;
+}
+
+/**
+ * 读取前准备：输出值与标签一一对应，非读取功能码的标签标记为 NotSupported
+ */
+void prepare_read(const std::vector<TagDescriptor>& tags, std::vector<DataValue>& values,
+                  std::vector<StatusCode>& results) {
+    values.resize(tags.size());
+    for (size_t i = 0; i < tags.size(); ++i) {
+        if (results[i] == StatusCode::OK && !tags[i].is_read()) {
+            results[i] = StatusCode::NotSupported;
+        }
+    }
+}
+
+/**
+ * @return 全部成功返回 OK，否则为首个失败标签的状态码
+ */
+StatusCode first_failure(const std::vector<StatusCode>& results) {
+    for (StatusCode result : results) {
+        if (result != StatusCode::OK) {
+            return result;
+        }
+    }
+    return StatusCode::OK;
+}
+
+/**
+ * 在完成回调线程上调用 completion；该线程未运行时在当前线程调用
+ * @param completions 完成回调执行器
+ * @param kind 请求类别（写入的完成回调优先）
+ * @param completion 调用 handler 的函数对象
+ */
+template <typename Completion>
+void post_completion(IoActor& completions, IoKind kind, const Completion& completion) {
+    if (!completions.post(kind, [completion] {
+            completion();
+            return false;
+        })) {
+        completion();
+    }
+}
+
+} // namespace
+
 /**
  * 构造函数
  * 初始化默认通信参数与资源句柄。
@@ -14,6 +105,7 @@ ModbusAdapter::ModbusAdapter()
     : m_modbus_ctx(nullptr, modbus_free)
     , m_port(502)
     , m_slave_id(1)
+    , m_active_slave_id(1)
     , m_baudrate(9600)
     , m_parity('N')
     , m_data_bits(8)
@@ -22,14 +114,16 @@ ModbusAdapter::ModbusAdapter()
 
 /**
  * 析构函数
- * 关闭连接并安全停止订阅线程。
+ * 先停止订阅线程，再停止重连线程并关闭连接，最后停止 I/O 线程。
  */
 ModbusAdapter::~ModbusAdapter() {
-    disconnect();
-    if (m_subscription_thread.joinable()) {
-        m_subscription_active = false;
-        m_subscription_thread.join();
+    {
+        std::lock_guard<std::mutex> subscription_lock(m_subscription_mutex);
+        stop_subscription();
     }
+    disconnect();
+    m_io.stop();
+    m_completions.stop(); // 在完成回调中析构时线程被分离，执行完剩余回调后退出
 }
 
 /**
@@ -54,58 +148,75 @@ StatusCode ModbusAdapter::init(const AdapterConfig& config) {
         return result;
     }
     
+    m_io.start();
+    m_completions.start();
     m_initialized = true;
     return StatusCode::OK;
 }
 
 /**
  * 建立与设备的连接
- * 需在 init 成功后调用。
+ * 需在 init 成功后调用。连接在 I/O 线程上建立。
  * @return StatusCode::OK 连接成功；AlreadyConnected/NotInitialized/Error 等
  */
 StatusCode ModbusAdapter::connect() {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    
     if (!m_initialized) {
         return StatusCode::NotInitialized;
     }
     
-    if (m_connected) {
-        return StatusCode::AlreadyConnected;
-    }
-    
-    if (!m_modbus_ctx) {
-        return StatusCode::Error;
-    }
-    
-    int result = -1;
-    if (m_connection_type == "tcp") {
-        result = modbus_connect(m_modbus_ctx.get());
-    } else if (m_connection_type == "rtu") {
-        result = modbus_connect(m_modbus_ctx.get());
+    StatusCode result = m_io.call(IoKind::Control, [this] {
+        if (m_connected) {
+            return StatusCode::AlreadyConnected;
+        }
+        
+        // disconnect() 会释放上下文，重新连接时重建
+        if (!m_modbus_ctx && create_modbus_context() != StatusCode::OK) {
+            return StatusCode::Error;
+        }
+        
+        if (open_context(m_modbus_ctx.get()) == -1) {
+            return StatusCode::Error;
+        }
+        
+        link_up();
+        return StatusCode::OK;
+    });
+    if (result != StatusCode::OK) {
+        return result;
     }
     
-    if (result == -1) {
-        return StatusCode::Error;
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_auto_reconnect && !m_reconnect_thread.joinable()) {
+        {
+            std::lock_guard<std::mutex> reconnect_lock(m_reconnect_mutex);
+            m_link_lost = false;
+            m_reconnect_stop = false;
+        }
+        m_reconnect_thread = std::thread(&ModbusAdapter::reconnect_worker, this);
     }
-    
-    m_connected = true;
     return StatusCode::OK;
 }
 
 /**
  * 断开连接并释放上下文
+ * 先停止重连线程（避免断开后又被替换上下文），再在 I/O 线程上关闭连接。
  * @return StatusCode::OK 总是返回成功
  */
 StatusCode ModbusAdapter::disconnect() {
-    std::lock_guard<std::mutex> lock(m_mutex);
-    
-    if (m_modbus_ctx) {
-        modbus_close(m_modbus_ctx.get());
-        m_modbus_ctx.reset();
-    }
+    stop_reconnect();
     
-    m_connected = false;
+    // I/O 线程未启动（init 未成功）时尚无连接，call 返回 NotConnected，同样视为已断开
+    m_io.call(IoKind::Control, [this] {
+        m_pool.close();
+        if (m_modbus_ctx) {
+            close_context();
+            m_modbus_ctx.reset();
+        }
+        
+        m_cache.clear();
+        m_connected = false;
+        return StatusCode::OK;
+    });
     return StatusCode::OK;
 }
 
@@ -114,76 +225,442 @@ StatusCode ModbusAdapter::disconnect() {
  * @param tags 待读取的设备标签列表
  * @param values 输出读取到的数据值列表，与 tags 一一对应
  * @return StatusCode::OK 成功；NotConnected/Error/InvalidParam 等
+ * 标签先在调用线程上编译为描述符，再由 I/O 线程经扫描规划器合并为块读，按块拆分回各标签的值。
  */
 StatusCode ModbusAdapter::read(const std::vector<DeviceTag>& tags, std::vector<DataValue>& values) {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_connected) {
+        return StatusCode::NotConnected;
+    }
+    
+    std::vector<TagDescriptor> descriptors;
+    std::vector<StatusCode> results;
+    compile_tags(tags, descriptors, results);
+    return read_compiled(descriptors, results, values);
+}
+
+/**
+ * 按 TagId 读取设备数据
+ * 描述符按 TagId 缓存，同一登记表上的重复读取不再解析标签属性。
+ * @param registry 点位登记表
+ * @param ids 点位 TagId 列表
+ * @param values 输出读取到的数据值列表，与 ids 一一对应
+ * @return StatusCode::OK 成功；NotConnected/Error/InvalidParam 等
+ */
+StatusCode ModbusAdapter::read_ids(const TagRegistry& registry, const std::vector<TagId>& ids,
+                               std::vector<DataValue>& values) {
+    if (!m_connected) {
+        return StatusCode::NotConnected;
+    }
+    
+    std::vector<TagDescriptor> descriptors;
+    std::vector<StatusCode> results;
+    resolve_ids(registry, ids, descriptors, results);
+    return read_compiled(descriptors, results, values);
+}
+
+/**
+ * 在 I/O 线程上读取一组已编译的标签，读到的值写入最新值缓存
+ * 读取按块分步执行，块与块之间 I/O 线程可以先执行等待中的写请求。
+ * @param descriptors 标签描述符
+ * @param results 输入编译结果，输出每个标签的读取结果
+ * @param values 输出数据值，与 descriptors 一一对应
+ * @return StatusCode::OK 全部成功；否则为首个失败标签的状态码
+ */
+StatusCode ModbusAdapter::read_compiled(const std::vector<TagDescriptor>& descriptors, std::vector<StatusCode>& results,
+                                        std::vector<DataValue>& values) {
+    ReadRun run(descriptors, results, values);
+    StatusCode queued = m_io.call_steps(IoKind::Read, [this, &run] { return read_step(run); });
+    return queued == StatusCode::OK ? run.status : queued;
+}
+
+/**
+ * 执行分步读取的一步，须在 I/O 线程上调用
+ * 首步规划块读，此后每步读一块；最后一步将读到的值写入最新值缓存并检查链路。
+ * @param run 读取状态；结束时 run.status 为 OK（全部成功）、NotConnected 或首个失败标签的状态码
+ * @return 还有后续步骤返回 true
+ */
+bool ModbusAdapter::read_step(ReadRun& run) {
+    if (!run.started) {
+        run.started = true;
+        if (!m_connected) {
+            run.status = StatusCode::NotConnected;
+            return false;
+        }
+        prepare_read(*run.descriptors, *run.values, *run.results);
+        run.plan = m_planner.plan(*run.descriptors);
+        run.blocks = BlockRun{&run.plan, run.descriptors, run.values, run.results, 0};
+    }
+    if (step_blocks(run.blocks)) {
+        return true;
+    }
+    if (m_value_cache) {
+        m_cache.store(*run.descriptors, *run.values, *run.results);
+    }
+    check_link();
+    run.status = first_failure(*run.results);
+    return false;
+}
+
+/**
+ * 异步读取设备标签数据
+ * 标签在调用线程上编译后作为读请求投递到 I/O 线程，调用立即返回；不同设备的请求在各自的
+ * I/O 线程上并发执行。请求开始执行时检查取消与截止时间，命中则不访问总线。
+ * handler 在本设备的完成回调线程上按完成顺序调用，不占用 I/O 线程；其中可以调用本适配器的任何方法，
+ * 包括同步读写、unsubscribe()、disconnect() 乃至销毁适配器。handler 阻塞只推迟后续请求的回调。
+ * @param tags 待读取的设备标签列表
+ * @param options 截止时间与取消令牌
+ * @param handler 完成回调
+ */
+void ModbusAdapter::read_async(const std::vector<DeviceTag>& tags, const AsyncOptions& options,
+                               ReadHandler handler) {
+    if (!m_connected) {
+        handler(StatusCode::NotConnected, std::vector<DataValue>());
+        return;
+    }
     
+    struct Request {
+        std::vector<TagDescriptor> descriptors;
+        std::vector<StatusCode> results;
+        std::vector<DataValue> values;
+        ReadRun run;
+    };
+    auto request = std::make_shared<Request>();
+    compile_tags(tags, request->descriptors, request->results);
+    request->run = ReadRun(request->descriptors, request->results, request->values);
+    
+    bool queued = m_io.post(IoKind::Read, [this, request, options, handler] {
+        ReadRun& run = request->run;
+        if (!run.started) {
+            StatusCode admitted = options.admit();
+            if (admitted != StatusCode::OK) {
+                post_completion(m_completions, IoKind::Read, [handler, admitted] {
+                    handler(admitted, std::vector<DataValue>());
+                });
+                return false;
+            }
+        }
+        if (read_step(run)) {
+            return true;
+        }
+        post_completion(m_completions, IoKind::Read, [handler, request] {
+            handler(request->run.status, std::move(request->values));
+        });
+        return false;
+    });
+    if (!queued) {
+        handler(StatusCode::NotConnected, std::vector<DataValue>());
+    }
+}
+
+/**
+ * 读取设备数据，允许使用缓存值
+ * 在调用线程上查找最新值缓存，不超过 max_age 的标签直接应答，不进入 I/O 队列；
+ * 只有过期或缺失的标签作为一次读取请求访问总线，读到的值同时写入缓存。
+ * @param tags 待读取的设备标签列表
+ * @param values 输出读取到的数据值列表，与 tags 一一对应
+ * @param max_age 允许的最长缓存时间；不大于 0 或未启用缓存时等同 read()
+ * @return StatusCode::OK 成功；NotConnected/Error/InvalidParam 等
+ */
+StatusCode ModbusAdapter::read_cached(const std::vector<DeviceTag>& tags, std::vector<DataValue>& values,
+                                      std::chrono::milliseconds max_age) {
+    if (!m_value_cache || max_age.count() <= 0) {
+        return read(tags, values);
+    }
     if (!m_connected) {
         return StatusCode::NotConnected;
     }
     
-    values.clear();
-    values.reserve(tags.size());
+    std::vector<TagDescriptor> descriptors;
+    std::vector<StatusCode> results;
+    compile_tags(tags, descriptors, results);
+    values.resize(tags.size());
     
-    for (const auto& tag : tags) {
-        DataValue value;
-        StatusCode result = read_register(tag, value);
-        if (result != StatusCode::OK) {
+    std::vector<size_t> misses;
+    m_cache.lookup(descriptors, results, max_age, values, misses);
+    
+    if (!misses.empty()) {
+        std::vector<TagDescriptor> stale_tags(misses.size());
+        std::vector<StatusCode> stale_results(misses.size(), StatusCode::OK);
+        std::vector<DataValue> stale_values;
+        for (size_t i = 0; i < misses.size(); ++i) {
+            stale_tags[i] = descriptors[misses[i]];
+        }
+        
+        StatusCode result = read_compiled(stale_tags, stale_results, stale_values);
+        if (result == StatusCode::NotConnected) {
             return result;
         }
-        values.push_back(value);
+        
+        for (size_t i = 0; i < misses.size(); ++i) {
+            values[misses[i]] = stale_values[i];
+            results[misses[i]] = stale_results[i];
+        }
     }
     
+    for (StatusCode result : results) {
+        if (result != StatusCode::OK) {
+            return result;
+        }
+    }
     return StatusCode::OK;
 }
 
 /**
  * 批量写入设备标签数据
+ * 同一从站、同一数据表中地址连续的标签合并为一次 FC16/FC15 写，32 位与浮点值按配置的字节序
+ * 占用两个寄存器；指定 FC5/FC6 的标签单独写入。
  * @param tags_and_values 待写入的标签与数值映射
  * @return StatusCode::OK 成功；NotConnected/Error/NotSupported/InvalidParam 等
  */
 StatusCode ModbusAdapter::write(const std::map<DeviceTag, DataValue>& tags_and_values) {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!m_connected) {
+        return StatusCode::NotConnected;
+    }
     
+    std::vector<PendingWrite> writes;
+    StatusCode result = prepare_writes(tags_and_values, writes);
+    if (result != StatusCode::OK) {
+        return result;
+    }
+    return write_prepared(writes);
+}
+
+/**
+ * 按 TagId 写入设备数据
+ * 合并与排序规则同 write()。
+ * @param registry 点位登记表
+ * @param values 待写入的点位与数值
+ * @return StatusCode::OK 成功；NotConnected/Error/NotSupported/InvalidParam 等
+ */
+StatusCode ModbusAdapter::write_ids(const TagRegistry& registry, const std::vector<TagValue>& values) {
     if (!m_connected) {
         return StatusCode::NotConnected;
     }
     
-    for (const auto& pair : tags_and_values) {
-        StatusCode result = write_register(pair.first, pair.second);
+    std::vector<TagId> ids;
+    ids.reserve(values.size());
+    for (const TagValue& value : values) {
+        ids.push_back(value.id);
+    }
+    std::vector<TagDescriptor> descriptors;
+    std::vector<StatusCode> results;
+    resolve_ids(registry, ids, descriptors, results);
+    
+    std::vector<PendingWrite> writes(values.size());
+    for (size_t i = 0; i < values.size(); ++i) {
+        StatusCode result = results[i];
+        if (result == StatusCode::OK) {
+            result = prepare_write(descriptors[i], values[i].value, writes[i]);
+        }
         if (result != StatusCode::OK) {
             return result;
         }
     }
+    order_writes(writes);
+    return write_prepared(writes);
+}
+
+/**
+ * 在 I/O 线程（优先通道）上执行已编码的写入
+ * @param writes 已排序合并的待写项
+ * @return StatusCode::OK 成功；NotConnected/Error 等
+ */
+StatusCode ModbusAdapter::write_prepared(const std::vector<PendingWrite>& writes) {
+    return m_io.call(IoKind::Write, [&] { return write_on_io(writes); });
+}
+
+/**
+ * 执行已编码的写入，须在 I/O 线程上调用
+ * @param writes 已排序合并的待写项
+ * @return StatusCode::OK 成功；NotConnected/Error 等
+ */
+StatusCode ModbusAdapter::write_on_io(const std::vector<PendingWrite>& writes) {
+    if (!m_connected) {
+        return StatusCode::NotConnected;
+    }
+    StatusCode write_result = write_pending(writes);
+    invalidate_cache(writes);
+    check_link();
+    return write_result;
+}
+
+/**
+ * 异步写入设备标签数据
+ * 编码与合并规则同 write()，编码失败时直接以错误码调用 handler；写请求进入 I/O 线程的优先通道。
+ * 取消、截止时间与 handler 的执行线程同 read_async()。
+ * @param tags_and_values 待写入的标签与数值映射
+ * @param options 截止时间与取消令牌
+ * @param handler 完成回调
+ */
+void ModbusAdapter::write_async(const std::map<DeviceTag, DataValue>& tags_and_values, const AsyncOptions& options,
+                                WriteHandler handler) {
+    if (!m_connected) {
+        handler(StatusCode::NotConnected);
+        return;
+    }
+    
+    auto writes = std::make_shared<std::vector<PendingWrite>>();
+    StatusCode result = prepare_writes(tags_and_values, *writes);
+    if (result != StatusCode::OK) {
+        handler(result);
+        return;
+    }
+    
+    bool queued = m_io.post(IoKind::Write, [this, writes, options, handler] {
+        StatusCode write_result = options.admit();
+        if (write_result == StatusCode::OK) {
+            write_result = write_on_io(*writes);
+        }
+        post_completion(m_completions, IoKind::Write, [handler, write_result] { handler(write_result); });
+        return false;
+    });
+    if (!queued) {
+        handler(StatusCode::NotConnected);
+    }
+}
+
+/**
+ * 写入后读取（组合控制周期）
+ * 写入项为同一从站的一段连续保持寄存器、读取项为同一从站的一个保持寄存器块时，
+ * 使用 FC23（modbus_write_and_read_registers）在一次事务中完成；设备返回非法功能码异常后
+ * 不再尝试 FC23。其余情况退回先写后读。
+ * @param tags_and_values 待写入的标签与数值映射
+ * @param tags_to_read 写入后读取的设备标签列表
+ * @param values 输出读取到的数据值列表，与 tags_to_read 一一对应
+ * @return StatusCode::OK 成功；NotConnected/Error/NotSupported/InvalidParam 等
+ */
+StatusCode ModbusAdapter::write_read(const std::map<DeviceTag, DataValue>& tags_and_values,
+                                     const std::vector<DeviceTag>& tags_to_read, std::vector<DataValue>& values) {
+    if (!m_connected) {
+        return StatusCode::NotConnected;
+    }
     
-    return StatusCode::OK;
+    std::vector<PendingWrite> writes;
+    StatusCode result = prepare_writes(tags_and_values, writes);
+    if (result != StatusCode::OK) {
+        return result;
+    }
+    
+    std::vector<TagDescriptor> descriptors;
+    std::vector<StatusCode> results;
+    compile_tags(tags_to_read, descriptors, results);
+    
+    return m_io.call(IoKind::Write, [&] {
+        if (!m_connected) {
+            return StatusCode::NotConnected;
+        }
+        
+        if (m_write_and_read && write_and_read_registers(writes, descriptors, values, results)) {
+            invalidate_cache(writes);
+            if (m_value_cache) {
+                m_cache.store(descriptors, values, results);
+            }
+            check_link();
+            for (StatusCode read_result : results) {
+                if (read_result != StatusCode::OK) {
+                    return read_result;
+                }
+            }
+            return StatusCode::OK;
+        }
+        
+        StatusCode write_result = write_pending(writes);
+        invalidate_cache(writes);
+        if (write_result == StatusCode::OK) {
+            write_result = read_tags(descriptors, values, results);
+            if (m_value_cache) {
+                m_cache.store(descriptors, values, results);
+            }
+        }
+        check_link();
+        return write_result;
+    });
 }
 
 /**
  * 订阅一组标签并按周期回调
- * 内部启动轮询线程，每秒读取一次已订阅标签并通过回调返回。
+ * 在批量订阅之上每个周期构造标签与数值映射后回调。
  * @param tags 订阅的设备标签列表
  * @param callback 数据到达时回调，参数为标签与数值映射
  * @return StatusCode::OK 成功；NotConnected 等
  */
 StatusCode ModbusAdapter::subscribe(const std::vector<DeviceTag>& tags, OnDataReceivedCallback callback) {
+    auto keys = std::make_shared<const std::vector<DeviceTag>>(tags);
+    return subscribe_batch(tags, [keys, callback](const TagSampleSpan& samples) {
+        std::map<DeviceTag, DataValue> values;
+        for (const TagSample& sample : samples) {
+            values[(*keys)[sample.index]] = to_data_value(sample.value, samples.strings);
+        }
+        callback(values);
+    });
+}
+
+/**
+ * 订阅一组标签并按周期批量回调
+ * 标签在此一次性编译为描述符并按 scan_class 划分扫描类，内部启动轮询线程，
+ * 由时间轮调度各扫描类的读取，以 (订阅下标, 紧凑数据值) 序列回调；
+ * 序列来自跨节拍复用的缓冲区，稳态下回调路径不分配内存。
+ * @param tags 订阅的设备标签列表
+ * @param callback 数据到达时回调
+ * @return StatusCode::OK 成功；NotConnected 等
+ */
+StatusCode ModbusAdapter::subscribe_batch(const std::vector<DeviceTag>& tags, OnBatchDataCallback callback) {
+    // 停止、重建与启动在同一把锁内完成，并发订阅不会交错重建或覆盖仍在运行的线程对象
+    std::lock_guard<std::mutex> subscription_lock(m_subscription_mutex);
+    stop_subscription(); // 订阅线程扫描时读取订阅状态，须在修改前停止
+    
     std::lock_guard<std::mutex> lock(m_mutex);
     
     if (!m_connected) {
         return StatusCode::NotConnected;
     }
     
-    m_subscribed_tags = tags;
     m_callback = callback;
+    compile_tags(tags, m_subscribed_descriptors, m_subscribed_results);
+    start_subscription(tags);
+    return StatusCode::OK;
+}
+
+/**
+ * 按 TagId 订阅一组点位并按周期回调
+ * 与 subscribe() 相同地划分扫描类与上报过滤；适配器只保存描述符，不保留 DeviceTag，
+ * 回调以 TagId 回传数值，不构造以 DeviceTag 为键的 map。
+ * @param registry 点位登记表（只在调用期间使用）
+ * @param ids 订阅的点位 TagId 列表
+ * @param callback 数据到达时回调
+ * @return StatusCode::OK 成功；NotConnected 等
+ */
+StatusCode ModbusAdapter::subscribe_ids(const TagRegistry& registry, const std::vector<TagId>& ids,
+                                        OnTagDataCallback callback) {
+    std::lock_guard<std::mutex> subscription_lock(m_subscription_mutex);
+    stop_subscription();
     
-    if (m_subscription_thread.joinable()) {
-        m_subscription_active = false;
-        m_subscription_thread.join();
+    std::lock_guard<std::mutex> lock(m_mutex);
+    
+    if (!m_connected) {
+        return StatusCode::NotConnected;
     }
     
-    m_subscription_active = true;
-    m_subscription_thread = std::thread(&ModbusAdapter::subscription_worker, this);
+    // 值列表只在订阅线程上使用，跨节拍复用
+    auto keys = std::make_shared<const std::vector<TagId>>(ids);
+    auto values = std::make_shared<std::vector<TagValue>>();
+    m_callback = [keys, values, callback](const TagSampleSpan& samples) {
+        values->resize(samples.size);
+        for (size_t i = 0; i < samples.size; ++i) {
+            (*values)[i].id = (*keys)[samples[i].index];
+            (*values)[i].value = to_data_value(samples[i].value, samples.strings);
+        }
+        callback(*values);
+    };
+    resolve_ids(registry, ids, m_subscribed_descriptors, m_subscribed_results);
     
+    // 死区与扫描类属性只在此解析一次
+    std::vector<DeviceTag> tags;
+    tags.reserve(ids.size());
+    for (TagId id : ids) {
+        tags.push_back(registry.tag(id));
+    }
+    start_subscription(tags);
     return StatusCode::OK;
 }
 
@@ -193,15 +670,16 @@ StatusCode ModbusAdapter::subscribe(const std::vector<DeviceTag>& tags, OnDataRe
  * @return StatusCode::OK 成功停止
  */
 StatusCode ModbusAdapter::unsubscribe() {
-    std::lock_guard<std::mutex> lock(m_mutex);
+    std::lock_guard<std::mutex> subscription_lock(m_subscription_mutex);
+    stop_subscription();
     
-    if (m_subscription_thread.joinable()) {
-        m_subscription_active = false;
-        m_subscription_thread.join();
-    }
+    std::lock_guard<std::mutex> lock(m_mutex);
     
-    m_subscribed_tags.clear();
+    m_subscribed_descriptors.clear();
+    m_subscribed_results.clear();
     m_callback = nullptr;
+    m_batch.clear();
+    m_batch.shrink_to_fit();
     
     return StatusCode::OK;
 }
@@ -225,6 +703,54 @@ StatusCode ModbusAdapter::get_status() {
     return StatusCode::OK;
 }
 
+/**
+ * 获取扫描统计
+ * @param stats 输出统计项：周期数、错过的截止时间、节拍耗时与唤醒抖动（微秒）、断线与重连次数、
+ *              写通道与读通道的排队时间和服务时间（微秒）、最新值缓存的项数与命中数、往返时间与当前响应超时
+ * @return StatusCode::OK
+ */
+StatusCode ModbusAdapter::get_statistics(AdapterStatistics& stats) {
+    std::lock_guard<std::mutex> lock(m_stats_mutex);
+    const CycleStatistics& cycle = m_cycle_stats;
+    uint64_t cycles = cycle.cycles ? cycle.cycles : 1;
+    
+    stats["scan_cycles"] = cycle.cycles;
+    stats["scan_missed_deadlines"] = cycle.missed_deadlines;
+    stats["scan_duration_last_us"] = cycle.last_duration_us;
+    stats["scan_duration_max_us"] = cycle.max_duration_us;
+    stats["scan_duration_avg_us"] = cycle.total_duration_us / cycles;
+    stats["scan_jitter_last_us"] = cycle.last_jitter_us;
+    stats["scan_jitter_max_us"] = cycle.max_jitter_us;
+    stats["scan_jitter_avg_us"] = cycle.total_jitter_us / cycles;
+    stats["link_failures"] = static_cast<uint64_t>(m_link_failures.load());
+    stats["link_losses"] = m_link_losses;
+    stats["reconnect_attempts"] = m_reconnect_attempts;
+    
+    for (bool urgent : {true, false}) {
+        IoLaneStatistics lane = m_io.statistics(urgent);
+        uint64_t requests = lane.requests ? lane.requests : 1;
+        std::string prefix = urgent ? "io_write_" : "io_read_";
+        stats[prefix + "requests"] = lane.requests;
+        stats[prefix + "queue_last_us"] = lane.last_queue_us;
+        stats[prefix + "queue_max_us"] = lane.max_queue_us;
+        stats[prefix + "queue_avg_us"] = lane.total_queue_us / requests;
+        stats[prefix + "service_last_us"] = lane.last_service_us;
+        stats[prefix + "service_max_us"] = lane.max_service_us;
+        stats[prefix + "service_avg_us"] = lane.total_service_us / requests;
+    }
+    stats["cache_entries"] = m_cache.size();
+    stats["cache_hits"] = m_cache.hits();
+    stats["cache_misses"] = m_cache.misses();
+    
+    std::lock_guard<std::mutex> rtt_lock(m_rtt_mutex);
+    stats["rtt_srtt_us"] = static_cast<uint64_t>(m_rtt.srtt().count());
+    stats["rtt_var_us"] = static_cast<uint64_t>(m_rtt.rttvar().count());
+    stats["response_timeout_us"] = static_cast<uint64_t>(
+        m_adaptive_timeout ? m_rtt.timeout().count() : m_response_timeout.count() * 1000);
+    
+    return StatusCode::OK;
+}
+
 /**
  * 解析适配器配置
  * @param config 输入配置
@@ -244,6 +770,13 @@ StatusCode ModbusAdapter::parse_config(const AdapterConfig& config) {
         }
         // TCP 可选参数 (如果获取失败，则使用默认值)
         try_get_config_value(config, "port", m_port);
+        int pipeline_depth = 1;
+        try_get_config_value(config, "pipeline_depth", pipeline_depth);
+        m_pipeline.set_depth(pipeline_depth);
+        try_get_config_value(config, "connections", m_connections);
+        if (m_connections < 1) {
+            return StatusCode::BadConfig;
+        }
 
     } else if (m_connection_type == "rtu") {
         // RTU 必需参数
@@ -255,6 +788,13 @@ StatusCode ModbusAdapter::parse_config(const AdapterConfig& config) {
         try_get_config_value(config, "parity", m_parity);
         try_get_config_value(config, "data_bits", m_data_bits);
         try_get_config_value(config, "stop_bits", m_stop_bits);
+        std::string rtu_engine = "libmodbus";
+        try_get_config_value(config, "rtu_engine", rtu_engine);
+        if (rtu_engine == "native") {
+            m_rtu_native = true;
+        } else if (rtu_engine != "libmodbus") {
+            return StatusCode::BadConfig;
+        }
         
     } else {
         return StatusCode::BadConfig; // 不支持的连接类型
@@ -262,130 +802,625 @@ StatusCode ModbusAdapter::parse_config(const AdapterConfig& config) {
 
     // 3. 获取所有连接类型都共用的可选参数
     try_get_config_value(config, "slave_id", m_slave_id);
-    
-    return StatusCode::OK;
-}
+    m_tag_defaults.slave_id = m_slave_id;
 
-/**
- * 创建并配置 libmodbus 上下文
- * 根据连接类型创建 TCP/RTU 上下文，设置从站ID与超时。
- * @return StatusCode::OK 成功；BadConfig/Error 等
- */
-StatusCode ModbusAdapter::create_modbus_context() {
-    if (m_connection_type == "tcp") {
-        m_modbus_ctx.reset(modbus_new_tcp(m_ip_address.c_str(), m_port));
-    } else if (m_connection_type == "rtu") {
-        m_modbus_ctx.reset(modbus_new_rtu(m_device_path.c_str(), m_baudrate, m_parity, m_data_bits, m_stop_bits));
-    } else {
+    // 响应超时：timeout 为上限，min_timeout 为自适应下限（毫秒）
+    int timeout = 1000;
+    int min_timeout = 20;
+    try_get_config_value(config, "timeout", timeout);
+    try_get_config_value(config, "min_timeout", min_timeout);
+    try_get_config_value(config, "adaptive_timeout", m_adaptive_timeout);
+    if (timeout < 1 || min_timeout < 1) {
         return StatusCode::BadConfig;
     }
-    
-    if (!m_modbus_ctx) {
-        return StatusCode::Error;
+    m_response_timeout = std::chrono::milliseconds(timeout);
+    m_rtt.configure(std::chrono::milliseconds(std::min(min_timeout, timeout)), m_response_timeout);
+
+    std::string byte_order;
+    if (try_get_config_value(config, "byte_order", byte_order)
+        && !parse_byte_order(byte_order, m_tag_defaults.byte_order)) {
+        return StatusCode::BadConfig;
+    }
+
+    // 4. 块读合并参数
+    ScanPlannerOptions options;
+    try_get_config_value(config, "gap_tolerance", options.register_gap);
+    try_get_config_value(config, "bit_gap_tolerance", options.bit_gap);
+    try_get_config_value(config, "max_block_registers", options.max_registers);
+    try_get_config_value(config, "max_block_bits", options.max_bits);
+    m_planner = ScanPlanner(options);
+    try_get_config_value(config, "write_and_read", m_write_and_read);
+    try_get_config_value(config, "value_cache", m_value_cache);
+
+    // 断线重连参数
+    try_get_config_value(config, "auto_reconnect", m_auto_reconnect);
+    try_get_config_value(config, "link_failure_threshold", m_link_failure_threshold);
+    int reconnect_min_delay = 500;
+    int reconnect_max_delay = 30000;
+    try_get_config_value(config, "reconnect_min_delay", reconnect_min_delay);
+    try_get_config_value(config, "reconnect_max_delay", reconnect_max_delay);
+    if (m_link_failure_threshold < 1 || reconnect_min_delay < 1 || reconnect_max_delay < reconnect_min_delay) {
+        return StatusCode::BadConfig;
+    }
+    m_backoff.configure(std::chrono::milliseconds(reconnect_min_delay), std::chrono::milliseconds(reconnect_max_delay));
+
+    // 5. 轮询周期与扫描类，scan_classes 格式: fast:100,normal:1000,slow:60000
+    int poll_interval = 0;
+    if (try_get_config_value(config, "poll_interval", poll_interval) && poll_interval > 0) {
+        set_poll_interval(std::chrono::milliseconds(poll_interval));
+    }
+    std::string scan_classes;
+    if (try_get_config_value(config, "scan_classes", scan_classes)) {
+        std::istringstream stream(scan_classes);
+        std::string entry;
+        while (std::getline(stream, entry, ',')) {
+            size_t colon = entry.find(':');
+            if (colon == std::string::npos) {
+                return StatusCode::BadConfig;
+            }
+            int period = 0;
+            try {
+                period = std::stoi(entry.substr(colon + 1));
+            } catch (const std::exception&) {
+                return StatusCode::BadConfig;
+            }
+            if (period <= 0) {
+                return StatusCode::BadConfig;
+            }
+            m_scan_classes[entry.substr(0, colon)] = static_cast<uint32_t>(period);
+        }
+    }
+
+    std::string overrun_policy;
+    if (try_get_config_value(config, "overrun_policy", overrun_policy)) {
+        if (overrun_policy == "skip") {
+            m_overrun_policy = OverrunPolicy::Skip;
+        } else if (overrun_policy == "catch_up") {
+            m_overrun_policy = OverrunPolicy::CatchUp;
+        } else if (overrun_policy == "stretch") {
+            m_overrun_policy = OverrunPolicy::Stretch;
+        } else {
+            return StatusCode::BadConfig;
+        }
+    }
+
+    // 6. 按例外上报参数
+    try_get_config_value(config, "report_by_exception", m_report_by_exception);
+    try_get_config_value(config, "deadband", m_deadband_defaults.absolute);
+    try_get_config_value(config, "deadband_percent", m_deadband_defaults.percent);
+    int max_silence = 0;
+    if (try_get_config_value(config, "max_silence", max_silence) && max_silence > 0) {
+        m_deadband_defaults.max_silence_ms = static_cast<uint32_t>(max_silence);
     }
     
-    // 设置从站 ID
-    modbus_set_slave(m_modbus_ctx.get(), m_slave_id);
-    
-    // 设置超时
-    modbus_set_response_timeout(m_modbus_ctx.get(), 1, 0); // 1秒超时
+    return StatusCode::OK;
+}
+
+/**
+ * 创建并配置 libmodbus 上下文
+ * 根据连接类型创建 TCP/RTU 上下文，设置从站ID与超时。
+ * @return StatusCode::OK 成功；BadConfig/Error 等
+ */
+StatusCode ModbusAdapter::create_modbus_context() {
+    if (m_connection_type != "tcp" && m_connection_type != "rtu") {
+        return StatusCode::BadConfig;
+    }
+    
+    // 同一串口上的设备共享一个总线（及其上下文）
+    if (m_connection_type == "rtu" && !m_bus) {
+        StatusCode result = StatusCode::OK;
+        m_bus = RtuBus::acquire(RtuSettings{m_device_path, m_baudrate, m_parity, m_data_bits, m_stop_bits, m_rtu_native}, result);
+        if (!m_bus) {
+            return result;
+        }
+    }
+    
+    m_modbus_ctx = new_modbus_context();
+    if (!m_modbus_ctx) {
+        return StatusCode::Error;
+    }
     
+    m_active_slave_id = m_slave_id;
     return StatusCode::OK;
 }
 
 /**
- * 读取单个标签对应的寄存器/线圈
- * 根据 function_code 调用不同的 Modbus 读函数，并按 data_type 转换值。
- * @param tag 设备标签（包含地址、数量、功能码、数据类型等）
- * @param value 输出读取到的数据值（含时间戳、质量）
- * @return StatusCode::OK 成功；InvalidParam/NotSupported/Error 等
+ * 按配置创建一个未连接的 Modbus 上下文
+ * 只读取 init 后不再变化的配置，重连线程可在 I/O 线程之外调用。
+ * RTU 连接返回总线共享的上下文（不转移所有权），从站与超时在每次事务开始时设置。
+ * @return 上下文；连接类型不支持或创建失败时为空
  */
-StatusCode ModbusAdapter::read_register(const DeviceTag& tag, DataValue& value) {
-    auto it = tag.attributes.find("register_address");
-    if (it == tag.attributes.end()) {
-        return StatusCode::InvalidParam;
+std::unique_ptr<modbus_t, void(*)(modbus_t*)> ModbusAdapter::new_modbus_context() const {
+    if (m_bus) {
+        return std::unique_ptr<modbus_t, void(*)(modbus_t*)>(m_bus->context(), [](modbus_t*) {});
+    }
+    
+    modbus_t* ctx = nullptr;
+    if (m_connection_type == "tcp") {
+        ctx = modbus_new_tcp(m_ip_address.c_str(), m_port);
+    }
+    
+    std::unique_ptr<modbus_t, void(*)(modbus_t*)> holder(ctx, modbus_free);
+    if (ctx) {
+        // 设置默认从站 ID，标签可通过 slave/slave_id 属性覆盖
+        modbus_set_slave(ctx, m_slave_id);
+        
+        // 设置超时（上限）；启用自适应超时时每次请求前按往返时间估计调整
+        modbus_set_response_timeout(ctx, static_cast<uint32_t>(m_response_timeout.count() / 1000),
+                                    static_cast<uint32_t>(m_response_timeout.count() % 1000 * 1000));
+    }
+    return holder;
+}
+
+/**
+ * 主上下文连接成功后的设置
+ * 调整 socket、建立额外连接并清零链路失败计数。须在 I/O 线程上调用。
+ */
+void ModbusAdapter::link_up() {
+    if (!m_bus) {
+        modbus_set_slave(m_modbus_ctx.get(), m_slave_id);
+        m_active_slave_id = m_slave_id;
+    }
+    
+    if (m_connection_type == "tcp") {
+        ModbusConnectionPool::tune_socket(modbus_get_socket(m_modbus_ctx.get()));
+        if (m_connections > 1) {
+            m_pool.open(m_ip_address, m_port, m_connections - 1, m_modbus_ctx.get());
+        }
+    }
+    
+    m_pipeline.reset();
+    {
+        std::lock_guard<std::mutex> lock(m_link_mutex);
+        m_slave_failures.fill(0);
+        m_slave_seen.fill(false);
+        m_seen_slaves = 0;
+        m_silent_slaves = 0;
+    }
+    m_link_failures = 0;
+    m_connected = true;
+}
+
+/**
+ * 记录一次事务的链路状态
+ * 收到任何应答（包括 Modbus 异常应答）都说明链路可用；超时、连接复位等系统错误计为该从站的链路级失败。
+ * 失败按从站分别计数，某个从站掉线不会掩盖或拖累同一链路上仍在应答的其他从站。
+ * @param slave_id 事务的从站地址
+ * @param result libmodbus 调用返回值
+ * @param error 失败时的 errno
+ */
+void ModbusAdapter::record_link_result(int slave_id, int result, int error) {
+    size_t slave = static_cast<size_t>(slave_id) & 0xFF;
+    bool answered = result != -1 || error >= MODBUS_ENOBASE;
+    
+    std::lock_guard<std::mutex> lock(m_link_mutex);
+    if (!m_slave_seen[slave]) {
+        m_slave_seen[slave] = true;
+        ++m_seen_slaves;
+    }
+    
+    int& failures = m_slave_failures[slave];
+    if (answered) {
+        if (failures >= m_link_failure_threshold) {
+            --m_silent_slaves;
+        }
+        failures = 0;
+        m_link_failures = 0;
+    } else {
+        ++m_link_failures;
+        if (failures < m_link_failure_threshold && ++failures == m_link_failure_threshold) {
+            ++m_silent_slaves;
+        }
+    }
+}
+
+/**
+ * 判定断线
+ * 仅当本次连接以来访问过的每个从站都连续链路级失败达到阈值（即没有任何从站再应答）时才认为传输层已断开；
+ * 单个从站掉线只使其自身的请求失败，不会触发重连而中断其他仍正常的从站。
+ * 断线时关闭连接、标记为未连接并通知重连线程；此后调用方立即得到 NotConnected，不再逐个等待超时。
+ * 须在 I/O 线程上调用。
+ */
+void ModbusAdapter::check_link() {
+    if (!m_connected) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_link_mutex);
+        if (m_seen_slaves == 0 || m_silent_slaves < m_seen_slaves) {
+            return;
+        }
     }
     
-    int address = std::stoi(it->second);
-    int count = get_register_count(tag);
-    int function_code = get_function_code(tag);
+    m_pool.close();
+    close_context(); // 共享总线上只释放本设备的引用，不影响同一串口上的其他设备
+    m_connected = false;
+    ++m_link_losses;
     
-    std::vector<uint16_t> data(count > 0 ? count : 1);
+    if (m_auto_reconnect) {
+        {
+            std::lock_guard<std::mutex> reconnect_lock(m_reconnect_mutex);
+            m_link_lost = true;
+        }
+        m_reconnect_cv.notify_one();
+    }
+}
+
+/**
+ * 重连线程工作函数
+ * 断线后按带抖动的指数退避等待并重试，连接成功后重置退避并等待下一次断线。
+ */
+void ModbusAdapter::reconnect_worker() {
+    std::unique_lock<std::mutex> lock(m_reconnect_mutex);
+    
+    while (!m_reconnect_stop) {
+        if (!m_link_lost) {
+            m_reconnect_cv.wait(lock);
+            continue;
+        }
+        
+        std::chrono::milliseconds delay = m_backoff.next();
+        if (m_reconnect_cv.wait_for(lock, delay, [this] { return m_reconnect_stop; })) {
+            break;
+        }
+        
+        lock.unlock();
+        bool reconnected = try_reconnect();
+        lock.lock();
+        
+        if (reconnected) {
+            m_link_lost = false;
+            m_backoff.reset();
+        }
+    }
+}
+
+/**
+ * 尝试重新连接
+ * 在重连线程上建立新上下文的连接，I/O 线程不会被连接超时阻塞；
+ * 连接成功后由 I/O 线程替换主上下文。
+ * @return 连接成功（或已被 connect() 恢复）返回 true
+ */
+bool ModbusAdapter::try_reconnect() {
+    ++m_reconnect_attempts;
+    
+    std::unique_ptr<modbus_t, void(*)(modbus_t*)> ctx = new_modbus_context();
+    if (!ctx || open_context(ctx.get()) == -1) {
+        return false;
+    }
+    
+    StatusCode result = m_io.call(IoKind::Control, [&] {
+        if (!m_connected) {
+            m_modbus_ctx = std::move(ctx);
+            link_up();
+        } else if (!m_bus) {
+            // connect() 已先行恢复连接，关闭多余的 TCP 连接后再释放上下文
+            // （RTU 上下文归共享总线所有，本设备至多持有一个总线引用，无需处理）
+            modbus_close(ctx.get());
+        }
+        return StatusCode::OK;
+    });
+    if (result != StatusCode::OK) {
+        // I/O 线程已停止：放弃新建立的连接
+        if (!m_bus) {
+            modbus_close(ctx.get());
+        } else if (m_bus_open.exchange(false)) {
+            m_bus->close();
+        }
+        return false;
+    }
+    return true;
+}
+
+/**
+ * 打开上下文的连接
+ * RTU 连接打开共享总线（引用计数，本设备至多持有一个引用）。
+ * @param ctx 待连接的上下文
+ * @return 0 成功；-1 失败
+ */
+int ModbusAdapter::open_context(modbus_t* ctx) {
+    if (!m_bus) {
+        return modbus_connect(ctx);
+    }
+    if (m_bus_open.exchange(true)) {
+        return 0;
+    }
+    if (m_bus->open() == -1) {
+        m_bus_open = false;
+        return -1;
+    }
+    return 0;
+}
+
+/**
+ * 关闭主上下文的连接
+ * RTU 连接释放本设备对共享总线的引用，最后一个设备释放时关闭串口。
+ */
+void ModbusAdapter::close_context() {
+    if (!m_bus) {
+        modbus_close(m_modbus_ctx.get());
+    } else if (m_bus_open.exchange(false)) {
+        m_bus->close();
+    }
+}
+
+/**
+ * 停止重连线程
+ */
+void ModbusAdapter::stop_reconnect() {
+    {
+        std::lock_guard<std::mutex> reconnect_lock(m_reconnect_mutex);
+        m_reconnect_stop = true;
+        m_link_lost = false;
+    }
+    m_reconnect_cv.notify_one();
+    if (m_reconnect_thread.joinable()) {
+        m_reconnect_thread.join();
+    }
+}
+
+/**
+ * 停止订阅线程
+ * 等待进行中的扫描请求完成后返回。调用方须持有 m_subscription_mutex。
+ */
+void ModbusAdapter::stop_subscription() {
+    m_subscription_active = false;
+    if (m_subscription_thread.joinable()) {
+        m_subscription_thread.join();
+    }
+}
+
+/**
+ * 设置订阅标签的上报过滤与扫描类并启动订阅线程
+ * 描述符与编译结果须已写入 m_subscribed_descriptors/m_subscribed_results。调用方须持有 m_subscription_mutex 与 m_mutex。
+ * @param tags 订阅标签，与描述符一一对应（只用于解析死区与扫描类属性）
+ */
+void ModbusAdapter::start_subscription(const std::vector<DeviceTag>& tags) {
+    std::vector<DeadbandSpec> specs;
+    specs.reserve(tags.size());
+    for (const auto& tag : tags) {
+        specs.push_back(ChangeFilter::parse_spec(tag, m_deadband_defaults));
+    }
+    m_change_filter.reset(specs);
+    
+    for (size_t i = 0; i < m_subscribed_descriptors.size(); ++i) {
+        if (m_subscribed_results[i] == StatusCode::OK && !m_subscribed_descriptors[i].is_read()) {
+            m_subscribed_results[i] = StatusCode::NotSupported;
+        }
+    }
+    assign_scan_classes(tags);
+    m_batch.clear();
+    m_batch.reserve(m_subscribed_descriptors.size()); // 每个标签每节拍至多上报一次，扫描中不再扩容
+    
+    m_subscription_active = true;
+    m_subscription_thread = std::thread(&ModbusAdapter::subscription_worker, this);
+}
+
+/**
+ * 将一组 TagId 解析为描述符
+ * 解析结果按登记表与 TagId 缓存，登记表变化（uid 不同）时清空缓存。
+ * @param registry 点位登记表
+ * @param ids 点位 TagId 列表
+ * @param descriptors 输出描述符，与 ids 一一对应
+ * @param results 输出每个点位的解析结果（未登记的 TagId 为 InvalidParam），与 ids 一一对应
+ */
+void ModbusAdapter::resolve_ids(const TagRegistry& registry, const std::vector<TagId>& ids,
+                                std::vector<TagDescriptor>& descriptors, std::vector<StatusCode>& results) {
+    descriptors.resize(ids.size());
+    results.resize(ids.size());
+    const size_t registered = registry.size();
+    
+    std::lock_guard<std::mutex> lock(m_id_mutex);
+    if (m_id_registry != registry.uid()) {
+        m_id_registry = registry.uid();
+        m_id_descriptors.clear();
+        m_id_results.clear();
+        m_id_resolved.clear();
+    }
+    if (m_id_resolved.size() < registered) {
+        m_id_descriptors.resize(registered);
+        m_id_results.resize(registered);
+        m_id_resolved.resize(registered, 0);
+    }
+    
+    for (size_t i = 0; i < ids.size(); ++i) {
+        TagId id = ids[i];
+        if (id >= registered) {
+            results[i] = StatusCode::InvalidParam;
+            continue;
+        }
+        if (!m_id_resolved[id]) {
+            m_id_results[id] = compile_tag(registry.tag(id), m_tag_defaults, m_id_descriptors[id]);
+            m_id_resolved[id] = 1;
+        }
+        descriptors[i] = m_id_descriptors[id];
+        results[i] = m_id_results[id];
+    }
+}
+
+/**
+ * 将一组标签编译为描述符
+ * @param tags 设备标签列表
+ * @param descriptors 输出描述符，与 tags 一一对应
+ * @param results 输出每个标签的编译结果，与 tags 一一对应
+ */
+void ModbusAdapter::compile_tags(const std::vector<DeviceTag>& tags, std::vector<TagDescriptor>& descriptors,
+                                 std::vector<StatusCode>& results) {
+    descriptors.resize(tags.size());
+    results.resize(tags.size());
+    for (size_t i = 0; i < tags.size(); ++i) {
+        results[i] = compile_tag(tags[i], m_tag_defaults, descriptors[i]);
+    }
+}
+
+/**
+ * 切换当前请求的从站 ID
+ * 同一连接上的多个从站共用一个上下文，仅在从站变化时调用 modbus_set_slave。
+ * @param slave_id 目标从站 ID
+ */
+void ModbusAdapter::select_slave(int slave_id) {
+    if (slave_id != m_active_slave_id) {
+        modbus_set_slave(m_modbus_ctx.get(), slave_id);
+        m_active_slave_id = slave_id;
+    }
+}
+
+/**
+ * 调用 libmodbus 读取一段连续地址
+ * @param ctx 执行请求的上下文（主上下文或连接池中的上下文）
+ * @param slave_id 从站 ID
+ * @param function_code 读功能码 1/2/3/4
+ * @param address 起始地址
+ * @param count 寄存器或位数量
+ * @param registers 寄存器输出缓冲（FC3/FC4）
+ * @param bits 位输出缓冲（FC1/FC2）
+ * @return 读到的数量；失败返回 -1（errno 为 libmodbus 错误码）
+ */
+int ModbusAdapter::read_range(modbus_t* ctx, int slave_id, int function_code, int address, int count,
+                              uint16_t* registers, uint8_t* bits) {
+    int frame = frame_bytes(function_code, count);
+    auto start = start_transaction(ctx, slave_id, frame, false);
     int result = -1;
+    ModbusRtuTransport* native = m_bus ? m_bus->native() : nullptr;
     
     switch (function_code) {
-        case 3: // 读保持寄存器
-            result = modbus_read_registers(m_modbus_ctx.get(), address, count, data.data());
-            break;
-        case 4: // 读输入寄存器
-            result = modbus_read_input_registers(m_modbus_ctx.get(), address, count, data.data());
-            break;
         case 1: // 读线圈
-            {
-                std::vector<uint8_t> coil_data(count > 0 ? count : 1);
-                result = modbus_read_bits(m_modbus_ctx.get(), address, count, coil_data.data());
-                if (result == count) {
-                    value.value = static_cast<bool>(coil_data[0]);
-                }
-            }
+            result = native ? native->read_bits(slave_id, 1, address, count, bits)
+                            : modbus_read_bits(ctx, address, count, bits);
             break;
         case 2: // 读离散输入
-            {
-                std::vector<uint8_t> input_data(count > 0 ? count : 1);
-                result = modbus_read_input_bits(m_modbus_ctx.get(), address, count, input_data.data());
-                if (result == count) {
-                    value.value = static_cast<bool>(input_data[0]);
-                }
-            }
+            result = native ? native->read_bits(slave_id, 2, address, count, bits)
+                            : modbus_read_input_bits(ctx, address, count, bits);
+            break;
+        case 3: // 读保持寄存器
+            result = native ? native->read_registers(slave_id, 3, address, count, registers)
+                            : modbus_read_registers(ctx, address, count, registers);
+            break;
+        case 4: // 读输入寄存器
+            result = native ? native->read_registers(slave_id, 4, address, count, registers)
+                            : modbus_read_input_registers(ctx, address, count, registers);
             break;
         default:
-            return StatusCode::NotSupported;
+            errno = EINVAL;
+            break;
     }
     
-    if (result == count && (function_code == 3 || function_code == 4)) {
-        // 根据数据类型转换值
-        auto data_type_it = tag.attributes.find("data_type");
-        if (data_type_it != tag.attributes.end()) {
-            if (data_type_it->second == "int16") {
-                value.value = static_cast<int32_t>(static_cast<int16_t>(data[0]));
-            } else if (data_type_it->second == "uint16") {
-                value.value = static_cast<uint32_t>(data[0]);
-            } else if (data_type_it->second == "int32") {
-                if (count >= 2) {
-                    int32_t val = (static_cast<int32_t>(data[0]) << 16) | data[1];
-                    value.value = val;
-                } else {
-                    return StatusCode::InvalidParam;
-                }
-            } else if (data_type_it->second == "uint32") {
-                if (count >= 2) {
-                    uint32_t val = (static_cast<uint32_t>(data[0]) << 16) | data[1];
-                    value.value = val;
-                } else {
-                    return StatusCode::InvalidParam;
-                }
-            } else if (data_type_it->second == "float32") {
-                if (count >= 2) {
-                    uint32_t val = (static_cast<uint32_t>(data[0]) << 16) | data[1];
-                    float fval;
-                    std::memcpy(&fval, &val, sizeof(float));
-                    value.value = fval;
-                } else {
-                    return StatusCode::InvalidParam;
-                }
-            } else {
-                value.value = static_cast<int32_t>(data[0]);
-            }
+    int error = errno;
+    finish_transaction(ctx, start, frame, result, error);
+    errno = error;
+    return result;
+}
+
+/**
+ * 开始一次事务：占用共享总线（RTU）、切换从站并设置响应超时
+ * 超时 = 自适应超时 + 本帧的串口传输时间，不超过 timeout 上限；未启用自适应时为 timeout。
+ * 每次 start_transaction 必须配对一次 finish_transaction。
+ * @param ctx 执行请求的上下文
+ * @param slave_id 从站 ID
+ * @param frame_bytes 请求与应答帧的总字节数
+ * @param urgent 写请求等高优先级事务，在共享总线上优先于读请求
+ * @return 事务开始时刻（不含等待总线的时间）
+ */
+std::chrono::steady_clock::time_point ModbusAdapter::start_transaction(modbus_t* ctx, int slave_id, int frame_bytes,
+                                                                       bool urgent) {
+    if (m_bus) {
+        // 共享上下文的从站与超时可能已被同一串口上的其他设备修改
+        m_bus->lock(urgent);
+        m_active_slave_id = -1;
+    }
+    
+    if (ctx == m_modbus_ctx.get()) {
+        select_slave(slave_id);
+    } else {
+        modbus_set_slave(ctx, slave_id);
+    }
+    
+    std::chrono::microseconds timeout = std::chrono::duration_cast<std::chrono::microseconds>(m_response_timeout);
+    if (m_adaptive_timeout) {
+        std::lock_guard<std::mutex> lock(m_rtt_mutex);
+        timeout = std::min(m_rtt.timeout() + wire_time(frame_bytes), m_rtt.max_timeout());
+    }
+    if (m_bus && m_bus->native()) {
+        m_bus->native()->set_response_timeout(timeout);
+    } else if (m_adaptive_timeout || m_bus) {
+        modbus_set_response_timeout(ctx, static_cast<uint32_t>(timeout.count() / 1000000),
+                                    static_cast<uint32_t>(timeout.count() % 1000000));
+    }
+    return std::chrono::steady_clock::now();
+}
+
+/**
+ * 结束一次事务：更新往返时间估计并释放共享总线
+ * 收到应答（包括异常应答）时以扣除串口传输时间后的往返时间为样本；超时则加倍超时值，
+ * 并清空可能在超时后到达的迟到应答。
+ * @param ctx 执行请求的上下文
+ * @param start 事务开始时刻
+ * @param frame_bytes 请求与应答帧的总字节数
+ * @param result libmodbus 调用返回值
+ * @param error 失败时的 errno
+ */
+void ModbusAdapter::finish_transaction(modbus_t* ctx, std::chrono::steady_clock::time_point start, int frame_bytes,
+                                       int result, int error) {
+    if (m_adaptive_timeout && (result != -1 || error >= MODBUS_ENOBASE)) {
+        auto rtt = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        std::lock_guard<std::mutex> lock(m_rtt_mutex);
+        m_rtt.sample(rtt - wire_time(frame_bytes));
+    } else if (m_adaptive_timeout && error == ETIMEDOUT) {
+        {
+            std::lock_guard<std::mutex> lock(m_rtt_mutex);
+            m_rtt.backoff();
+        }
+        if (m_bus && m_bus->native()) {
+            m_bus->native()->flush();
         } else {
-            value.value = static_cast<int32_t>(data[0]);
+            modbus_flush(ctx);
         }
     }
     
-    if (result != count) {
+    if (m_bus) {
+        m_bus->unlock();
+    }
+}
+
+/**
+ * 帧在串口上的传输时间
+ * 每字符位数 = 起始位 + 数据位 + 校验位 + 停止位；TCP 连接返回 0。
+ * @param frame_bytes 帧字节数
+ */
+std::chrono::microseconds ModbusAdapter::wire_time(int frame_bytes) const {
+    if (m_connection_type != "rtu" || m_baudrate <= 0) {
+        return std::chrono::microseconds(0);
+    }
+    int64_t bits_per_char = 1 + m_data_bits + (m_parity == 'N' ? 0 : 1) + m_stop_bits;
+    return std::chrono::microseconds(frame_bytes * bits_per_char * 1000000 / m_baudrate);
+}
+
+/**
+ * 单独读取一个标签
+ * 用于块读被设备拒绝时的逐标签回退。
+ * @param ctx 执行请求的上下文
+ * @param tag 标签描述符
+ * @param value 输出读取到的数据值（含时间戳、质量）
+ * @return StatusCode::OK 成功；InvalidParam/Error 等
+ */
+StatusCode ModbusAdapter::read_single(modbus_t* ctx, const TagDescriptor& tag, DataValue& value) {
+    uint16_t registers[MODBUS_MAX_READ_REGISTERS];
+    uint8_t bits[MODBUS_MAX_READ_BITS];
+    
+    if (tag.count > (tag.is_bit() ? MODBUS_MAX_READ_BITS : MODBUS_MAX_READ_REGISTERS)) {
+        return StatusCode::InvalidParam;
+    }
+    
+    if (read_range(ctx, tag.slave_id, tag.function_code, tag.address, tag.count, registers, bits) != tag.count) {
         return StatusCode::Error;
     }
     
-    // 设置时间戳和质量
+    if (tag.is_bit()) {
+        decode_bits(tag, bits, value);
+    } else {
+        tag.decode(registers, value);
+    }
+    
     value.timestamp_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
         std::chrono::system_clock::now().time_since_epoch()).count();
     value.quality = 1; // Good
@@ -394,54 +1429,568 @@ StatusCode ModbusAdapter::read_register(const DeviceTag& tag, DataValue& value)
 }
 
 /**
- * 写入单个标签对应的寄存器/线圈
- * 根据 function_code 调用不同的 Modbus 写函数（简化实现）。
- * @param tag 设备标签（包含地址与功能码等）
- * @param value 待写入的值
- * @return StatusCode::OK 成功；NotSupported/Error/InvalidParam 等
+ * 按块读取一组标签
+ * 标签经扫描规划器按从站分组并合并为块读，每块一次 Modbus 请求，再拆分回各标签的值。
+ * 块按从站排序，同一从站的块连续执行，从站切换每组只发生一次。
+ * @param tags 已编译的标签描述符
+ * @param values 输出数据值，与 tags 一一对应
+ * @param results 输入编译结果，输出每个标签的读取结果，与 tags 一一对应
+ * @return StatusCode::OK 全部成功；否则为首个失败标签的状态码
+ */
+StatusCode ModbusAdapter::read_tags(const std::vector<TagDescriptor>& tags, std::vector<DataValue>& values,
+                                    std::vector<StatusCode>& results) {
+    prepare_read(tags, values, results);
+    execute_blocks(m_planner.plan(tags), tags, values, results);
+    return first_failure(results);
+}
+
+/**
+ * 在当前请求内连续执行一组块读（写后读等不分步的请求使用）
+ * @param blocks 块读请求列表
+ * @param tags 标签描述符
+ * @param values 输出数据值（只写入块内标签）
+ * @param results 输出每个标签的读取结果（只写入块内标签）
+ */
+void ModbusAdapter::execute_blocks(const std::vector<ScanBlock>& blocks, const std::vector<TagDescriptor>& tags,
+                                   std::vector<DataValue>& values, std::vector<StatusCode>& results) {
+    BlockRun run{&blocks, &tags, &values, &results, 0};
+    while (step_blocks(run)) {}
+}
+
+/**
+ * 执行一组块读的一步
+ * 按配置选择连接池并行、TCP 流水线（整批为一步）或逐块顺序执行（每块一步）。
+ * 每块开始前检查链路：此前的块读或其间执行的写请求使链路失败达到阈值时立即判定断线，
+ * 其余块标记为 NotConnected，不再逐块等待响应超时。
+ * @param run 块读状态
+ * @return 还有未执行的块返回 true
+ */
+bool ModbusAdapter::step_blocks(BlockRun& run) {
+    const std::vector<ScanBlock>& blocks = *run.blocks;
+    if (run.next >= blocks.size()) {
+        return false;
+    }
+    check_link();
+    if (!m_connected) {
+        for (size_t i = run.next; i < blocks.size(); ++i) {
+            for (size_t index : blocks[i].items) {
+                (*run.results)[index] = StatusCode::NotConnected;
+            }
+        }
+        run.next = blocks.size();
+        return false;
+    }
+    
+    if (run.next == 0 && blocks.size() > 1) {
+        if (m_pool.size() > 0) {
+            read_blocks_parallel(blocks, *run.tags, *run.values, *run.results);
+            run.next = blocks.size();
+            return false;
+        }
+        if (m_connection_type == "tcp" && m_pipeline.depth() > 1) {
+            read_blocks_pipelined(blocks, *run.tags, *run.values, *run.results);
+            run.next = blocks.size();
+            return false;
+        }
+    }
+    if (run.next == 0 && m_connection_type == "tcp") {
+        ModbusConnectionPool::ensure_alive(m_modbus_ctx.get());
+    }
+    read_block(m_modbus_ctx.get(), blocks[run.next], *run.tags, *run.values, *run.results);
+    return ++run.next < blocks.size();
+}
+
+/**
+ * 检查块长度是否超出协议上限
+ * 仅当单个标签自身超出上限时才会发生（规划器不会合并出超限的块）。
+ * @return 超限时将块内标签标记为 InvalidParam 并返回 false
  */
-StatusCode ModbusAdapter::write_register(const DeviceTag& tag, const DataValue& value) {
-    auto it = tag.attributes.find("register_address");
-    if (it == tag.attributes.end()) {
+bool ModbusAdapter::check_block_size(const ScanBlock& block, std::vector<StatusCode>& results) {
+    const bool bit_block = block.function_code == 1 || block.function_code == 2;
+    if (block.count <= (bit_block ? MODBUS_MAX_READ_BITS : MODBUS_MAX_READ_REGISTERS)) {
+        return true;
+    }
+    for (size_t index : block.items) {
+        results[index] = StatusCode::InvalidParam;
+    }
+    return false;
+}
+
+/**
+ * 执行一次块读并拆分到各标签
+ * @param ctx 执行请求的上下文
+ * @param block 块读请求
+ * @param tags 标签描述符（block.items 为其下标）
+ * @param values 输出数据值
+ * @param results 输出每个标签的读取结果
+ * @return StatusCode::OK 块读成功；Error 块读失败
+ */
+StatusCode ModbusAdapter::read_block(modbus_t* ctx, const ScanBlock& block, const std::vector<TagDescriptor>& tags,
+                                     std::vector<DataValue>& values, std::vector<StatusCode>& results) {
+    uint16_t registers[MODBUS_MAX_READ_REGISTERS];
+    uint8_t bits[MODBUS_MAX_READ_BITS];
+    
+    if (!check_block_size(block, results)) {
         return StatusCode::InvalidParam;
     }
     
-    int address = std::stoi(it->second);
-    int function_code = get_function_code(tag);
+    int result = read_range(ctx, block.slave_id, block.function_code, block.start_address, block.count,
+                            registers, bits);
+    return finish_block(ctx, block, tags, result, errno, registers, bits, values, results);
+}
+
+/**
+ * 将块读结果拆分到各标签
+ * 若块内含有为合并而多读的空闲地址且设备返回非法地址异常，则退回逐标签读取。
+ * @param ctx 逐标签回退时使用的上下文
+ * @param block 块读请求
+ * @param tags 标签描述符（block.items 为其下标）
+ * @param result 块读返回值（成功为 block.count）
+ * @param error 块读失败时的错误码
+ * @param registers 寄存器数据（FC3/FC4）
+ * @param bits 位数据（FC1/FC2）
+ * @param values 输出数据值
+ * @param results 输出每个标签的读取结果
+ * @return StatusCode::OK 块读成功；Error 块读失败
+ */
+StatusCode ModbusAdapter::finish_block(modbus_t* ctx, const ScanBlock& block, const std::vector<TagDescriptor>& tags,
+                                       int result, int error, const uint16_t* registers, const uint8_t* bits,
+                                       std::vector<DataValue>& values, std::vector<StatusCode>& results) {
+    record_link_result(block.slave_id, result, error);
     
-    int result = -1;
+    if (result != block.count) {
+        if (result == -1 && error == EMBXILADD && block.items.size() > 1) {
+            // 合并读到了设备未实现的地址，逐个标签重读
+            for (size_t index : block.items) {
+                results[index] = read_single(ctx, tags[index], values[index]);
+            }
+            return StatusCode::OK;
+        }
+        for (size_t index : block.items) {
+            results[index] = StatusCode::Error;
+        }
+        return StatusCode::Error;
+    }
     
-    switch (function_code) {
-        case 5: // 写单个线圈
-            {
-                bool coil_value = std::get<bool>(value.value);
-                result = modbus_write_bit(m_modbus_ctx.get(), address, coil_value ? 1 : 0);
+    const bool bit_block = block.function_code == 1 || block.function_code == 2;
+    uint64_t timestamp_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    
+    const std::vector<size_t>& items = block.items;
+    for (size_t k = 0; k < items.size();) {
+        const TagDescriptor& tag = tags[items[k]];
+        int offset = tag.address - block.start_address;
+        
+        if (bit_block) {
+            decode_bits(tag, bits + offset, values[items[k]]);
+            ++k;
+            continue;
+        }
+        
+        // 地址首尾相接、类型与字节序相同的一串标签批量解码
+        size_t run = block_decode_run(tags, items, k);
+        if (run >= BLOCK_DECODE_MIN_RUN) {
+            DataValue* run_values[MODBUS_MAX_READ_REGISTERS];
+            for (size_t i = 0; i < run; ++i) {
+                run_values[i] = &values[items[k + i]];
             }
-            break;
-        case 6: // 写单个寄存器
-            {
-                int32_t reg_value32 = std::get<int32_t>(value.value);
-                uint16_t reg_value = static_cast<uint16_t>(reg_value32 & 0xFFFF);
-                result = modbus_write_register(m_modbus_ctx.get(), address, reg_value);
+            decode_values(registers + offset, run, tag.data_type, tag.byte_order, run_values);
+        } else {
+            run = 1;
+            tag.decode(registers + offset, values[items[k]]);
+        }
+        k += run;
+    }
+    
+    for (size_t index : items) {
+        values[index].timestamp_ms = timestamp_ms;
+        values[index].quality = 1; // Good
+    }
+    
+    return StatusCode::OK;
+}
+
+/**
+ * 通过 TCP 流水线执行一批块读
+ * 所有块在同一 socket 上以至多 pipeline_depth 个在途事务发出，响应返回后逐块拆分。
+ * @param blocks 块读请求列表
+ * @param tags 标签描述符
+ * @param values 输出数据值
+ * @param results 输出每个标签的读取结果
+ */
+void ModbusAdapter::read_blocks_pipelined(const std::vector<ScanBlock>& blocks, const std::vector<TagDescriptor>& tags,
+                                          std::vector<DataValue>& values, std::vector<StatusCode>& results) {
+    // 请求与缓冲都是跨批次复用的成员，容量增长到最大批次后稳态下不再分配
+    std::vector<PipelineRequest>& requests = m_pipeline_requests;
+    std::vector<const ScanBlock*>& request_blocks = m_pipeline_blocks;
+    requests.clear();
+    request_blocks.clear();
+    requests.reserve(blocks.size());
+    request_blocks.reserve(blocks.size());
+    
+    size_t register_total = 0;
+    size_t bit_total = 0;
+    for (const auto& block : blocks) {
+        bool bit_block = block.function_code == 1 || block.function_code == 2;
+        (bit_block ? bit_total : register_total) += block.count;
+    }
+    m_pipeline_registers.resize(register_total);
+    m_pipeline_bits.resize(bit_total);
+    
+    size_t register_offset = 0;
+    size_t bit_offset = 0;
+    for (const auto& block : blocks) {
+        if (!check_block_size(block, results)) {
+            continue;
+        }
+        PipelineRequest request;
+        request.slave_id = static_cast<uint8_t>(block.slave_id);
+        request.function_code = static_cast<uint8_t>(block.function_code);
+        request.address = static_cast<uint16_t>(block.start_address);
+        request.count = static_cast<uint16_t>(block.count);
+        if (block.function_code == 1 || block.function_code == 2) {
+            request.bits = m_pipeline_bits.data() + bit_offset;
+            bit_offset += block.count;
+        } else {
+            request.registers = m_pipeline_registers.data() + register_offset;
+            register_offset += block.count;
+        }
+        requests.push_back(request);
+        request_blocks.push_back(&block);
+    }
+    
+    ModbusConnectionPool::ensure_alive(m_modbus_ctx.get());
+    if (m_adaptive_timeout) {
+        std::lock_guard<std::mutex> lock(m_rtt_mutex);
+        m_pipeline.set_response_timeout(std::chrono::duration_cast<std::chrono::milliseconds>(m_rtt.timeout()));
+    } else {
+        m_pipeline.set_response_timeout(m_response_timeout);
+    }
+    m_pipeline.execute(modbus_get_socket(m_modbus_ctx.get()), requests);
+    if (m_pipeline.had_timeout()) {
+        // 丢弃迟到的响应，避免干扰随后的 libmodbus 请求
+        modbus_flush(m_modbus_ctx.get());
+        if (m_adaptive_timeout) {
+            std::lock_guard<std::mutex> lock(m_rtt_mutex);
+            m_rtt.backoff();
+        }
+    }
+    
+    for (size_t i = 0; i < requests.size(); ++i) {
+        finish_block(m_modbus_ctx.get(), *request_blocks[i], tags, requests[i].result, requests[i].error,
+                     requests[i].registers, requests[i].bits, values, results);
+    }
+}
+
+/**
+ * 通过连接池并行执行一批块读
+ * 块读任务被主上下文与池中各上下文争抢执行；因连接不可用而未被执行的块标记为 Error。
+ * @param blocks 块读请求列表
+ * @param tags 标签描述符
+ * @param values 输出数据值
+ * @param results 输出每个标签的读取结果
+ */
+void ModbusAdapter::read_blocks_parallel(const std::vector<ScanBlock>& blocks, const std::vector<TagDescriptor>& tags,
+                                         std::vector<DataValue>& values, std::vector<StatusCode>& results) {
+    std::vector<uint8_t> done(blocks.size(), 0);
+    
+    // 各块的标签互不重叠，不同线程写入 values/results 的不同元素
+    m_pool.run(m_modbus_ctx.get(), blocks.size(), [&](modbus_t* ctx, size_t index) {
+        read_block(ctx, blocks[index], tags, values, results);
+        done[index] = 1;
+    });
+    
+    for (size_t i = 0; i < blocks.size(); ++i) {
+        if (!done[i]) {
+            for (size_t index : blocks[i].items) {
+                results[index] = StatusCode::Error;
             }
+        }
+    }
+}
+
+/**
+ * 编译并编码一组待写标签
+ * @param tags_and_values 待写入的标签与数值映射
+ * @param writes 输出待写项
+ * @return StatusCode::OK 成功；任一标签非法时返回其错误码
+ */
+StatusCode ModbusAdapter::prepare_writes(const std::map<DeviceTag, DataValue>& tags_and_values,
+                                         std::vector<PendingWrite>& writes) {
+    writes.clear();
+    writes.reserve(tags_and_values.size());
+    for (const auto& pair : tags_and_values) {
+        TagDescriptor tag;
+        PendingWrite write;
+        StatusCode result = compile_tag(pair.first, m_tag_defaults, tag);
+        if (result == StatusCode::OK) {
+            result = prepare_write(tag, pair.second, write);
+        }
+        if (result != StatusCode::OK) {
+            return result;
+        }
+        writes.push_back(write);
+    }
+    
+    order_writes(writes);
+    return StatusCode::OK;
+}
+
+/**
+ * 排序并合并待写项
+ * 按从站、数据表、地址排序，便于合并连续地址；同一寄存器的位写合并为一次 FC22。
+ * @param writes 待写项，原地排序合并
+ */
+void ModbusAdapter::order_writes(std::vector<PendingWrite>& writes) {
+    // 按从站、数据表、地址排序，便于合并连续地址
+    std::stable_sort(writes.begin(), writes.end(), [](const PendingWrite& a, const PendingWrite& b) {
+        if (a.slave_id != b.slave_id) return a.slave_id < b.slave_id;
+        if (a.bit != b.bit) return a.bit < b.bit;
+        return a.address < b.address;
+    });
+    
+    // 同一寄存器的位写合并为一次 FC22：依次施加两个掩码等价于
+    // AND = a1 & a2，OR = (o1 & ~a1 & a2) | (o2 & ~a2)
+    size_t merged = 0;
+    for (size_t i = 0; i < writes.size(); ++i) {
+        PendingWrite& last = writes[merged > 0 ? merged - 1 : 0];
+        const PendingWrite& write = writes[i];
+        if (merged > 0 && write.mask && last.mask && write.slave_id == last.slave_id && write.address == last.address) {
+            uint16_t or_mask = static_cast<uint16_t>((last.data[1] & ~last.data[0] & write.data[0])
+                                                     | (write.data[1] & ~write.data[0]));
+            last.data[0] = static_cast<uint16_t>(last.data[0] & write.data[0]);
+            last.data[1] = or_mask;
+        } else {
+            writes[merged++] = write;
+        }
+    }
+    writes.resize(merged);
+}
+
+/**
+ * 写入已排序的待写项，地址连续的项合并为一次 FC15/FC16 写
+ * @param writes 由 prepare_writes() 生成的待写项
+ * @return StatusCode::OK 成功；Error 写入失败
+ */
+StatusCode ModbusAdapter::write_pending(const std::vector<PendingWrite>& writes) {
+    size_t i = 0;
+    while (i < writes.size()) {
+        check_link(); // 前面的写入已使链路失败达到阈值时，其余写入不再逐个等待超时
+        if (!m_connected) {
+            return StatusCode::NotConnected;
+        }
+        size_t j = i + 1 + contiguous_writes(writes, i, writes[i].bit ? MODBUS_MAX_WRITE_BITS : MODBUS_MAX_WRITE_REGISTERS);
+        StatusCode result = write_group(&writes[i], j - i);
+        if (result != StatusCode::OK) {
+            return result;
+        }
+        i = j;
+    }
+    return StatusCode::OK;
+}
+
+/**
+ * 统计紧跟在 writes[first] 之后、可与其合并写入的项数
+ * @param writes 已排序的待写项
+ * @param first 起始项
+ * @param limit 合并后的最大寄存器/线圈数
+ * @return 可合并的后续项数
+ */
+size_t ModbusAdapter::contiguous_writes(const std::vector<PendingWrite>& writes, size_t first, int limit) {
+    const PendingWrite& head = writes[first];
+    int end = head.address + head.count;
+    size_t j = first + 1;
+    while (!head.single && j < writes.size()) {
+        const PendingWrite& next = writes[j];
+        if (next.single || next.slave_id != head.slave_id || next.bit != head.bit
+            || next.address != end || end + next.count - head.address > limit) {
             break;
-        case 15: // 写多个线圈（简化：写单个）
-            {
-                bool coil_value = std::get<bool>(value.value);
-                result = modbus_write_bit(m_modbus_ctx.get(), address, coil_value ? 1 : 0);
+        }
+        end += next.count;
+        ++j;
+    }
+    return j - first - 1;
+}
+
+/**
+ * 尝试以一次 FC23 事务完成写入与读取
+ * @param writes 已排序的待写项
+ * @param tags 读取标签描述符
+ * @param values 输出数据值
+ * @param results 输入编译结果，输出每个标签的读取结果
+ * @return 已通过 FC23 完成（无论成功与否）返回 true；不满足 FC23 条件或设备不支持时返回 false
+ */
+bool ModbusAdapter::write_and_read_registers(const std::vector<PendingWrite>& writes,
+                                             const std::vector<TagDescriptor>& tags,
+                                             std::vector<DataValue>& values, std::vector<StatusCode>& results) {
+    if (writes.empty() || writes.front().bit || writes.front().mask
+        || contiguous_writes(writes, 0, MODBUS_MAX_WR_WRITE_REGISTERS) + 1 != writes.size()) {
+        return false;
+    }
+    for (size_t i = 0; i < tags.size(); ++i) {
+        if (results[i] != StatusCode::OK || tags[i].function_code != 3) {
+            return false;
+        }
+    }
+    
+    std::vector<ScanBlock> blocks = m_planner.plan(tags);
+    if (blocks.size() != 1 || blocks.front().slave_id != writes.front().slave_id
+        || blocks.front().count > MODBUS_MAX_WR_READ_REGISTERS) {
+        return false;
+    }
+    const ScanBlock& block = blocks.front();
+    
+    uint16_t source[MODBUS_MAX_WR_WRITE_REGISTERS];
+    uint16_t registers[MODBUS_MAX_WR_READ_REGISTERS];
+    int total = 0;
+    for (const PendingWrite& write : writes) {
+        for (uint16_t k = 0; k < write.count; ++k) {
+            source[total++] = write.data[k];
+        }
+    }
+    
+    modbus_t* ctx = m_modbus_ctx.get();
+    int frame = 13 + 2 * total + 5 + 2 * block.count;
+    auto start = start_transaction(ctx, block.slave_id, frame, true);
+    ModbusRtuTransport* native = m_bus ? m_bus->native() : nullptr;
+    int result = native
+        ? native->write_and_read_registers(block.slave_id, writes.front().address, total, source,
+                                           block.start_address, block.count, registers)
+        : modbus_write_and_read_registers(ctx, writes.front().address, total, source,
+                                          block.start_address, block.count, registers);
+    int error = result == -1 ? errno : 0;
+    finish_transaction(ctx, start, frame, result, error);
+    if (result == -1 && error == EMBXILFUN) {
+        // 设备不支持 FC23，此后退回先写后读（写请求未被执行）
+        m_write_and_read = false;
+        return false;
+    }
+    
+    values.resize(tags.size());
+    finish_block(ctx, block, tags, result, error, registers, nullptr, values, results);
+    return true;
+}
+
+/**
+ * 使被写入地址的缓存值失效
+ * 写入失败时设备上的值也可能已部分改变，同样失效。
+ * @param writes 已执行的待写项
+ */
+void ModbusAdapter::invalidate_cache(const std::vector<PendingWrite>& writes) {
+    for (const PendingWrite& write : writes) {
+        m_cache.invalidate(write.slave_id, write.bit, write.address, write.count);
+    }
+}
+
+/**
+ * 将标签值编码为待写项
+ * 线圈表（FC1/5/15）写线圈，保持寄存器表（FC3/6/16）按数据类型与字节序写寄存器，
+ * 寄存器位标签以 FC22 掩码写只改动目标位；离散输入与输入寄存器只读。
+ * @param tag 标签描述符
+ * @param value 待写入的值
+ * @param write 输出待写项
+ * @return StatusCode::OK 成功；NotSupported 只读表；InvalidParam 值类型不匹配或超出范围
+ */
+StatusCode ModbusAdapter::prepare_write(const TagDescriptor& tag, const DataValue& value, PendingWrite& write) {
+    write.address = tag.address;
+    write.slave_id = tag.slave_id;
+    write.single = tag.function_code == 5 || tag.function_code == 6;
+    
+    switch (tag.function_code) {
+        case 1:
+        case 5:
+        case 15:
+            write.bit = true;
+            write.count = tag.is_packed_bits() ? tag.count : 1;
+            if (tag.address + write.count > 0x10000) {
+                return StatusCode::InvalidParam;
             }
-            break;
-        case 16: // 写多个寄存器（简化：写单个低16位）
             {
-                int32_t reg_value32 = std::get<int32_t>(value.value);
-                uint16_t reg_value = static_cast<uint16_t>(reg_value32 & 0xFFFF);
-                result = modbus_write_register(m_modbus_ctx.get(), address, reg_value);
+                uint32_t bits = 0;
+                StatusCode result = encode_bits(tag, value, bits);
+                write.data[0] = static_cast<uint16_t>(bits & 0xFFFF);
+                write.data[1] = static_cast<uint16_t>(bits >> 16);
+                return result;
             }
-            break;
+        case 3:
+        case 6:
+        case 16:
+            write.bit = false;
+            if (tag.bit >= 0) {
+                // 寄存器位：以掩码写只改动目标位
+                write.mask = true;
+                write.single = true;
+                write.count = 1;
+                return encode_register_bit(tag, value, write.data[0], write.data[1]);
+            }
+            write.count = static_cast<uint16_t>(register_width(tag.data_type));
+            if (tag.address + write.count > 0x10000) {
+                return StatusCode::InvalidParam;
+            }
+            return encode_registers(tag, value, write.data);
         default:
             return StatusCode::NotSupported;
     }
+}
+
+/**
+ * 写入一组地址连续的待写项
+ * 寄存器位使用 FC22；单个 16 位寄存器或单个线圈使用 FC6/FC5，其余使用 FC16/FC15 一次写入。
+ * @param first 第一项
+ * @param count 项数（同一从站、同一数据表、地址连续）
+ * @return StatusCode::OK 成功；Error 写入失败
+ */
+StatusCode ModbusAdapter::write_group(const PendingWrite* first, size_t count) {
+    modbus_t* ctx = m_modbus_ctx.get();
+    int address = first->address;
+    int result = -1;
     
+    int total_count = 0;
+    for (size_t i = 0; i < count; ++i) {
+        total_count += first[i].count;
+    }
+    bool single = count == 1 && first->count == 1;
+    int function_code = first->mask ? 22 : single ? (first->bit ? 5 : 6) : (first->bit ? 15 : 16);
+    int frame = frame_bytes(function_code, total_count);
+    auto start = start_transaction(ctx, first->slave_id, frame, true);
+    ModbusRtuTransport* native = m_bus ? m_bus->native() : nullptr;
+    
+    if (first->mask) {
+        result = native ? native->mask_write_register(first->slave_id, address, first->data[0], first->data[1])
+                        : modbus_mask_write_register(ctx, address, first->data[0], first->data[1]);
+    } else if (single && native) {
+        result = first->bit ? native->write_bit(first->slave_id, address, first->data[0])
+                            : native->write_register(first->slave_id, address, first->data[0]);
+    } else if (single) {
+        result = first->bit ? modbus_write_bit(ctx, address, first->data[0])
+                            : modbus_write_register(ctx, address, first->data[0]);
+    } else if (first->bit) {
+        // 多线圈标签的值按位打包在 data[0]（低 16 位）与 data[1]（高 16 位）
+        uint8_t bits[MODBUS_MAX_WRITE_BITS];
+        int total = 0;
+        for (size_t i = 0; i < count; ++i) {
+            uint32_t packed = first[i].data[0] | (static_cast<uint32_t>(first[i].data[1]) << 16);
+            for (uint16_t k = 0; k < first[i].count; ++k) {
+                bits[total++] = static_cast<uint8_t>((packed >> k) & 1);
+            }
+        }
+        result = native ? native->write_bits(first->slave_id, address, total, bits)
+                        : modbus_write_bits(ctx, address, total, bits);
+    } else {
+        uint16_t registers[MODBUS_MAX_WRITE_REGISTERS];
+        int total = 0;
+        for (size_t i = 0; i < count; ++i) {
+            for (uint16_t k = 0; k < first[i].count; ++k) {
+                registers[total++] = first[i].data[k];
+            }
+        }
+        result = native ? native->write_registers(first->slave_id, address, total, registers)
+                        : modbus_write_registers(ctx, address, total, registers);
+    }
+    
+    int error = errno;
+    finish_transaction(ctx, start, frame, result, error);
+    record_link_result(first->slave_id, result, error);
     if (result == -1) {
         return StatusCode::Error;
     }
@@ -451,79 +2000,216 @@ StatusCode ModbusAdapter::write_register(const DeviceTag& tag, const DataValue&
 
 /**
  * 订阅线程工作函数
- * 每秒轮询一次已订阅标签，读取成功则触发回调。
+ * 以单调时钟上的截止时间推进时间轮节拍（sleep_until），处理超时按 overrun_policy 处理，
+ * 并统计执行了扫描的节拍的耗时、唤醒抖动，以及错过的截止时间。启用按例外上报时只有变化的标签进入回调，
+ * 周期内无变化则不触发回调。
  */
 void ModbusAdapter::subscription_worker() {
+    using clock = std::chrono::steady_clock;
+    
+    std::vector<DataValue> tag_values(m_subscribed_descriptors.size());
+    std::vector<StatusCode> results(m_subscribed_results);
+    const clock::duration tick = m_scheduler.tick();
+    clock::time_point deadline = clock::now() + tick;
+    uint32_t pending = 0; // Skip 策略下并入下一节拍的到期扫描类
+    
+    {
+        std::lock_guard<std::mutex> lock(m_stats_mutex);
+        m_cycle_stats = CycleStatistics();
+    }
+    
     while (m_subscription_active) {
-        std::this_thread::sleep_for(m_poll_interval); // 设置轮询时间
+        std::this_thread::sleep_until(deadline); // 按截止时间唤醒，周期不随 I/O 耗时漂移
+        clock::time_point wake = clock::now();
+        clock::time_point scheduled = deadline;
+        uint32_t due = m_scheduler.advance() | pending;
+        pending = 0;
         
-        // 已连接且回调函数已设置
-        if (!m_connected || !m_callback) {
-            continue;
+        // 已连接、回调函数已设置且有扫描类到期
+        bool scanned = m_connected && m_callback && due != 0;
+        if (scanned) {
+            scan_cycle(due, tag_values, results);
         }
         
-        std::map<DeviceTag, DataValue> values;
-        bool has_data = false;
-        
-        for (const auto& tag : m_subscribed_tags) {
-            DataValue value;
-            if (read_register(tag, value) == StatusCode::OK) {
-                values[tag] = value;
-                has_data = true;
+        clock::time_point end = clock::now();
+        deadline += tick;
+        uint64_t missed = 0;
+        if (end >= deadline) {
+            missed = static_cast<uint64_t>((end - deadline) / tick) + 1;
+            switch (m_overrun_policy) {
+                case OverrunPolicy::Skip:
+                    for (uint64_t i = 0; i < missed; ++i) {
+                        pending |= m_scheduler.advance();
+                    }
+                    deadline += tick * missed;
+                    break;
+                case OverrunPolicy::CatchUp:
+                    break; // sleep_until 立即返回，逐个补执行
+                case OverrunPolicy::Stretch:
+                    deadline = end + tick;
+                    break;
             }
         }
         
-        if (has_data) {
-            m_callback(values);
+        auto to_us = [](clock::duration d) {
+            return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(d).count());
+        };
+        std::lock_guard<std::mutex> lock(m_stats_mutex);
+        CycleStatistics& stats = m_cycle_stats;
+        stats.missed_deadlines += missed;
+        if (!scanned) {
+            continue; // 没有扫描类到期的空节拍不计入周期数、耗时与抖动，否则平均值被稀释
         }
+        stats.cycles++;
+        stats.last_duration_us = to_us(end - wake);
+        stats.max_duration_us = std::max(stats.max_duration_us, stats.last_duration_us);
+        stats.total_duration_us += stats.last_duration_us;
+        stats.last_jitter_us = to_us(wake - scheduled);
+        stats.max_jitter_us = std::max(stats.max_jitter_us, stats.last_jitter_us);
+        stats.total_jitter_us += stats.last_jitter_us;
     }
 }
 
 /**
- * 设置订阅线程的轮询时间
- * @param interval 轮询时间 1ms为单位
+ * 执行一个节拍的扫描并回调
+ * 读取作为分步的扫描请求在 I/O 线程上执行，每步读一块，与同步读写串行；过滤与回调在订阅线程上执行。
+ * 标签读取由成功转为失败时保留上次的值、质量置为 Bad 上报一次，恢复后以 Good 质量重新上报。
+ * @param due 到期扫描类位掩码
+ * @param tag_values 各订阅标签的最新值（跨节拍复用）
+ * @param results 各订阅标签的读取结果（跨节拍复用）
  */
-void ModbusAdapter::set_poll_interval(std::chrono::milliseconds interval) {
-    m_poll_interval = interval;
+void ModbusAdapter::scan_cycle(uint32_t due, std::vector<DataValue>& tag_values, std::vector<StatusCode>& results) {
+    StatusCode scanned = StatusCode::OK;
+    BlockRun run;
+    StatusCode queued = m_io.call_steps(IoKind::Scan, [&] {
+        if (!run.blocks) {
+            if (!m_connected) {
+                scanned = StatusCode::NotConnected;
+                return false;
+            }
+            for (size_t c = 0; c < m_class_tags.size(); ++c) {
+                if (due & (1u << c)) {
+                    for (size_t i : m_class_tags[c]) {
+                        results[i] = m_subscribed_results[i];
+                    }
+                }
+            }
+            run = BlockRun{&scan_plan(due), &m_subscribed_descriptors, &tag_values, &results, 0};
+        }
+        if (step_blocks(run)) {
+            return true;
+        }
+        if (m_value_cache) {
+            for (size_t c = 0; c < m_class_tags.size(); ++c) {
+                if (due & (1u << c)) {
+                    m_cache.store(m_subscribed_descriptors, tag_values, results, m_class_tags[c]);
+                }
+            }
+        }
+        check_link();
+        return false;
+    });
+    if (queued != StatusCode::OK || scanned != StatusCode::OK) {
+        return;
+    }
+    
+    m_batch.clear();
+    uint64_t now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+    
+    for (size_t c = 0; c < m_class_tags.size(); ++c) {
+        if (!(due & (1u << c))) {
+            continue;
+        }
+        for (size_t i : m_class_tags[c]) {
+            if (results[i] != StatusCode::OK) {
+                // 读取由成功转为失败时以上次的值上报一次 Bad 质量样本；从未读到或已是 Bad 的不再上报
+                if (tag_values[i].quality == 0) {
+                    continue;
+                }
+                tag_values[i].quality = 0; // Bad
+                tag_values[i].timestamp_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::system_clock::now().time_since_epoch()).count();
+            }
+            if (!m_report_by_exception || m_change_filter.update(i, tag_values[i], now_ms)) {
+                TagSample sample;
+                sample.index = static_cast<uint32_t>(i);
+                to_compact(tag_values[i], sample.value); // 本适配器只产生数值
+                m_batch.push_back(sample);
+            }
+        }
+    }
+    
+    if (!m_batch.empty()) {
+        m_callback(TagSampleSpan{m_batch.data(), m_batch.size(), nullptr});
+    }
 }
 
 /**
- * 获取标签的寄存器地址
- * @param tag 设备标签
- * @return 地址，未配置则返回 0
+ * 按标签的 scan_class 属性划分扫描类并配置时间轮
+ * scan_class 可为 scan_classes 中定义的名称或直接给出的毫秒数；未指定或无法识别时
+ * 归入默认扫描类（周期为 poll_interval）。周期相同的标签归入同一扫描类。
  */
-int ModbusAdapter::get_register_address(const DeviceTag& tag) {
-    auto it = tag.attributes.find("register_address");
-    if (it != tag.attributes.end()) {
-        return std::stoi(it->second);
+void ModbusAdapter::assign_scan_classes(const std::vector<DeviceTag>& tags) {
+    std::vector<uint32_t> periods{static_cast<uint32_t>(m_poll_interval.count())};
+    m_class_tags.assign(1, {});
+    m_plan_cache.clear();
+    
+    for (size_t i = 0; i < tags.size(); ++i) {
+        uint32_t period = periods[0];
+        auto attr = tags[i].attributes.find("scan_class");
+        if (attr != tags[i].attributes.end()) {
+            auto named = m_scan_classes.find(attr->second);
+            int ms = 0;
+            if (named != m_scan_classes.end()) {
+                period = named->second;
+            } else if (try_get_config_value(tags[i].attributes, "scan_class", ms) && ms > 0) {
+                period = static_cast<uint32_t>(ms);
+            }
+        }
+        
+        size_t scan_class = std::find(periods.begin(), periods.end(), period) - periods.begin();
+        if (scan_class == periods.size()) {
+            if (periods.size() >= ScanScheduler::MAX_CLASSES) {
+                scan_class = 0;
+            } else {
+                periods.push_back(period);
+                m_class_tags.emplace_back();
+            }
+        }
+        m_class_tags[scan_class].push_back(i);
     }
-    return 0;
+    
+    m_scheduler.configure(periods);
 }
 
 /**
- * 获取标签需要读取的寄存器数量
- * @param tag 设备标签
- * @return 数量，未配置则默认 1
+ * 获取一组到期扫描类的块读计划
+ * 同一节拍到期的扫描类合并规划，相邻地址可跨类合并为一次请求；计划按到期掩码缓存。
+ * @param due 到期扫描类位掩码
+ * @return 块读请求列表
  */
-int ModbusAdapter::get_register_count(const DeviceTag& tag) {
-    auto it = tag.attributes.find("register_count");
-    if (it != tag.attributes.end()) {
-        return std::stoi(it->second);
+const std::vector<ScanBlock>& ModbusAdapter::scan_plan(uint32_t due) {
+    auto it = m_plan_cache.find(due);
+    if (it != m_plan_cache.end()) {
+        return it->second;
     }
-    return 1;
+    
+    std::vector<size_t> indices;
+    for (size_t c = 0; c < m_class_tags.size(); ++c) {
+        if (due & (1u << c)) {
+            indices.insert(indices.end(), m_class_tags[c].begin(), m_class_tags[c].end());
+        }
+    }
+    return m_plan_cache.emplace(due, m_planner.plan(m_subscribed_descriptors, indices)).first->second;
 }
 
 /**
- * 获取标签对应的功能码
- * @param tag 设备标签
- * @return 功能码，未配置则默认 3（读保持寄存器）
+ * 设置订阅线程的轮询时间
+ * @param interval 轮询时间 1ms为单位
  */
-int ModbusAdapter::get_function_code(const DeviceTag& tag) {
-    auto it = tag.attributes.find("function_code");
-    if (it != tag.attributes.end()) {
-        return std::stoi(it->second);
-    }
-    return 3; // 默认读保持寄存器
+void ModbusAdapter::set_poll_interval(std::chrono::milliseconds interval) {
+    m_poll_interval = interval;
 }
 
 } // namespace southbound
\ No newline at end of file
@@ -3,9 +3,22 @@
 #include <southbound/IAdapter.hpp>
 #include <southbound/Types.hpp>
 #include <modbus/modbus.h>
+#include "ChangeFilter.hpp"
+#include "IoActor.hpp"
+#include "LastValueCache.hpp"
+#include "ModbusConnectionPool.hpp"
+#include "ModbusTcpPipeline.hpp"
+#include "ReconnectBackoff.hpp"
+#include "RttEstimator.hpp"
+#include "RtuBus.hpp"
+#include "ScanPlanner.hpp"
+#include "ScanScheduler.hpp"
+#include "TagDescriptor.hpp"
+#include <array>
 #include <memory>
 #include <thread>
 #include <atomic>
+#include <condition_variable>
 #include <mutex>
 #include <vector>
 #include <map>
@@ -22,10 +35,27 @@ public:
     virtual StatusCode connect() override;
     virtual StatusCode disconnect() override;
     virtual StatusCode read(const std::vector<DeviceTag>& tags, std::vector<DataValue>& values) override;
+    virtual StatusCode read_cached(const std::vector<DeviceTag>& tags, std::vector<DataValue>& values,
+                                   std::chrono::milliseconds max_age) override;
     virtual StatusCode write(const std::map<DeviceTag, DataValue>& tags_and_values) override;
+    virtual void read_async(const std::vector<DeviceTag>& tags, const AsyncOptions& options,
+                            ReadHandler handler) override;
+    virtual void write_async(const std::map<DeviceTag, DataValue>& tags_and_values, const AsyncOptions& options,
+                             WriteHandler handler) override;
+    using IAdapter::read_async;
+    using IAdapter::write_async;
+    virtual StatusCode read_ids(const TagRegistry& registry, const std::vector<TagId>& ids,
+                                std::vector<DataValue>& values) override;
+    virtual StatusCode write_ids(const TagRegistry& registry, const std::vector<TagValue>& values) override;
+    virtual StatusCode subscribe_ids(const TagRegistry& registry, const std::vector<TagId>& ids,
+                                     OnTagDataCallback callback) override;
+    virtual StatusCode write_read(const std::map<DeviceTag, DataValue>& tags_and_values,
+                                  const std::vector<DeviceTag>& tags_to_read, std::vector<DataValue>& values) override;
     virtual StatusCode subscribe(const std::vector<DeviceTag>& tags, OnDataReceivedCallback callback) override;
+    virtual StatusCode subscribe_batch(const std::vector<DeviceTag>& tags, OnBatchDataCallback callback) override;
     virtual StatusCode get_status() override;
     virtual StatusCode unsubscribe() override;
+    virtual StatusCode get_statistics(AdapterStatistics& stats) override;
 
 private:
     // Modbus 相关
@@ -35,37 +65,191 @@ private:
     std::string m_ip_address;       // IP 地址 (TCP)
     std::chrono::milliseconds m_poll_interval{1000}; // 循环时间，默认1秒
     int m_port;                     // 端口号 (TCP)
-    int m_slave_id;                 // 从站 ID
+    int m_connections{1};           // 到同一网关的连接数 (TCP)
+    int m_slave_id;                 // 默认从站 ID
+    int m_active_slave_id;          // 上下文当前使用的从站 ID
     int m_baudrate;                 // 波特率 (RTU)
     char m_parity;                  // 校验位 (RTU)
     int m_data_bits;                // 数据位 (RTU)
     int m_stop_bits;                // 停止位 (RTU)
+    bool m_rtu_native{false};       // 使用原生 RTU 传输 (RTU)
+    std::shared_ptr<RtuBus> m_bus;  // 串口总线，同一串口上的设备共享 (RTU)
+    std::atomic<bool> m_bus_open{false}; // 本设备是否持有总线的打开引用
+    ScanPlanner m_planner;          // 块读规划器
+    TagDefaults m_tag_defaults;     // 标签编译默认值（从站 ID、字节序）
+    ModbusTcpPipeline m_pipeline;   // TCP 流水线引擎 (pipeline_depth > 1 时启用)
+    std::vector<uint16_t> m_pipeline_registers; // 流水线块读的寄存器缓冲
+    std::vector<uint8_t> m_pipeline_bits;       // 流水线块读的位缓冲
+    std::vector<PipelineRequest> m_pipeline_requests; // 流水线块读的请求，跨批次复用
+    std::vector<const ScanBlock*> m_pipeline_blocks;  // 各请求对应的块
+    ModbusConnectionPool m_pool;    // 额外连接 (connections > 1 时启用)
+    bool m_write_and_read{true};    // 写后读允许使用 FC23，设备不支持时自动关闭
+    std::chrono::milliseconds m_response_timeout{1000}; // 响应超时上限（timeout 键）
+    bool m_adaptive_timeout{true};  // 按实测往返时间自适应响应超时
+    RttEstimator m_rtt;             // 往返时间估计，由 m_rtt_mutex 保护
+    std::mutex m_rtt_mutex;
+    bool m_value_cache{true};       // 扫描与读取结果写入最新值缓存（value_cache 键）
+    LastValueCache m_cache;         // 最新值缓存，供 read_cached() 使用
+    
+    // 按 TagId 缓存的描述符（由 m_id_mutex 保护）
+    std::mutex m_id_mutex;
+    uint64_t m_id_registry{0};                   // 缓存对应的登记表 uid
+    std::vector<TagDescriptor> m_id_descriptors; // 以 TagId 为下标
+    std::vector<StatusCode> m_id_results;
+    std::vector<uint8_t> m_id_resolved;
     
     // 状态管理
     std::atomic<bool> m_connected{false};
     std::atomic<bool> m_initialized{false};
-    std::mutex m_mutex;
+    std::mutex m_mutex;             // 保护初始化、订阅状态与重连线程对象，不在 I/O 期间持有
+    IoActor m_io;                   // 本设备的全部总线 I/O 在其线程上串行执行
+    IoActor m_completions;          // 异步请求的 handler 在其线程上按完成顺序调用，不占用 I/O 线程
     
     // 订阅相关
-    std::vector<DeviceTag> m_subscribed_tags;
-    OnDataReceivedCallback m_callback;
+    std::vector<TagDescriptor> m_subscribed_descriptors; // 订阅时编译的描述符
+    std::vector<StatusCode> m_subscribed_results;        // 各标签的编译结果
+    OnBatchDataCallback m_callback;                      // map 与 TagId 回调均包装为批量回调
+    std::vector<TagSample> m_batch;                      // 批量回调缓冲区，容量为订阅标签数，跨节拍复用
+    ChangeFilter m_change_filter;                        // 按例外上报过滤器
+    DeadbandSpec m_deadband_defaults;                    // 设备级死区与最长静默时间
+    bool m_report_by_exception{true};                    // 仅上报变化的标签
+    std::map<std::string, uint32_t> m_scan_classes;      // 命名扫描类及其周期（毫秒）
+    ScanScheduler m_scheduler;                           // 扫描类时间轮
+    std::vector<std::vector<size_t>> m_class_tags;       // 每个扫描类的标签下标
+    std::map<uint32_t, std::vector<ScanBlock>> m_plan_cache; // 按到期掩码缓存的块读计划
+    OverrunPolicy m_overrun_policy{OverrunPolicy::Skip}; // 节拍超时处理策略
+    CycleStatistics m_cycle_stats;                       // 扫描周期统计
+    std::mutex m_stats_mutex;                            // 保护 m_cycle_stats
+    std::mutex m_subscription_mutex;                     // 串行化订阅线程的停止、重建与启动，先于 m_mutex 获取
     std::thread m_subscription_thread;
     std::atomic<bool> m_subscription_active{false};
+    
+    // 断线检测与后台重连
+    bool m_auto_reconnect{true};                 // 链路断开后自动重连
+    int m_link_failure_threshold{3};             // 连续链路级失败达到该次数判定断线
+    std::atomic<int> m_link_failures{0};         // 全部从站合计的当前连续链路级失败次数（统计用）
+    std::mutex m_link_mutex;                     // 保护以下按从站计数（连接池线程并发记录）
+    std::array<int, 256> m_slave_failures{};     // 各从站连续链路级失败次数（封顶于阈值）
+    std::array<bool, 256> m_slave_seen{};        // 本次连接以来访问过的从站
+    int m_seen_slaves{0};                        // 访问过的从站数
+    int m_silent_slaves{0};                      // 连续失败达到阈值的从站数
+    std::atomic<uint64_t> m_link_losses{0};      // 判定断线次数
+    std::atomic<uint64_t> m_reconnect_attempts{0};
+    ReconnectBackoff m_backoff;                  // 重连退避（仅重连线程使用）
+    std::thread m_reconnect_thread;
+    std::mutex m_reconnect_mutex;
+    std::condition_variable m_reconnect_cv;
+    bool m_link_lost{false};                     // 等待重连，由 m_reconnect_mutex 保护
+    bool m_reconnect_stop{false};                // 由 m_reconnect_mutex 保护
     void set_poll_interval(std::chrono::milliseconds interval);
     
     // 内部方法
     StatusCode parse_config(const AdapterConfig& config);
     StatusCode create_modbus_context();
-    StatusCode read_register(const DeviceTag& tag, DataValue& value);
-    StatusCode write_register(const DeviceTag& tag, const DataValue& value);
+    std::unique_ptr<modbus_t, void(*)(modbus_t*)> new_modbus_context() const;
+    void link_up();
+    void record_link_result(int slave_id, int result, int error);
+    void check_link();
+    void reconnect_worker();
+    bool try_reconnect();
+    void stop_reconnect();
+    int open_context(modbus_t* ctx);
+    void close_context();
+    void stop_subscription();
+    void start_subscription(const std::vector<DeviceTag>& tags);
+    void compile_tags(const std::vector<DeviceTag>& tags, std::vector<TagDescriptor>& descriptors,
+                      std::vector<StatusCode>& results);
+    void resolve_ids(const TagRegistry& registry, const std::vector<TagId>& ids,
+                     std::vector<TagDescriptor>& descriptors, std::vector<StatusCode>& results);
+    StatusCode read_compiled(const std::vector<TagDescriptor>& descriptors, std::vector<StatusCode>& results,
+                             std::vector<DataValue>& values);
+
+    /**
+     * @brief 分步执行的一组块读
+     * 每步读一块（连接池并行与 TCP 流水线整批为一步），I/O 线程在两步之间执行等待中的写请求。
+     */
+    struct BlockRun {
+        const std::vector<ScanBlock>* blocks{nullptr};
+        const std::vector<TagDescriptor>* tags{nullptr};
+        std::vector<DataValue>* values{nullptr};
+        std::vector<StatusCode>* results{nullptr};
+        size_t next{0};                 // 下一个待读的块
+    };
+
+    /**
+     * @brief 分步执行的一次读取（read/read_cached/read_async）
+     */
+    struct ReadRun {
+        ReadRun() = default;
+        ReadRun(const std::vector<TagDescriptor>& tags, std::vector<StatusCode>& tag_results,
+                std::vector<DataValue>& tag_values)
+            : descriptors(&tags), results(&tag_results), values(&tag_values) {}
+
+        const std::vector<TagDescriptor>* descriptors{nullptr};
+        std::vector<StatusCode>* results{nullptr};
+        std::vector<DataValue>* values{nullptr};
+        bool started{false};
+        std::vector<ScanBlock> plan;
+        BlockRun blocks;
+        StatusCode status{StatusCode::OK};
+    };
+
+    bool read_step(ReadRun& run);
+    bool step_blocks(BlockRun& run);
+    void select_slave(int slave_id);
+    int read_range(modbus_t* ctx, int slave_id, int function_code, int address, int count,
+                   uint16_t* registers, uint8_t* bits);
+    std::chrono::steady_clock::time_point start_transaction(modbus_t* ctx, int slave_id, int frame_bytes, bool urgent);
+    void finish_transaction(modbus_t* ctx, std::chrono::steady_clock::time_point start, int frame_bytes,
+                            int result, int error);
+    std::chrono::microseconds wire_time(int frame_bytes) const;
+    StatusCode read_single(modbus_t* ctx, const TagDescriptor& tag, DataValue& value);
+    StatusCode read_tags(const std::vector<TagDescriptor>& tags, std::vector<DataValue>& values,
+                         std::vector<StatusCode>& results);
+    StatusCode read_block(modbus_t* ctx, const ScanBlock& block, const std::vector<TagDescriptor>& tags,
+                          std::vector<DataValue>& values, std::vector<StatusCode>& results);
+    StatusCode finish_block(modbus_t* ctx, const ScanBlock& block, const std::vector<TagDescriptor>& tags,
+                            int result, int error, const uint16_t* registers, const uint8_t* bits,
+                            std::vector<DataValue>& values, std::vector<StatusCode>& results);
+    void read_blocks_pipelined(const std::vector<ScanBlock>& blocks, const std::vector<TagDescriptor>& tags,
+                               std::vector<DataValue>& values, std::vector<StatusCode>& results);
+    void read_blocks_parallel(const std::vector<ScanBlock>& blocks, const std::vector<TagDescriptor>& tags,
+                              std::vector<DataValue>& values, std::vector<StatusCode>& results);
+    bool check_block_size(const ScanBlock& block, std::vector<StatusCode>& results);
+    /**
+     * @brief 已编码的待写标签
+     */
+    struct PendingWrite {
+        uint16_t address{0};
+        uint16_t count{0};         // 占用的寄存器/线圈数
+        uint16_t data[4]{};        // 编码后的寄存器值；线圈写时 data[0] 为 0/1
+        uint8_t slave_id{1};
+        bool bit{false};           // 线圈写（FC5/FC15）
+        bool single{false};        // 标签指定 FC5/FC6，不与相邻标签合并
+        bool mask{false};          // 寄存器位写（FC22），data[0]/data[1] 为 AND/OR 掩码
+    };
+
+    StatusCode prepare_writes(const std::map<DeviceTag, DataValue>& tags_and_values, std::vector<PendingWrite>& writes);
+    static void order_writes(std::vector<PendingWrite>& writes);
+    StatusCode write_prepared(const std::vector<PendingWrite>& writes);
+    StatusCode write_on_io(const std::vector<PendingWrite>& writes);
+    StatusCode prepare_write(const TagDescriptor& tag, const DataValue& value, PendingWrite& write);
+    void invalidate_cache(const std::vector<PendingWrite>& writes);
+    StatusCode write_pending(const std::vector<PendingWrite>& writes);
+    static size_t contiguous_writes(const std::vector<PendingWrite>& writes, size_t first, int limit);
+    bool write_and_read_registers(const std::vector<PendingWrite>& writes, const std::vector<TagDescriptor>& tags,
+                                  std::vector<DataValue>& values, std::vector<StatusCode>& results);
+    StatusCode write_group(const PendingWrite* first, size_t count);
     void subscription_worker();
-    int get_register_address(const DeviceTag& tag);
-    int get_register_count(const DeviceTag& tag);
-    int get_function_code(const DeviceTag& tag);
+    void scan_cycle(uint32_t due, std::vector<DataValue>& tag_values, std::vector<StatusCode>& results);
+    void assign_scan_classes(const std::vector<DeviceTag>& tags);
+    const std::vector<ScanBlock>& scan_plan(uint32_t due);
+    void execute_blocks(const std::vector<ScanBlock>& blocks, const std::vector<TagDescriptor>& tags,
+                        std::vector<DataValue>& values, std::vector<StatusCode>& results);
 
     /**
     * @brief [模板版本] 尝试从配置 map 中获取值并转换为目标类型 T。
-    * @tparam T 目标数据类型 (int, std::string, char, etc.)
+    * @tparam T 目标数据类型 (int, double, bool, std::string, char)
     * @param config 输入的配置 map。
     * @param key 要查找的键。
     * @param out_value 用于存储结果的目标类型引用。
@@ -99,6 +283,29 @@ private:
             }
         }
 
+        // 判断是否为double类型
+        else if constexpr (std::is_same_v<T, double>) {
+            try {
+                out_value = std::stod(value_str);
+                return true;
+            } catch (const std::exception&) {
+                return false; // 转换失败
+            }
+        }
+
+        // 判断是否为bool类型
+        else if constexpr (std::is_same_v<T, bool>) {
+            if (value_str == "true" || value_str == "1") {
+                out_value = true;
+                return true;
+            }
+            if (value_str == "false" || value_str == "0") {
+                out_value = false;
+                return true;
+            }
+            return false;
+        }
+
         // 判断是否为char类型
         else if constexpr (std::is_same_v<T, char>) {
             if (!value_str.empty()) {
@@ -0,0 +1,209 @@
+#include "ModbusConnectionPool.hpp"
+#include <cerrno>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+
+namespace southbound {
+
+/**
+ * 析构函数
+ * 停止工作线程并关闭连接。
+ */
+ModbusConnectionPool::~ModbusConnectionPool() {
+    close();
+}
+
+/**
+ * 建立额外连接并启动工作线程
+ * 连接失败的上下文被丢弃，池以成功建立的连接继续工作。
+ * @param ip_address 网关地址
+ * @param port 网关端口
+ * @param count 额外连接数
+ * @param reference 主上下文，用于复制响应超时
+ * @return 成功建立的连接数
+ */
+size_t ModbusConnectionPool::open(const std::string& ip_address, int port, int count, modbus_t* reference) {
+    close();
+
+    uint32_t timeout_sec = 1;
+    uint32_t timeout_usec = 0;
+    if (reference) {
+        modbus_get_response_timeout(reference, &timeout_sec, &timeout_usec);
+    }
+
+    uint64_t generation;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = false;
+        generation = m_generation;
+    }
+
+    for (int i = 0; i < count; ++i) {
+        auto connection = std::make_unique<Connection>();
+        connection->ctx.reset(modbus_new_tcp(ip_address.c_str(), port));
+        if (!connection->ctx) {
+            continue;
+        }
+        modbus_set_response_timeout(connection->ctx.get(), timeout_sec, timeout_usec);
+        if (modbus_connect(connection->ctx.get()) == -1) {
+            continue;
+        }
+        tune_socket(modbus_get_socket(connection->ctx.get()));
+        connection->thread = std::thread(&ModbusConnectionPool::worker, this, connection->ctx.get(), generation);
+        m_connections.push_back(std::move(connection));
+    }
+
+    return m_connections.size();
+}
+
+/**
+ * 停止工作线程并关闭全部额外连接
+ */
+void ModbusConnectionPool::close() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_work_cv.notify_all();
+
+    for (auto& connection : m_connections) {
+        if (connection->thread.joinable()) {
+            connection->thread.join();
+        }
+        modbus_close(connection->ctx.get());
+    }
+    m_connections.clear();
+}
+
+/**
+ * 并行执行任务
+ * 任务按序号被各上下文争抢领取，调用线程在主上下文上同时参与执行。
+ * @param primary 主上下文
+ * @param task_count 任务数量
+ * @param task 任务函数
+ */
+void ModbusConnectionPool::run(modbus_t* primary, size_t task_count, const Task& task) {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_task = &task;
+        m_task_count = task_count;
+        m_next_task = 0;
+        m_busy = m_connections.size();
+        ++m_generation;
+    }
+    m_work_cv.notify_all();
+
+    drain(primary);
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_done_cv.wait(lock, [this] { return m_busy == 0; });
+    m_task = nullptr;
+    m_task_count = 0;
+}
+
+/**
+ * 工作线程函数
+ * 等待新一轮任务，在自己持有的上下文上领取执行，完成后通知调用方。
+ * @param ctx 本线程持有的上下文
+ * @param seen 线程创建时的任务轮次
+ */
+void ModbusConnectionPool::worker(modbus_t* ctx, uint64_t seen) {
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_work_cv.wait(lock, [this, seen] { return m_stop || m_generation != seen; });
+            if (m_stop) {
+                return;
+            }
+            seen = m_generation;
+        }
+
+        drain(ctx);
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            --m_busy;
+        }
+        m_done_cv.notify_all();
+    }
+}
+
+/**
+ * 在指定上下文上领取并执行任务，直到任务全部被领取
+ * @param ctx 执行任务的上下文
+ */
+void ModbusConnectionPool::drain(modbus_t* ctx) {
+    if (!ensure_alive(ctx)) {
+        return; // 连接不可用，任务留给其他上下文
+    }
+    size_t index;
+    while ((index = m_next_task++) < m_task_count) {
+        (*m_task)(ctx, index);
+    }
+}
+
+/**
+ * 为 Modbus TCP socket 设置 TCP_NODELAY 与 keepalive
+ * 关闭 Nagle 以避免小帧被延迟合并；keepalive 用于发现对端已消失的半开连接。
+ * @param socket 已连接的 socket
+ */
+void ModbusConnectionPool::tune_socket(int socket) {
+    if (socket < 0) {
+        return;
+    }
+    int on = 1;
+    setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+    setsockopt(socket, SOL_SOCKET, SO_KEEPALIVE, &on, sizeof(on));
+#ifdef TCP_KEEPIDLE
+    int idle = 10;     // 空闲 10 秒后开始探测
+    int interval = 5;  // 探测间隔 5 秒
+    int probes = 3;    // 3 次无应答判定断开
+    setsockopt(socket, IPPROTO_TCP, TCP_KEEPIDLE, &idle, sizeof(idle));
+    setsockopt(socket, IPPROTO_TCP, TCP_KEEPINTVL, &interval, sizeof(interval));
+    setsockopt(socket, IPPROTO_TCP, TCP_KEEPCNT, &probes, sizeof(probes));
+#endif
+}
+
+/**
+ * 检查上下文的连接是否仍然有效
+ * 请求之间 socket 上不应有可读数据：可读且读到 EOF 或错误说明对端已关闭或复位（半开），
+ * 此时重新建立连接；残留的迟到响应被清空。
+ * @param ctx libmodbus 上下文
+ * @return 连接可用返回 true
+ */
+bool ModbusConnectionPool::ensure_alive(modbus_t* ctx) {
+    int socket = modbus_get_socket(ctx);
+    bool alive = socket >= 0;
+
+    if (alive) {
+        struct pollfd pfd { socket, POLLIN, 0 };
+        if (::poll(&pfd, 1, 0) > 0) {
+            if (pfd.revents & (POLLERR | POLLHUP | POLLNVAL)) {
+                alive = false;
+            } else {
+                uint8_t probe;
+                ssize_t n = ::recv(socket, &probe, 1, MSG_PEEK | MSG_DONTWAIT);
+                if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK)) {
+                    alive = false;
+                } else {
+                    modbus_flush(ctx);
+                }
+            }
+        }
+    }
+
+    if (alive) {
+        return true;
+    }
+
+    modbus_close(ctx);
+    if (modbus_connect(ctx) == -1) {
+        return false;
+    }
+    tune_socket(modbus_get_socket(ctx));
+    return true;
+}
+
+} // namespace southbound
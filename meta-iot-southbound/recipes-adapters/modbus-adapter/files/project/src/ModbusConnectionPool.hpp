@@ -0,0 +1,92 @@
+#pragma once
+
+#include <modbus/modbus.h>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace southbound {
+
+/**
+ * @brief Modbus TCP 连接池
+ * 向同一网关额外建立若干 libmodbus 上下文，每个上下文由一个工作线程持有；
+ * run() 将一个扫描周期的块读任务分摊到调用方的主上下文与池中各上下文并行执行。
+ */
+class ModbusConnectionPool {
+public:
+    // 任务函数：在给定上下文上执行第 index 个任务
+    using Task = std::function<void(modbus_t* ctx, size_t index)>;
+
+    ModbusConnectionPool() = default;
+    ~ModbusConnectionPool();
+
+    ModbusConnectionPool(const ModbusConnectionPool&) = delete;
+    ModbusConnectionPool& operator=(const ModbusConnectionPool&) = delete;
+
+    /**
+     * @brief 建立额外连接并启动工作线程
+     * @param ip_address 网关地址
+     * @param port 网关端口
+     * @param count 额外连接数
+     * @param reference 主上下文，用于复制响应超时
+     * @return 成功建立的连接数
+     */
+    size_t open(const std::string& ip_address, int port, int count, modbus_t* reference);
+
+    /**
+     * @brief 停止工作线程并关闭全部额外连接
+     */
+    void close();
+
+    /**
+     * @brief 额外连接数（不含主上下文）
+     */
+    size_t size() const { return m_connections.size(); }
+
+    /**
+     * @brief 在主上下文与池中各上下文上并行执行任务，全部完成后返回
+     * @param primary 调用方持有的主上下文，调用线程在其上参与执行
+     * @param task_count 任务数量
+     * @param task 任务函数
+     */
+    void run(modbus_t* primary, size_t task_count, const Task& task);
+
+    /**
+     * @brief 为 Modbus TCP socket 设置 TCP_NODELAY 与 keepalive
+     */
+    static void tune_socket(int socket);
+
+    /**
+     * @brief 检查上下文的连接是否仍然有效，对端已关闭（半开）时重新连接
+     * @return 连接可用返回 true
+     */
+    static bool ensure_alive(modbus_t* ctx);
+
+private:
+    struct Connection {
+        std::unique_ptr<modbus_t, void(*)(modbus_t*)> ctx{nullptr, modbus_free};
+        std::thread thread;
+    };
+
+    std::vector<std::unique_ptr<Connection>> m_connections;
+    std::mutex m_mutex;
+    std::condition_variable m_work_cv;
+    std::condition_variable m_done_cv;
+    const Task* m_task{nullptr};
+    size_t m_task_count{0};
+    std::atomic<size_t> m_next_task{0};
+    size_t m_busy{0};
+    uint64_t m_generation{0};
+    bool m_stop{false};
+
+    void worker(modbus_t* ctx, uint64_t seen);
+    void drain(modbus_t* ctx);
+};
+
+} // namespace southbound
@@ -0,0 +1,551 @@
+#include "ModbusRtuTransport.hpp"
+#include <modbus/modbus.h>
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <linux/serial.h>
+#include <sys/epoll.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <unistd.h>
+
+namespace southbound {
+
+namespace {
+
+/**
+ * 生成 CRC16 查找表（反射多项式 0xA001）
+ */
+constexpr std::array<uint16_t, 256> make_crc_table() {
+    std::array<uint16_t, 256> table{};
+    for (uint16_t i = 0; i < 256; ++i) {
+        uint16_t crc = i;
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 1) ? static_cast<uint16_t>((crc >> 1) ^ 0xA001) : static_cast<uint16_t>(crc >> 1);
+        }
+        table[i] = crc;
+    }
+    return table;
+}
+
+constexpr std::array<uint16_t, 256> CRC_TABLE = make_crc_table();
+
+/**
+ * 波特率转换为 termios 常量
+ * @return 不支持的波特率返回 B0
+ */
+speed_t baud_constant(int baudrate) {
+    switch (baudrate) {
+        case 1200: return B1200;
+        case 2400: return B2400;
+        case 4800: return B4800;
+        case 9600: return B9600;
+        case 19200: return B19200;
+        case 38400: return B38400;
+        case 57600: return B57600;
+        case 115200: return B115200;
+        case 230400: return B230400;
+#ifdef B460800
+        case 460800: return B460800;
+#endif
+#ifdef B921600
+        case 921600: return B921600;
+#endif
+        default: return B0;
+    }
+}
+
+inline void put16(uint8_t* p, int value) {
+    p[0] = static_cast<uint8_t>((value >> 8) & 0xFF);
+    p[1] = static_cast<uint8_t>(value & 0xFF);
+}
+
+inline uint16_t get16(const uint8_t* p) {
+    return static_cast<uint16_t>((p[0] << 8) | p[1]);
+}
+
+} // namespace
+
+ModbusRtuTransport::~ModbusRtuTransport() {
+    close();
+}
+
+/**
+ * 打开并配置串口
+ * 原始模式、非阻塞、忽略调制解调器控制线；驱动支持时开启 ASYNC_LOW_LATENCY，
+ * 避免 USB 串口等驱动按默认延迟成批上报接收数据。
+ * @return 0 成功；-1 失败
+ */
+int ModbusRtuTransport::open(const std::string& device_path, int baudrate, char parity, int data_bits, int stop_bits) {
+    close();
+
+    speed_t speed = baud_constant(baudrate);
+    if (speed == B0 || data_bits < 5 || data_bits > 8 || (stop_bits != 1 && stop_bits != 2)) {
+        errno = EINVAL;
+        return -1;
+    }
+
+    m_fd = ::open(device_path.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    if (m_fd < 0) {
+        return -1;
+    }
+
+    struct termios tios;
+    std::memset(&tios, 0, sizeof(tios));
+    cfmakeraw(&tios);
+    cfsetispeed(&tios, speed);
+    cfsetospeed(&tios, speed);
+    tios.c_cflag |= CREAD | CLOCAL;
+    tios.c_cflag &= ~(CSIZE | PARENB | PARODD | CSTOPB);
+    switch (data_bits) {
+        case 5: tios.c_cflag |= CS5; break;
+        case 6: tios.c_cflag |= CS6; break;
+        case 7: tios.c_cflag |= CS7; break;
+        default: tios.c_cflag |= CS8; break;
+    }
+    if (stop_bits == 2) {
+        tios.c_cflag |= CSTOPB;
+    }
+    if (parity == 'E') {
+        tios.c_cflag |= PARENB;
+    } else if (parity == 'O') {
+        tios.c_cflag |= PARENB | PARODD;
+    }
+    tios.c_cc[VMIN] = 0;
+    tios.c_cc[VTIME] = 0;
+
+    if (tcsetattr(m_fd, TCSANOW, &tios) == -1) {
+        int error = errno;
+        close();
+        errno = error;
+        return -1;
+    }
+
+    struct serial_struct serial;
+    if (ioctl(m_fd, TIOCGSERIAL, &serial) == 0) {
+        serial.flags |= ASYNC_LOW_LATENCY;
+        ioctl(m_fd, TIOCSSERIAL, &serial); // 不支持时保持默认
+    }
+
+    m_epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+    struct epoll_event event;
+    std::memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.fd = m_fd;
+    if (m_epoll_fd < 0 || epoll_ctl(m_epoll_fd, EPOLL_CTL_ADD, m_fd, &event) == -1) {
+        int error = errno;
+        close();
+        errno = error;
+        return -1;
+    }
+
+    int64_t bits_per_char = 1 + data_bits + (parity == 'N' ? 0 : 1) + stop_bits;
+    m_char_time = std::chrono::microseconds(bits_per_char * 1000000 / baudrate + 1);
+    m_frame_gap = baudrate > 19200 ? std::chrono::microseconds(1750)
+                                   : std::chrono::microseconds(bits_per_char * 3500000 / baudrate);
+
+    tcflush(m_fd, TCIOFLUSH);
+    return 0;
+}
+
+/**
+ * 关闭串口
+ */
+void ModbusRtuTransport::close() {
+    if (m_epoll_fd >= 0) {
+        ::close(m_epoll_fd);
+        m_epoll_fd = -1;
+    }
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+}
+
+/**
+ * 丢弃接收缓冲中的残留数据
+ */
+void ModbusRtuTransport::flush() {
+    if (m_fd >= 0) {
+        tcflush(m_fd, TCIFLUSH);
+    }
+}
+
+/**
+ * 计算 Modbus CRC16
+ * @param data 数据
+ * @param length 长度
+ * @return CRC（低字节先发送）
+ */
+uint16_t ModbusRtuTransport::crc16(const uint8_t* data, size_t length) {
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < length; ++i) {
+        crc = static_cast<uint16_t>((crc >> 8) ^ CRC_TABLE[(crc ^ data[i]) & 0xFF]);
+    }
+    return crc;
+}
+
+/**
+ * 等待串口可读
+ * @param timeout 超时
+ * @return 1 可读；0 超时；-1 错误
+ */
+int ModbusRtuTransport::wait_readable(std::chrono::microseconds timeout) {
+    // epoll_wait 以毫秒计，向上取整以免提前判定超时
+    int timeout_ms = static_cast<int>((timeout.count() + 999) / 1000);
+    struct epoll_event event;
+    for (;;) {
+        int n = epoll_wait(m_epoll_fd, &event, 1, timeout_ms);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        return n;
+    }
+}
+
+/**
+ * 发送一帧
+ * 返回前等待帧全部移出 UART，随后的响应超时才从请求发送完毕开始计时。
+ * @return 0 成功；-1 失败
+ */
+int ModbusRtuTransport::send_frame(const uint8_t* frame, size_t length) {
+    size_t sent = 0;
+    while (sent < length) {
+        ssize_t n = ::write(m_fd, frame + sent, length - sent);
+        if (n < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                tcdrain(m_fd);
+                continue;
+            }
+            return -1;
+        }
+        sent += static_cast<size_t>(n);
+    }
+    while (tcdrain(m_fd) == -1) {
+        if (errno != EINTR) {
+            return -1;
+        }
+    }
+    return 0;
+}
+
+/**
+ * 接收一帧
+ * 第一个字节在响应超时（加上预期帧长的传输时间）内到达；此后字符间隔超过 3.5 个字符时间即视为帧结束。
+ * 收到功能码后若为异常应答，预期长度改为 5 字节。
+ * @param frame 接收缓冲（至少 MODBUS_RTU_MAX_ADU_LENGTH）
+ * @param expected 正常应答的 ADU 长度
+ * @param received 输出实际接收的字节数
+ * @return 0 收到完整帧；-1 超时或错误（errno）
+ */
+int ModbusRtuTransport::receive_frame(uint8_t* frame, size_t expected, size_t& received) {
+    received = 0;
+    std::chrono::microseconds wait = m_response_timeout + m_char_time * static_cast<int64_t>(expected);
+
+    while (received < expected) {
+        int ready = wait_readable(wait);
+        if (ready < 0) {
+            return -1;
+        }
+        if (ready == 0) {
+            errno = received == 0 ? ETIMEDOUT : EMBBADDATA;
+            return -1;
+        }
+
+        ssize_t n = ::read(m_fd, frame + received, MODBUS_RTU_MAX_ADU_LENGTH - received);
+        if (n < 0) {
+            if (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK) {
+                continue;
+            }
+            return -1;
+        }
+        if (n == 0) {
+            errno = EIO; // 设备已移除
+            return -1;
+        }
+        received += static_cast<size_t>(n);
+
+        if (received >= 2 && (frame[1] & 0x80)) {
+            expected = 5;
+        }
+        // 后续字节应连续到达：等待剩余字节的传输时间加帧间隔
+        wait = m_frame_gap + m_char_time * static_cast<int64_t>(expected > received ? expected - received : 0);
+    }
+    return 0;
+}
+
+/**
+ * 执行一次事务
+ * @param slave 从站地址；0 为广播，不等待应答
+ * @param pdu 请求 PDU（功能码起）
+ * @param pdu_length 请求 PDU 长度
+ * @param response_length 正常应答的 PDU 长度
+ * @param response 输出应答 PDU
+ * @return 0 成功；-1 失败（errno）
+ */
+int ModbusRtuTransport::transact(int slave, const uint8_t* pdu, size_t pdu_length, size_t response_length,
+                                 uint8_t* response) {
+    if (m_fd < 0) {
+        errno = EBADF;
+        return -1;
+    }
+
+    uint8_t frame[MODBUS_RTU_MAX_ADU_LENGTH];
+    frame[0] = static_cast<uint8_t>(slave);
+    std::memcpy(frame + 1, pdu, pdu_length);
+    uint16_t crc = crc16(frame, pdu_length + 1);
+    frame[pdu_length + 1] = static_cast<uint8_t>(crc & 0xFF);
+    frame[pdu_length + 2] = static_cast<uint8_t>(crc >> 8);
+
+    tcflush(m_fd, TCIFLUSH); // 丢弃上一事务的迟到应答
+    if (send_frame(frame, pdu_length + 3) == -1) {
+        return -1;
+    }
+    if (slave == MODBUS_BROADCAST_ADDRESS) {
+        return 0;
+    }
+
+    size_t received = 0;
+    if (receive_frame(frame, response_length + 3, received) == -1) {
+        return -1;
+    }
+
+    uint16_t expected_crc = crc16(frame, received - 2);
+    if (frame[received - 2] != (expected_crc & 0xFF) || frame[received - 1] != (expected_crc >> 8)) {
+        errno = EMBBADCRC;
+        return -1;
+    }
+    if (frame[0] != slave) {
+        errno = EMBBADDATA;
+        return -1;
+    }
+    if (frame[1] == (pdu[0] | 0x80)) {
+        errno = MODBUS_ENOBASE + frame[2];
+        return -1;
+    }
+    if (frame[1] != pdu[0] || received != response_length + 3) {
+        errno = EMBBADDATA;
+        return -1;
+    }
+
+    std::memcpy(response, frame + 1, response_length);
+    return 0;
+}
+
+/**
+ * 读线圈（FC1）或离散输入（FC2）
+ * @return 读到的位数；失败返回 -1
+ */
+int ModbusRtuTransport::read_bits(int slave, int function_code, int address, int count, uint8_t* dest) {
+    if (count < 1 || count > MODBUS_MAX_READ_BITS) {
+        errno = EMBMDATA;
+        return -1;
+    }
+    uint8_t request[5] = { static_cast<uint8_t>(function_code) };
+    put16(request + 1, address);
+    put16(request + 3, count);
+
+    uint8_t response[MODBUS_MAX_PDU_LENGTH];
+    size_t bytes = static_cast<size_t>((count + 7) / 8);
+    if (transact(slave, request, sizeof(request), 2 + bytes, response) == -1) {
+        return -1;
+    }
+    if (response[1] != bytes) {
+        errno = EMBBADDATA;
+        return -1;
+    }
+    for (int i = 0; i < count; ++i) {
+        dest[i] = (response[2 + i / 8] >> (i % 8)) & 0x01;
+    }
+    return count;
+}
+
+/**
+ * 读保持寄存器（FC3）或输入寄存器（FC4）
+ * @return 读到的寄存器数；失败返回 -1
+ */
+int ModbusRtuTransport::read_registers(int slave, int function_code, int address, int count, uint16_t* dest) {
+    if (count < 1 || count > MODBUS_MAX_READ_REGISTERS) {
+        errno = EMBMDATA;
+        return -1;
+    }
+    uint8_t request[5] = { static_cast<uint8_t>(function_code) };
+    put16(request + 1, address);
+    put16(request + 3, count);
+
+    uint8_t response[MODBUS_MAX_PDU_LENGTH];
+    if (transact(slave, request, sizeof(request), 2 + 2 * static_cast<size_t>(count), response) == -1) {
+        return -1;
+    }
+    if (response[1] != 2 * count) {
+        errno = EMBBADDATA;
+        return -1;
+    }
+    for (int i = 0; i < count; ++i) {
+        dest[i] = get16(response + 2 + 2 * i);
+    }
+    return count;
+}
+
+/**
+ * 写单个线圈（FC5）
+ * @return 1 成功；失败返回 -1
+ */
+int ModbusRtuTransport::write_bit(int slave, int address, int status) {
+    uint8_t request[5] = { 5 };
+    put16(request + 1, address);
+    put16(request + 3, status ? 0xFF00 : 0x0000);
+
+    uint8_t response[5];
+    if (transact(slave, request, sizeof(request), sizeof(response), response) == -1) {
+        return -1;
+    }
+    if (slave != MODBUS_BROADCAST_ADDRESS && std::memcmp(request, response, sizeof(request)) != 0) {
+        errno = EMBBADDATA;
+        return -1;
+    }
+    return 1;
+}
+
+/**
+ * 写单个寄存器（FC6）
+ * @return 1 成功；失败返回 -1
+ */
+int ModbusRtuTransport::write_register(int slave, int address, uint16_t value) {
+    uint8_t request[5] = { 6 };
+    put16(request + 1, address);
+    put16(request + 3, value);
+
+    uint8_t response[5];
+    if (transact(slave, request, sizeof(request), sizeof(response), response) == -1) {
+        return -1;
+    }
+    if (slave != MODBUS_BROADCAST_ADDRESS && std::memcmp(request, response, sizeof(request)) != 0) {
+        errno = EMBBADDATA;
+        return -1;
+    }
+    return 1;
+}
+
+/**
+ * 写多个线圈（FC15）
+ * @return 写入的位数；失败返回 -1
+ */
+int ModbusRtuTransport::write_bits(int slave, int address, int count, const uint8_t* src) {
+    if (count < 1 || count > MODBUS_MAX_WRITE_BITS) {
+        errno = EMBMDATA;
+        return -1;
+    }
+    uint8_t request[MODBUS_MAX_PDU_LENGTH] = { 15 };
+    int bytes = (count + 7) / 8;
+    put16(request + 1, address);
+    put16(request + 3, count);
+    request[5] = static_cast<uint8_t>(bytes);
+    std::memset(request + 6, 0, static_cast<size_t>(bytes));
+    for (int i = 0; i < count; ++i) {
+        if (src[i]) {
+            request[6 + i / 8] |= static_cast<uint8_t>(1u << (i % 8));
+        }
+    }
+
+    uint8_t response[5];
+    if (transact(slave, request, 6 + static_cast<size_t>(bytes), sizeof(response), response) == -1) {
+        return -1;
+    }
+    if (slave != MODBUS_BROADCAST_ADDRESS && std::memcmp(request, response, sizeof(response)) != 0) {
+        errno = EMBBADDATA;
+        return -1;
+    }
+    return count;
+}
+
+/**
+ * 写多个寄存器（FC16）
+ * @return 写入的寄存器数；失败返回 -1
+ */
+int ModbusRtuTransport::write_registers(int slave, int address, int count, const uint16_t* src) {
+    if (count < 1 || count > MODBUS_MAX_WRITE_REGISTERS) {
+        errno = EMBMDATA;
+        return -1;
+    }
+    uint8_t request[MODBUS_MAX_PDU_LENGTH] = { 16 };
+    put16(request + 1, address);
+    put16(request + 3, count);
+    request[5] = static_cast<uint8_t>(count * 2);
+    for (int i = 0; i < count; ++i) {
+        put16(request + 6 + 2 * i, src[i]);
+    }
+
+    uint8_t response[5];
+    if (transact(slave, request, 6 + 2 * static_cast<size_t>(count), sizeof(response), response) == -1) {
+        return -1;
+    }
+    if (slave != MODBUS_BROADCAST_ADDRESS && std::memcmp(request, response, sizeof(response)) != 0) {
+        errno = EMBBADDATA;
+        return -1;
+    }
+    return count;
+}
+
+/**
+ * 掩码写寄存器（FC22）
+ * @return 1 成功；失败返回 -1
+ */
+int ModbusRtuTransport::mask_write_register(int slave, int address, uint16_t and_mask, uint16_t or_mask) {
+    uint8_t request[7] = { 22 };
+    put16(request + 1, address);
+    put16(request + 3, and_mask);
+    put16(request + 5, or_mask);
+
+    uint8_t response[7];
+    if (transact(slave, request, sizeof(request), sizeof(response), response) == -1) {
+        return -1;
+    }
+    if (slave != MODBUS_BROADCAST_ADDRESS && std::memcmp(request, response, sizeof(request)) != 0) {
+        errno = EMBBADDATA;
+        return -1;
+    }
+    return 1;
+}
+
+/**
+ * 写并读多个寄存器（FC23）
+ * @return 读到的寄存器数；失败返回 -1
+ */
+int ModbusRtuTransport::write_and_read_registers(int slave, int write_address, int write_count, const uint16_t* src,
+                                                 int read_address, int read_count, uint16_t* dest) {
+    if (write_count < 1 || write_count > MODBUS_MAX_WR_WRITE_REGISTERS
+        || read_count < 1 || read_count > MODBUS_MAX_WR_READ_REGISTERS) {
+        errno = EMBMDATA;
+        return -1;
+    }
+    uint8_t request[MODBUS_MAX_PDU_LENGTH] = { 23 };
+    put16(request + 1, read_address);
+    put16(request + 3, read_count);
+    put16(request + 5, write_address);
+    put16(request + 7, write_count);
+    request[9] = static_cast<uint8_t>(write_count * 2);
+    for (int i = 0; i < write_count; ++i) {
+        put16(request + 10 + 2 * i, src[i]);
+    }
+
+    uint8_t response[MODBUS_MAX_PDU_LENGTH];
+    if (transact(slave, request, 10 + 2 * static_cast<size_t>(write_count),
+                 2 + 2 * static_cast<size_t>(read_count), response) == -1) {
+        return -1;
+    }
+    if (response[1] != 2 * read_count) {
+        errno = EMBBADDATA;
+        return -1;
+    }
+    for (int i = 0; i < read_count; ++i) {
+        dest[i] = get16(response + 2 + 2 * i);
+    }
+    return read_count;
+}
+
+} // namespace southbound
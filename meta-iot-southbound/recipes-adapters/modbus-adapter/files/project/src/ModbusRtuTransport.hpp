@@ -0,0 +1,88 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace southbound {
+
+/**
+ * @brief 原生 Modbus RTU 传输
+ * 直接以 termios 配置串口（原始模式、非阻塞，尽可能开启 ASYNC_LOW_LATENCY），
+ * 以查表法计算 CRC16，并由 epoll 驱动接收：按功能码预知应答长度，收齐即返回，
+ * 字符间隔超过 3.5 个字符时间视为帧结束。
+ * 接口语义与 libmodbus 对应函数一致：成功返回数量，失败返回 -1 并设置 libmodbus 兼容的 errno
+ * （ETIMEDOUT、EMBBADCRC、EMBBADDATA、MODBUS_ENOBASE + 异常码）。
+ * 不做线程同步，由 RtuBus 保证同一时刻只有一个事务。
+ */
+class ModbusRtuTransport {
+public:
+    ModbusRtuTransport() = default;
+    ~ModbusRtuTransport();
+
+    ModbusRtuTransport(const ModbusRtuTransport&) = delete;
+    ModbusRtuTransport& operator=(const ModbusRtuTransport&) = delete;
+
+    /**
+     * @brief 打开并配置串口
+     * @param device_path 串口设备路径
+     * @param baudrate 波特率
+     * @param parity 校验位 N/E/O
+     * @param data_bits 数据位 5..8
+     * @param stop_bits 停止位 1/2
+     * @return 0 成功；-1 失败（errno 为系统错误码）
+     */
+    int open(const std::string& device_path, int baudrate, char parity, int data_bits, int stop_bits);
+
+    /**
+     * @brief 关闭串口
+     */
+    void close();
+
+    bool is_open() const { return m_fd >= 0; }
+
+    /**
+     * @brief 设置响应超时（自请求发送完毕起至应答第一个字节）
+     */
+    void set_response_timeout(std::chrono::microseconds timeout) { m_response_timeout = timeout; }
+
+    /**
+     * @brief 丢弃接收缓冲中的残留数据
+     */
+    void flush();
+
+    /**
+     * @brief 3.5 个字符时间（波特率高于 19200 时固定为 1750 微秒）
+     */
+    std::chrono::microseconds frame_gap() const { return m_frame_gap; }
+
+    int read_bits(int slave, int function_code, int address, int count, uint8_t* dest);
+    int read_registers(int slave, int function_code, int address, int count, uint16_t* dest);
+    int write_bit(int slave, int address, int status);
+    int write_register(int slave, int address, uint16_t value);
+    int write_bits(int slave, int address, int count, const uint8_t* src);
+    int write_registers(int slave, int address, int count, const uint16_t* src);
+    int mask_write_register(int slave, int address, uint16_t and_mask, uint16_t or_mask);
+    int write_and_read_registers(int slave, int write_address, int write_count, const uint16_t* src,
+                                 int read_address, int read_count, uint16_t* dest);
+
+    /**
+     * @brief 计算 Modbus CRC16（多项式 0xA001，查表法）
+     */
+    static uint16_t crc16(const uint8_t* data, size_t length);
+
+private:
+    int m_fd{-1};
+    int m_epoll_fd{-1};
+    std::chrono::microseconds m_response_timeout{1000000};
+    std::chrono::microseconds m_frame_gap{1750};
+    std::chrono::microseconds m_char_time{87};
+
+    int transact(int slave, const uint8_t* pdu, size_t pdu_length, size_t response_length, uint8_t* response);
+    int send_frame(const uint8_t* frame, size_t length);
+    int receive_frame(uint8_t* frame, size_t expected, size_t& received);
+    int wait_readable(std::chrono::microseconds timeout);
+};
+
+} // namespace southbound
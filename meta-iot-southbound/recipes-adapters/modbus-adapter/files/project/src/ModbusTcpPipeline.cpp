@@ -0,0 +1,240 @@
+#include "ModbusTcpPipeline.hpp"
+#include <modbus/modbus.h>
+#include <algorithm>
+#include <cerrno>
+#include <poll.h>
+#include <sys/socket.h>
+
+namespace southbound {
+
+namespace {
+
+constexpr size_t MBAP_HEADER_LENGTH = 7;
+
+} // namespace
+
+/**
+ * 构造函数
+ * @param depth 最大在途事务数
+ */
+ModbusTcpPipeline::ModbusTcpPipeline(int depth) {
+    set_depth(depth);
+    m_rx_buffer.reserve(MODBUS_TCP_MAX_ADU_LENGTH * 4);
+    m_in_flight.reserve(64); // 深度上限，执行中不再扩容
+}
+
+/**
+ * 设置配置的最大在途事务数
+ * @param depth 在途事务数，限制在 1..64
+ */
+void ModbusTcpPipeline::set_depth(int depth) {
+    m_depth = std::clamp(depth, 1, 64);
+    m_effective_depth = m_depth;
+}
+
+/**
+ * 发送一条读请求（MBAP 头 + PDU）
+ * @param socket 已连接的 socket
+ * @param request 读请求
+ * @param transaction_id MBAP 事务号
+ * @return 发送成功返回 true
+ */
+bool ModbusTcpPipeline::send_request(int socket, PipelineRequest& request, uint16_t transaction_id) {
+    uint8_t frame[12] = {
+        static_cast<uint8_t>(transaction_id >> 8), static_cast<uint8_t>(transaction_id & 0xFF),
+        0, 0,       // 协议标识
+        0, 6,       // 后续长度：单元标识 + 5 字节 PDU
+        request.slave_id,
+        request.function_code,
+        static_cast<uint8_t>(request.address >> 8), static_cast<uint8_t>(request.address & 0xFF),
+        static_cast<uint8_t>(request.count >> 8), static_cast<uint8_t>(request.count & 0xFF),
+    };
+
+    size_t sent = 0;
+    while (sent < sizeof(frame)) {
+        ssize_t n = ::send(socket, frame + sent, sizeof(frame) - sent, MSG_NOSIGNAL);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            request.error = errno;
+            return false;
+        }
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+/**
+ * 解析响应 PDU 并写回请求
+ * @param request 对应的读请求
+ * @param pdu 响应 PDU（功能码起）
+ * @param length PDU 长度
+ * @return 成功返回 true
+ */
+bool ModbusTcpPipeline::complete(PipelineRequest& request, const uint8_t* pdu, size_t length) {
+    if (length >= 2 && pdu[0] == (request.function_code | 0x80)) {
+        request.error = MODBUS_ENOBASE + pdu[1];
+        return false;
+    }
+
+    const bool bits = request.function_code == 1 || request.function_code == 2;
+    const size_t expected = bits ? (request.count + 7u) / 8u : request.count * 2u;
+    if (length < 2 || pdu[0] != request.function_code || pdu[1] != expected || length != expected + 2) {
+        request.error = EMBBADDATA;
+        return false;
+    }
+
+    const uint8_t* data = pdu + 2;
+    if (bits) {
+        for (uint16_t i = 0; i < request.count; ++i) {
+            request.bits[i] = (data[i / 8] >> (i % 8)) & 0x01;
+        }
+    } else {
+        for (uint16_t i = 0; i < request.count; ++i) {
+            request.registers[i] = static_cast<uint16_t>((data[2 * i] << 8) | data[2 * i + 1]);
+        }
+    }
+
+    request.result = request.count;
+    return true;
+}
+
+/**
+ * 在 socket 上执行一批读请求
+ * 保持至多 depth 个事务在途，每收到一个响应立即补发下一个请求。响应按 MBAP 事务号匹配，
+ * 未知事务号（如已超时事务的迟到响应）被丢弃，单元标识与请求不符的响应使该请求以 EMBBADDATA 失败。若在途多于一个事务时出现超时或连接错误，
+ * 视为设备不支持流水线，后续退回深度 1。
+ * @param socket 已连接的 TCP socket
+ * @param requests 请求列表
+ * @return 全部成功返回 true
+ */
+bool ModbusTcpPipeline::execute(int socket, std::vector<PipelineRequest>& requests) {
+    using clock = std::chrono::steady_clock;
+
+    std::vector<InFlight>& in_flight = m_in_flight;
+    in_flight.clear();
+    size_t next = 0;
+    bool all_ok = true;
+    bool link_error = false;
+    int link_errno = 0;         // 链路错误的错误码，在出错处记录，不依赖之后可能被改写的 errno
+    m_had_timeout = false;
+    m_rx_buffer.clear();
+
+    for (auto& request : requests) {
+        request.result = -1;
+        request.error = 0;
+    }
+
+    while (next < requests.size() || !in_flight.empty()) {
+        // 补足在途事务
+        while (!link_error && next < requests.size() && in_flight.size() < static_cast<size_t>(m_effective_depth)) {
+            uint16_t transaction_id = m_next_transaction_id++;
+            if (!send_request(socket, requests[next], transaction_id)) {
+                link_error = true;
+                link_errno = requests[next].error;
+                break;
+            }
+            in_flight.push_back(InFlight{next, transaction_id, clock::now() + m_timeout});
+            ++next;
+        }
+
+        if (link_error) {
+            break;
+        }
+
+        // 等待最近的截止时间
+        auto earliest = std::min_element(in_flight.begin(), in_flight.end(),
+            [](const InFlight& a, const InFlight& b) { return a.deadline < b.deadline; })->deadline;
+        auto wait = std::chrono::duration_cast<std::chrono::milliseconds>(earliest - clock::now());
+        int wait_ms = static_cast<int>(std::max<long long>(wait.count(), 0));
+
+        struct pollfd pfd { socket, POLLIN, 0 };
+        int ready = ::poll(&pfd, 1, wait_ms);
+        if (ready < 0 && errno != EINTR) {
+            link_error = true;
+            link_errno = errno;
+            break;
+        }
+
+        if (ready > 0) {
+            uint8_t chunk[MODBUS_TCP_MAX_ADU_LENGTH * 4];
+            ssize_t n = ::recv(socket, chunk, sizeof(chunk), MSG_DONTWAIT);
+            if (n == 0 || (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+                link_error = true;
+                link_errno = n == 0 ? ECONNRESET : errno;
+                break;
+            }
+            if (n > 0) {
+                m_rx_buffer.insert(m_rx_buffer.end(), chunk, chunk + n);
+            }
+
+            // 拆出完整的 ADU
+            size_t offset = 0;
+            while (m_rx_buffer.size() - offset >= MBAP_HEADER_LENGTH) {
+                const uint8_t* header = m_rx_buffer.data() + offset;
+                size_t length = (static_cast<size_t>(header[4]) << 8) | header[5];
+                if (length < 2 || length > MODBUS_TCP_MAX_ADU_LENGTH) {
+                    link_error = true; // 帧错位，无法恢复
+                    link_errno = EMBBADDATA;
+                    break;
+                }
+                if (m_rx_buffer.size() - offset < 6 + length) {
+                    break;
+                }
+
+                uint16_t transaction_id = static_cast<uint16_t>((header[0] << 8) | header[1]);
+                auto it = std::find_if(in_flight.begin(), in_flight.end(),
+                    [transaction_id](const InFlight& f) { return f.transaction_id == transaction_id; });
+                if (it != in_flight.end()) {
+                    PipelineRequest& request = requests[it->index];
+                    if (header[6] != request.slave_id) {
+                        request.error = EMBBADDATA; // 事务号对上而单元标识不符：不是本请求的应答
+                        all_ok = false;
+                    } else {
+                        all_ok = complete(request, header + MBAP_HEADER_LENGTH, length - 1) && all_ok;
+                    }
+                    in_flight.erase(it);
+                }
+                offset += 6 + length;
+            }
+            m_rx_buffer.erase(m_rx_buffer.begin(), m_rx_buffer.begin() + offset);
+            if (link_error) {
+                break;
+            }
+        }
+
+        // 处理超时事务
+        auto now = clock::now();
+        for (auto it = in_flight.begin(); it != in_flight.end();) {
+            if (it->deadline <= now) {
+                requests[it->index].error = ETIMEDOUT;
+                all_ok = false;
+                m_had_timeout = true;
+                if (in_flight.size() > 1) {
+                    m_effective_depth = 1;
+                }
+                it = in_flight.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+
+    if (link_error) {
+        if (in_flight.size() > 1) {
+            m_effective_depth = 1;
+        }
+        int error = link_errno ? link_errno : ECONNRESET;
+        for (const auto& f : in_flight) {
+            requests[f.index].error = error;
+        }
+        for (; next < requests.size(); ++next) {
+            requests[next].error = error;
+        }
+        m_had_timeout = true;
+        all_ok = false;
+    }
+
+    return all_ok;
+}
+
+} // namespace southbound
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace southbound {
+
+/**
+ * @brief 流水线中的一次读请求
+ */
+struct PipelineRequest {
+    uint8_t slave_id{1};
+    uint8_t function_code{3};  // 读功能码 1/2/3/4
+    uint16_t address{0};
+    uint16_t count{0};
+    uint16_t* registers{nullptr}; // FC3/FC4 输出缓冲，至少 count 个
+    uint8_t* bits{nullptr};       // FC1/FC2 输出缓冲，至少 count 个（每位一字节）
+    int result{-1};               // 成功为 count，失败为 -1
+    int error{0};                 // 失败时的错误码（libmodbus 兼容，如 EMBXILADD、ETIMEDOUT）
+};
+
+/**
+ * @brief 原生 Modbus TCP 流水线引擎
+ * 在同一 socket 上保持多个未完成事务，按 MBAP 事务号匹配响应，每个事务独立超时。
+ * 不拥有 socket：连接的建立与关闭仍由 libmodbus 上下文负责。
+ */
+class ModbusTcpPipeline {
+public:
+    explicit ModbusTcpPipeline(int depth = 1);
+
+    /**
+     * @brief 设置配置的最大在途事务数
+     */
+    void set_depth(int depth);
+
+    /**
+     * @brief 当前生效的在途事务数（设备不支持流水线时会退回 1）
+     */
+    int depth() const { return m_effective_depth; }
+
+    /**
+     * @brief 恢复为配置的在途事务数（重新连接后调用）
+     */
+    void reset() { m_effective_depth = m_depth; }
+
+    /**
+     * @brief 设置单个事务的响应超时
+     */
+    void set_response_timeout(std::chrono::milliseconds timeout) { m_timeout = timeout; }
+
+    /**
+     * @brief 在 socket 上执行一批读请求
+     * @param socket 已连接的 TCP socket
+     * @param requests 请求列表，结果写回各请求的 result/error
+     * @return 全部成功返回 true；存在失败返回 false
+     */
+    bool execute(int socket, std::vector<PipelineRequest>& requests);
+
+    /**
+     * @brief 最近一次执行是否发生了超时或连接错误
+     * 超时后迟到的响应可能仍在 socket 中，调用方应在复用 socket 前清空接收缓冲。
+     */
+    bool had_timeout() const { return m_had_timeout; }
+
+private:
+    struct InFlight {
+        size_t index;       // requests 中的下标
+        uint16_t transaction_id;
+        std::chrono::steady_clock::time_point deadline;
+    };
+
+    int m_depth;
+    int m_effective_depth;
+    std::chrono::milliseconds m_timeout{1000};
+    uint16_t m_next_transaction_id{0};
+    bool m_had_timeout{false};
+    std::vector<uint8_t> m_rx_buffer;
+    std::vector<InFlight> m_in_flight; // 在途事务，跨批次复用
+
+    bool send_request(int socket, PipelineRequest& request, uint16_t transaction_id);
+    bool complete(PipelineRequest& request, const uint8_t* pdu, size_t length);
+};
+
+} // namespace southbound
@@ -0,0 +1,44 @@
+#include "ReconnectBackoff.hpp"
+#include <algorithm>
+
+namespace southbound {
+
+/**
+ * 构造函数
+ * 每个实例独立播种，同一进程内的多个适配器得到不同的抖动序列。
+ */
+ReconnectBackoff::ReconnectBackoff()
+    : m_rng(std::random_device{}()) {
+}
+
+/**
+ * 设置退避范围并重置
+ * @param min_delay 最短等待
+ * @param max_delay 最长等待
+ */
+void ReconnectBackoff::configure(std::chrono::milliseconds min_delay, std::chrono::milliseconds max_delay) {
+    m_min_delay = std::max(min_delay, std::chrono::milliseconds(1));
+    m_max_delay = std::max(max_delay, m_min_delay);
+    reset();
+}
+
+/**
+ * 连接成功后重置退避
+ */
+void ReconnectBackoff::reset() {
+    m_previous = m_min_delay;
+}
+
+/**
+ * 下一次重连前的等待时间
+ * @return 在 [min_delay, min(max_delay, 上次 × 3)] 内均匀随机
+ */
+std::chrono::milliseconds ReconnectBackoff::next() {
+    int64_t low = m_min_delay.count();
+    int64_t high = std::min<int64_t>(m_max_delay.count(), m_previous.count() * 3);
+    std::uniform_int_distribution<int64_t> distribution(low, std::max(low, high));
+    m_previous = std::chrono::milliseconds(distribution(m_rng));
+    return m_previous;
+}
+
+} // namespace southbound
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <random>
+
+namespace southbound {
+
+/**
+ * @brief 带抖动的指数退避（decorrelated jitter）
+ * 每次等待时间在 [min_delay, 上次等待 × 3] 内随机选取并以 max_delay 封顶；
+ * 大量设备同时掉线时各自的重连时刻被随机打散，避免同时冲击网络与网关。
+ */
+class ReconnectBackoff {
+public:
+    ReconnectBackoff();
+
+    /**
+     * @brief 设置退避范围并重置
+     * @param min_delay 最短等待
+     * @param max_delay 最长等待（不小于 min_delay）
+     */
+    void configure(std::chrono::milliseconds min_delay, std::chrono::milliseconds max_delay);
+
+    /**
+     * @brief 连接成功后重置退避
+     */
+    void reset();
+
+    /**
+     * @brief 下一次重连前的等待时间
+     */
+    std::chrono::milliseconds next();
+
+private:
+    std::chrono::milliseconds m_min_delay{500};
+    std::chrono::milliseconds m_max_delay{30000};
+    std::chrono::milliseconds m_previous{500};
+    std::mt19937 m_rng;
+};
+
+} // namespace southbound
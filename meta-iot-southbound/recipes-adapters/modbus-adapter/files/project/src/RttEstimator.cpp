@@ -0,0 +1,54 @@
+#include "RttEstimator.hpp"
+#include <algorithm>
+
+namespace southbound {
+
+namespace {
+
+// 时钟粒度，RTTVAR 项的下限
+constexpr std::chrono::microseconds GRANULARITY{1000};
+
+} // namespace
+
+/**
+ * 设置超时范围并清空样本
+ * @param min_timeout 超时下限
+ * @param max_timeout 超时上限（不小于下限）
+ */
+void RttEstimator::configure(std::chrono::microseconds min_timeout, std::chrono::microseconds max_timeout) {
+    m_min_timeout = std::max(min_timeout, GRANULARITY);
+    m_max_timeout = std::max(max_timeout, m_min_timeout);
+    m_timeout = m_max_timeout;
+    m_srtt = std::chrono::microseconds(0);
+    m_rttvar = std::chrono::microseconds(0);
+    m_has_sample = false;
+}
+
+/**
+ * 记录一次收到应答的往返时间
+ * 首个样本：SRTT = R，RTTVAR = R / 2；
+ * 之后：RTTVAR = 3/4 RTTVAR + 1/4 |SRTT - R|，SRTT = 7/8 SRTT + 1/8 R。
+ * @param rtt 往返时间
+ */
+void RttEstimator::sample(std::chrono::microseconds rtt) {
+    rtt = std::max(rtt, std::chrono::microseconds(0));
+    if (!m_has_sample) {
+        m_srtt = rtt;
+        m_rttvar = rtt / 2;
+        m_has_sample = true;
+    } else {
+        std::chrono::microseconds delta = m_srtt > rtt ? m_srtt - rtt : rtt - m_srtt;
+        m_rttvar = (m_rttvar * 3 + delta) / 4;
+        m_srtt = (m_srtt * 7 + rtt) / 8;
+    }
+    m_timeout = std::clamp(m_srtt + std::max(GRANULARITY, m_rttvar * 4), m_min_timeout, m_max_timeout);
+}
+
+/**
+ * 记录一次响应超时
+ */
+void RttEstimator::backoff() {
+    m_timeout = std::min(m_timeout * 2, m_max_timeout);
+}
+
+} // namespace southbound
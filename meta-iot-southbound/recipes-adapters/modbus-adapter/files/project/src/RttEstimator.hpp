@@ -0,0 +1,51 @@
+#pragma once
+
+#include <chrono>
+
+namespace southbound {
+
+/**
+ * @brief 往返时间估计与自适应响应超时
+ * 按 RFC 6298 维护平滑往返时间（SRTT）与往返时间偏差（RTTVAR），
+ * 超时取 SRTT + 4 × RTTVAR 并限制在 [min_timeout, max_timeout] 内；
+ * 发生超时后超时值加倍（Karn 算法），直到下一个有效样本。
+ */
+class RttEstimator {
+public:
+    /**
+     * @brief 设置超时范围并清空样本
+     * 尚无样本时超时取 max_timeout。
+     * @param min_timeout 超时下限
+     * @param max_timeout 超时上限
+     */
+    void configure(std::chrono::microseconds min_timeout, std::chrono::microseconds max_timeout);
+
+    /**
+     * @brief 记录一次收到应答的往返时间
+     */
+    void sample(std::chrono::microseconds rtt);
+
+    /**
+     * @brief 记录一次响应超时，超时值加倍（不超过上限）
+     */
+    void backoff();
+
+    /**
+     * @brief 当前响应超时
+     */
+    std::chrono::microseconds timeout() const { return m_timeout; }
+
+    std::chrono::microseconds srtt() const { return m_srtt; }
+    std::chrono::microseconds rttvar() const { return m_rttvar; }
+    std::chrono::microseconds max_timeout() const { return m_max_timeout; }
+
+private:
+    std::chrono::microseconds m_min_timeout{20000};
+    std::chrono::microseconds m_max_timeout{1000000};
+    std::chrono::microseconds m_timeout{1000000};
+    std::chrono::microseconds m_srtt{0};
+    std::chrono::microseconds m_rttvar{0};
+    bool m_has_sample{false};
+};
+
+} // namespace southbound
@@ -0,0 +1,144 @@
+#include "RtuBus.hpp"
+#include <map>
+#include <thread>
+
+namespace southbound {
+
+namespace {
+
+// 进程内的串口注册表（插件只加载一次，所有适配器实例共享）
+std::mutex g_registry_mutex;
+std::map<std::string, std::weak_ptr<RtuBus>> g_registry;
+
+} // namespace
+
+/**
+ * 构造函数
+ * 创建 RTU 上下文并按波特率计算帧间静默时间。
+ * @param settings 串口参数
+ */
+RtuBus::RtuBus(const RtuSettings& settings)
+    : m_settings(settings)
+    , m_idle_since(std::chrono::steady_clock::now()) {
+    m_ctx = modbus_new_rtu(settings.device_path.c_str(), settings.baudrate, settings.parity,
+                           settings.data_bits, settings.stop_bits);
+
+    if (settings.baudrate > 19200) {
+        m_silence = std::chrono::microseconds(1750);
+    } else if (settings.baudrate > 0) {
+        int64_t bits_per_char = 1 + settings.data_bits + (settings.parity == 'N' ? 0 : 1) + settings.stop_bits;
+        m_silence = std::chrono::microseconds(bits_per_char * 3500000 / settings.baudrate);
+    }
+}
+
+/**
+ * 析构函数
+ * 最后一个使用者释放后关闭串口并释放上下文。
+ */
+RtuBus::~RtuBus() {
+    if (m_ctx) {
+        if (m_open_count > 0 && !m_settings.native) {
+            modbus_close(m_ctx);
+        }
+        modbus_free(m_ctx);
+    }
+}
+
+/**
+ * 获取串口对应的总线
+ * @param settings 串口参数
+ * @param result 输出状态码
+ * @return 总线；失败时为空
+ */
+std::shared_ptr<RtuBus> RtuBus::acquire(const RtuSettings& settings, StatusCode& result) {
+    std::lock_guard<std::mutex> lock(g_registry_mutex);
+
+    std::shared_ptr<RtuBus> bus = g_registry[settings.device_path].lock();
+    if (bus) {
+        result = bus->m_settings == settings ? StatusCode::OK : StatusCode::BadConfig;
+        return result == StatusCode::OK ? bus : nullptr;
+    }
+
+    bus.reset(new RtuBus(settings));
+    if (!bus->m_ctx) {
+        result = StatusCode::Error;
+        return nullptr;
+    }
+    g_registry[settings.device_path] = bus;
+    result = StatusCode::OK;
+    return bus;
+}
+
+/**
+ * 打开串口（引用计数）
+ * 启用原生传输时由其直接打开串口，libmodbus 上下文不连接。
+ * @return 0 成功；-1 失败
+ */
+int RtuBus::open() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_open_count == 0) {
+        int result = m_settings.native
+            ? m_native.open(m_settings.device_path, m_settings.baudrate, m_settings.parity,
+                            m_settings.data_bits, m_settings.stop_bits)
+            : modbus_connect(m_ctx);
+        if (result == -1) {
+            return -1;
+        }
+    }
+    ++m_open_count;
+    return 0;
+}
+
+/**
+ * 释放一次 open()
+ */
+void RtuBus::close() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (m_open_count > 0 && --m_open_count == 0) {
+        if (m_settings.native) {
+            m_native.close();
+        } else {
+            modbus_close(m_ctx);
+        }
+    }
+}
+
+/**
+ * 等待并占用总线
+ * 高优先级队列非空时先服务其队首，否则服务普通队列队首；获得总线后补足距上一帧结束的静默时间。
+ * @param urgent 是否为高优先级事务
+ */
+void RtuBus::lock(bool urgent) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    uint64_t ticket = m_next_ticket++;
+    std::vector<uint64_t>& queue = urgent ? m_urgent : m_normal;
+    queue.push_back(ticket);
+
+    m_cv.wait(lock, [&] {
+        if (m_busy) {
+            return false;
+        }
+        const std::vector<uint64_t>& head = m_urgent.empty() ? m_normal : m_urgent;
+        return head.front() == ticket;
+    });
+    queue.erase(queue.begin());
+    m_busy = true;
+
+    std::chrono::steady_clock::time_point ready = m_idle_since + m_silence;
+    lock.unlock();
+    std::this_thread::sleep_until(ready);
+}
+
+/**
+ * 释放总线并记录帧结束时刻
+ */
+void RtuBus::unlock() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_busy = false;
+        m_idle_since = std::chrono::steady_clock::now();
+    }
+    m_cv.notify_all();
+}
+
+} // namespace southbound
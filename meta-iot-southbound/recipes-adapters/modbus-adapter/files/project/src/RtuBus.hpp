@@ -0,0 +1,111 @@
+#pragma once
+
+#include <southbound/Types.hpp>
+#include <modbus/modbus.h>
+#include "ModbusRtuTransport.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace southbound {
+
+/**
+ * @brief 串口参数
+ */
+struct RtuSettings {
+    std::string device_path;
+    int baudrate{9600};
+    char parity{'N'};
+    int data_bits{8};
+    int stop_bits{1};
+    bool native{false};     // 使用原生传输而非 libmodbus 收发
+
+    bool operator==(const RtuSettings& other) const {
+        return device_path == other.device_path && baudrate == other.baudrate && parity == other.parity
+            && data_bits == other.data_bits && stop_bits == other.stop_bits && native == other.native;
+    }
+};
+
+/**
+ * @brief RS-485 总线仲裁器
+ * 同一串口上的所有设备（适配器实例）共享一个 RtuBus：它持有唯一的 libmodbus RTU 上下文，
+ * 按引用计数打开/关闭串口，并以事务为单位分配总线——等待者按先来先服务排队（每个设备同一时刻
+ * 至多一个事务在排队，因而各设备轮流使用总线），写请求优先于读请求；
+ * 两个事务之间保证 3.5 个字符时间的帧间静默。
+ */
+class RtuBus {
+public:
+    ~RtuBus();
+
+    RtuBus(const RtuBus&) = delete;
+    RtuBus& operator=(const RtuBus&) = delete;
+
+    /**
+     * @brief 获取串口对应的总线，不存在时创建
+     * 进程内按 device_path 共享；同一串口的串口参数必须一致。
+     * @param settings 串口参数
+     * @param result 输出：OK 成功；BadConfig 与已有设备的串口参数不一致；Error 创建上下文失败
+     * @return 总线；失败时为空
+     */
+    static std::shared_ptr<RtuBus> acquire(const RtuSettings& settings, StatusCode& result);
+
+    /**
+     * @brief 共享的 libmodbus 上下文，只能在持有总线期间发起事务
+     */
+    modbus_t* context() const { return m_ctx; }
+
+    /**
+     * @brief 原生传输；未启用时为空，只能在持有总线期间发起事务
+     */
+    ModbusRtuTransport* native() { return m_settings.native ? &m_native : nullptr; }
+
+    /**
+     * @brief 打开串口（引用计数，首个使用者真正打开）
+     * @return 0 成功；-1 失败
+     */
+    int open();
+
+    /**
+     * @brief 释放一次 open()，最后一个使用者关闭串口
+     */
+    void close();
+
+    /**
+     * @brief 等待并占用总线，返回时已满足帧间静默
+     * @param urgent 写请求等高优先级事务
+     */
+    void lock(bool urgent);
+
+    /**
+     * @brief 释放总线
+     */
+    void unlock();
+
+    /**
+     * @brief 帧间静默时间（3.5 个字符；波特率高于 19200 时固定为 1750 微秒）
+     */
+    std::chrono::microseconds silence() const { return m_silence; }
+
+private:
+    explicit RtuBus(const RtuSettings& settings);
+
+    RtuSettings m_settings;
+    modbus_t* m_ctx{nullptr};
+    ModbusRtuTransport m_native;
+    int m_open_count{0};
+    std::chrono::microseconds m_silence{0};
+
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    std::vector<uint64_t> m_urgent;     // 等待中的高优先级票号（等待者很少，出队时前移，容量复用）
+    std::vector<uint64_t> m_normal;     // 等待中的普通票号
+    uint64_t m_next_ticket{0};
+    bool m_busy{false};
+    std::chrono::steady_clock::time_point m_idle_since;
+};
+
+} // namespace southbound
@@ -0,0 +1,88 @@
+#include "ScanPlanner.hpp"
+#include <algorithm>
+
+namespace southbound {
+
+/**
+ * 构造函数
+ * @param options 规划参数；块长度上限会被限制在协议上限以内
+ */
+ScanPlanner::ScanPlanner(const ScanPlannerOptions& options)
+    : m_options(options) {
+    m_options.max_registers = std::clamp(m_options.max_registers, 1, 125);
+    m_options.max_bits = std::clamp(m_options.max_bits, 1, 2000);
+    m_options.register_gap = std::max(m_options.register_gap, 0);
+    m_options.bit_gap = std::max(m_options.bit_gap, 0);
+}
+
+/**
+ * 生成块读计划
+ * 先按 (从站, 功能码, 地址) 排序，再顺序扫描：若下一个标签与当前块属于同一组，
+ * 与块尾的间隔不超过容差，且合并后总长度不超过上限，则并入当前块，否则另起一块。
+ * @param tags 已编译的标签描述符
+ * @return 块读请求列表
+ */
+std::vector<ScanBlock> ScanPlanner::plan(const std::vector<TagDescriptor>& tags) const {
+    std::vector<size_t> indices(tags.size());
+    for (size_t i = 0; i < tags.size(); ++i) {
+        indices[i] = i;
+    }
+    return plan(tags, indices);
+}
+
+/**
+ * 仅为部分标签生成块读计划
+ * @param tags 已编译的标签描述符
+ * @param indices 参与规划的标签下标
+ * @return 块读请求列表
+ */
+std::vector<ScanBlock> ScanPlanner::plan(const std::vector<TagDescriptor>& tags, const std::vector<size_t>& indices) const {
+    std::vector<size_t> order;
+    order.reserve(indices.size());
+    for (size_t i : indices) {
+        if (tags[i].is_read()) {
+            order.push_back(i);
+        }
+    }
+    std::sort(order.begin(), order.end(), [&tags](size_t a, size_t b) {
+        const TagDescriptor& x = tags[a];
+        const TagDescriptor& y = tags[b];
+        if (x.slave_id != y.slave_id) return x.slave_id < y.slave_id;
+        if (x.function_code != y.function_code) return x.function_code < y.function_code;
+        if (x.address != y.address) return x.address < y.address;
+        return x.count > y.count;
+    });
+
+    std::vector<ScanBlock> blocks;
+    ScanBlock* current = nullptr;
+    int current_end = 0; // 当前块的结束地址（不含）
+
+    for (size_t index : order) {
+        const TagDescriptor& item = tags[index];
+        const bool bits = item.is_bit();
+        const int gap = bits ? m_options.bit_gap : m_options.register_gap;
+        const int limit = bits ? m_options.max_bits : m_options.max_registers;
+        const int count = item.count;
+        const int item_end = item.address + count;
+
+        bool merge = current != nullptr
+            && current->slave_id == item.slave_id
+            && current->function_code == item.function_code
+            && item.address <= current_end + gap
+            && std::max(current_end, item_end) - current->start_address <= limit;
+
+        if (!merge) {
+            blocks.push_back(ScanBlock{item.slave_id, item.function_code, item.address, count, {}});
+            current = &blocks.back();
+            current_end = item_end;
+        } else {
+            current_end = std::max(current_end, item_end);
+            current->count = current_end - current->start_address;
+        }
+        current->items.push_back(index);
+    }
+
+    return blocks;
+}
+
+} // namespace southbound
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "TagDescriptor.hpp"
+#include <cstddef>
+#include <vector>
+
+namespace southbound {
+
+/**
+ * @brief 合并后的一次块读请求
+ */
+struct ScanBlock {
+    int slave_id;
+    int function_code;
+    int start_address;
+    int count;
+    std::vector<size_t> items; // 落在本块内的标签（plan() 输入中的下标）
+};
+
+/**
+ * @brief 扫描规划参数
+ */
+struct ScanPlannerOptions {
+    int register_gap{4};    // 允许为合并而多读的空闲寄存器数
+    int bit_gap{32};        // 允许为合并而多读的空闲位数
+    int max_registers{125}; // 单块最大寄存器数（协议上限 125）
+    int max_bits{2000};     // 单块最大位数（协议上限 2000）
+};
+
+/**
+ * @brief 扫描规划器
+ * 将标签按从站与功能码分组，把相邻或间隔不超过容差的地址合并为块读，
+ * 块长度不超过协议上限。
+ */
+class ScanPlanner {
+public:
+    explicit ScanPlanner(const ScanPlannerOptions& options = ScanPlannerOptions());
+
+    /**
+     * @brief 生成块读计划
+     * @param tags 已编译的标签描述符；非读功能码的标签被忽略
+     * @return 块读请求列表，按从站、功能码、地址排序
+     */
+    std::vector<ScanBlock> plan(const std::vector<TagDescriptor>& tags) const;
+
+    /**
+     * @brief 仅为部分标签生成块读计划
+     * @param tags 已编译的标签描述符
+     * @param indices 参与规划的标签下标
+     * @return 块读请求列表，ScanBlock::items 仍为 tags 中的下标
+     */
+    std::vector<ScanBlock> plan(const std::vector<TagDescriptor>& tags, const std::vector<size_t>& indices) const;
+
+    const ScanPlannerOptions& options() const { return m_options; }
+
+private:
+    ScanPlannerOptions m_options;
+};
+
+} // namespace southbound
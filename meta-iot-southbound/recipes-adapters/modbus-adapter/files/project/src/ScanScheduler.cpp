@@ -0,0 +1,70 @@
+#include "ScanScheduler.hpp"
+#include <algorithm>
+#include <numeric>
+
+namespace southbound {
+
+/**
+ * 配置扫描类
+ * 节拍取各周期的最大公约数（不小于 MIN_TICK_MS），周期按节拍取整。
+ * @param periods_ms 每个扫描类的周期（毫秒）
+ */
+void ScanScheduler::configure(const std::vector<uint32_t>& periods_ms) {
+    m_wheel.assign(WHEEL_SLOTS, {});
+    m_cursor = 0;
+
+    size_t count = std::min(periods_ms.size(), MAX_CLASSES);
+    for (std::vector<Timer>& slot : m_wheel) {
+        slot.reserve(count); // 任一槽至多容纳全部定时器，推进时不再扩容
+    }
+    uint32_t tick = 0;
+    for (size_t i = 0; i < count; ++i) {
+        tick = std::gcd(tick, std::max<uint32_t>(periods_ms[i], 1));
+    }
+    tick = std::max(tick, MIN_TICK_MS);
+    m_tick = std::chrono::milliseconds(tick);
+
+    for (size_t i = 0; i < count; ++i) {
+        uint32_t period_ticks = std::max<uint32_t>((periods_ms[i] + tick / 2) / tick, 1);
+        m_wheel[m_cursor].push_back(Timer{static_cast<uint32_t>(i), period_ticks, 0});
+    }
+}
+
+/**
+ * 推进一个节拍
+ * 原地处理当前槽：圈数未归零的定时器减一圈后留在原槽，到期的定时器按周期重新挂到目标槽。
+ * 各槽在配置时预留全部定时器的容量，推进时不分配内存。
+ * @return 本节拍到期的扫描类位掩码
+ */
+uint32_t ScanScheduler::advance() {
+    if (m_wheel.empty()) {
+        return 0;
+    }
+
+    uint32_t due = 0;
+    std::vector<Timer>& slot = m_wheel[m_cursor];
+    size_t kept = 0;
+
+    for (size_t i = 0; i < slot.size(); ++i) {
+        Timer timer = slot[i];
+        if (timer.rounds > 0) {
+            --timer.rounds;
+            slot[kept++] = timer;
+            continue;
+        }
+        due |= 1u << timer.scan_class;
+        timer.rounds = (timer.period_ticks - 1) / WHEEL_SLOTS;
+        size_t target = (m_cursor + timer.period_ticks) % WHEEL_SLOTS;
+        if (target == m_cursor) {
+            slot[kept++] = timer; // 周期为槽数整数倍时回到原槽
+        } else {
+            m_wheel[target].push_back(timer);
+        }
+    }
+    slot.resize(kept);
+
+    m_cursor = (m_cursor + 1) % WHEEL_SLOTS;
+    return due;
+}
+
+} // namespace southbound
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace southbound {
+
+/**
+ * @brief 扫描周期超时（处理时间超过节拍）后的处理策略
+ */
+enum class OverrunPolicy {
+    Skip,    // 跳过已错过的节拍，其到期扫描类并入下一节拍，保持原相位
+    CatchUp, // 立即逐个补执行已错过的节拍，保持原相位
+    Stretch  // 从当前时刻重新计时，周期被拉长，相位后移
+};
+
+/**
+ * @brief 扫描周期统计（单位：微秒）
+ */
+struct CycleStatistics {
+    uint64_t cycles{0};             // 执行了扫描的节拍数（不含没有扫描类到期的空节拍）
+    uint64_t missed_deadlines{0};   // 错过截止时间的节拍数
+    uint64_t last_duration_us{0};   // 最近一次节拍处理耗时
+    uint64_t max_duration_us{0};
+    uint64_t total_duration_us{0};
+    uint64_t last_jitter_us{0};     // 最近一次唤醒相对截止时间的延迟
+    uint64_t max_jitter_us{0};
+    uint64_t total_jitter_us{0};
+};
+
+/**
+ * @brief 扫描类调度器（哈希时间轮）
+ * 每个扫描类有自己的周期，时间轮以所有周期的最大公约数为节拍推进，
+ * 每个节拍返回到期的扫描类集合（位掩码），同一节拍到期的类由调用方合并读取。
+ */
+class ScanScheduler {
+public:
+    static constexpr size_t MAX_CLASSES = 32;       // 位掩码容量
+    static constexpr uint32_t MIN_TICK_MS = 10;     // 最小节拍
+    static constexpr size_t WHEEL_SLOTS = 64;       // 时间轮槽数
+
+    /**
+     * @brief 配置扫描类
+     * 所有扫描类在第一个节拍同时到期。
+     * @param periods_ms 每个扫描类的周期（毫秒），最多 MAX_CLASSES 个
+     */
+    void configure(const std::vector<uint32_t>& periods_ms);
+
+    /**
+     * @brief 时间轮节拍
+     */
+    std::chrono::milliseconds tick() const { return m_tick; }
+
+    /**
+     * @brief 推进一个节拍
+     * @return 本节拍到期的扫描类位掩码（第 i 位对应第 i 个扫描类）
+     */
+    uint32_t advance();
+
+private:
+    struct Timer {
+        uint32_t scan_class;    // 扫描类下标
+        uint32_t period_ticks;  // 周期（节拍数）
+        uint32_t rounds;        // 还需绕轮的圈数
+    };
+
+    std::vector<std::vector<Timer>> m_wheel;
+    size_t m_cursor{0};
+    std::chrono::milliseconds m_tick{1000};
+};
+
+} // namespace southbound
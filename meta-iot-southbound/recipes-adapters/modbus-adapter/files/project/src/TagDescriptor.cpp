@@ -0,0 +1,572 @@
+#include "TagDescriptor.hpp"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <utility>
+
+namespace southbound {
+
+namespace {
+
+/**
+ * 解析十进制整数，不抛异常
+ */
+bool parse_int(const std::string& text, int& out) {
+    const char* begin = text.data();
+    const char* end = begin + text.size();
+    auto result = std::from_chars(begin, end, out);
+    return result.ec == std::errc() && result.ptr == end;
+}
+
+/**
+ * 查找标签属性
+ */
+const std::string* find_attribute(const DeviceTag& tag, const char* key) {
+    auto it = tag.attributes.find(key);
+    return it == tag.attributes.end() ? nullptr : &it->second;
+}
+
+/**
+ * 按字节序取出 16 位值
+ */
+template <ByteOrder Order>
+inline uint16_t load16(const uint16_t* r) {
+    if constexpr (Order == ByteOrder::BADC || Order == ByteOrder::DCBA) {
+        return static_cast<uint16_t>((r[0] << 8) | (r[0] >> 8));
+    } else {
+        return r[0];
+    }
+}
+
+/**
+ * 按字节序将两个寄存器组合为 32 位值
+ */
+template <ByteOrder Order>
+inline uint32_t load32(const uint16_t* r) {
+    uint16_t hi = r[0];
+    uint16_t lo = r[1];
+    if constexpr (Order == ByteOrder::CDAB || Order == ByteOrder::DCBA) {
+        std::swap(hi, lo);
+    }
+    if constexpr (Order == ByteOrder::BADC || Order == ByteOrder::DCBA) {
+        hi = static_cast<uint16_t>((hi << 8) | (hi >> 8));
+        lo = static_cast<uint16_t>((lo << 8) | (lo >> 8));
+    }
+    return (static_cast<uint32_t>(hi) << 16) | lo;
+}
+
+/**
+ * 按字节序将四个寄存器组合为 64 位值
+ */
+template <ByteOrder Order>
+inline uint64_t load64(const uint16_t* r) {
+    constexpr bool low_first = Order == ByteOrder::CDAB || Order == ByteOrder::DCBA;
+    uint64_t v = 0;
+    for (int i = 0; i < 4; ++i) {
+        v = (v << 16) | load16<Order>(r + (low_first ? 3 - i : i));
+    }
+    return v;
+}
+
+template <DataType Type, ByteOrder Order>
+void decode(const uint16_t* r, DataValue& value) {
+    if constexpr (Type == DataType::Int16) {
+        value.value = static_cast<int32_t>(static_cast<int16_t>(load16<Order>(r)));
+    } else if constexpr (Type == DataType::Uint16) {
+        value.value = static_cast<uint32_t>(load16<Order>(r));
+    } else if constexpr (Type == DataType::Int32) {
+        value.value = static_cast<int32_t>(load32<Order>(r));
+    } else if constexpr (Type == DataType::Uint32) {
+        value.value = load32<Order>(r);
+    } else if constexpr (Type == DataType::Float32) {
+        uint32_t bits = load32<Order>(r);
+        float fval;
+        std::memcpy(&fval, &bits, sizeof(float));
+        value.value = fval;
+    } else if constexpr (Type == DataType::Int64) {
+        value.value = static_cast<int64_t>(load64<Order>(r));
+    } else if constexpr (Type == DataType::Float64) {
+        uint64_t bits = load64<Order>(r);
+        double dval;
+        std::memcpy(&dval, &bits, sizeof(double));
+        value.value = dval;
+    } else {
+        value.value = static_cast<int32_t>(load16<Order>(r));
+    }
+}
+
+/**
+ * 取出寄存器中的一位（位号针对按字节序还原后的 16 位值）
+ */
+template <ByteOrder Order, int Bit>
+void decode_bit(const uint16_t* r, DataValue& value) {
+    value.value = static_cast<bool>((load16<Order>(r) >> Bit) & 1);
+}
+
+template <ByteOrder Order, size_t... Bits>
+constexpr std::array<DecodeFunc, 16> bit_decoders(std::index_sequence<Bits...>) {
+    return {{&decode_bit<Order, static_cast<int>(Bits)>...}};
+}
+
+DecodeFunc select_bit_decoder(ByteOrder order, int bit) {
+    // 字节序只影响是否交换字节，ABCD/CDAB 与 BADC/DCBA 各共用一张表
+    static constexpr std::array<DecodeFunc, 16> straight = bit_decoders<ByteOrder::ABCD>(std::make_index_sequence<16>());
+    static constexpr std::array<DecodeFunc, 16> swapped = bit_decoders<ByteOrder::BADC>(std::make_index_sequence<16>());
+    bool swap = order == ByteOrder::BADC || order == ByteOrder::DCBA;
+    return swap ? swapped[bit] : straight[bit];
+}
+
+template <DataType Type>
+DecodeFunc select_decoder(ByteOrder order) {
+    switch (order) {
+        case ByteOrder::CDAB: return &decode<Type, ByteOrder::CDAB>;
+        case ByteOrder::BADC: return &decode<Type, ByteOrder::BADC>;
+        case ByteOrder::DCBA: return &decode<Type, ByteOrder::DCBA>;
+        case ByteOrder::ABCD:
+        default: return &decode<Type, ByteOrder::ABCD>;
+    }
+}
+
+DecodeFunc select_decoder(DataType type, ByteOrder order) {
+    switch (type) {
+        case DataType::Int16: return select_decoder<DataType::Int16>(order);
+        case DataType::Uint16: return select_decoder<DataType::Uint16>(order);
+        case DataType::Int32: return select_decoder<DataType::Int32>(order);
+        case DataType::Uint32: return select_decoder<DataType::Uint32>(order);
+        case DataType::Float32: return select_decoder<DataType::Float32>(order);
+        case DataType::Int64: return select_decoder<DataType::Int64>(order);
+        case DataType::Float64: return select_decoder<DataType::Float64>(order);
+        case DataType::Register:
+        default: return select_decoder<DataType::Register>(order);
+    }
+}
+
+/**
+ * 按字节序写出 16 位值（load16 的逆过程）
+ */
+template <ByteOrder Order>
+inline void store16(uint16_t v, uint16_t* r) {
+    if constexpr (Order == ByteOrder::BADC || Order == ByteOrder::DCBA) {
+        v = static_cast<uint16_t>((v << 8) | (v >> 8));
+    }
+    r[0] = v;
+}
+
+/**
+ * 按字节序将 32 位值拆分到两个寄存器（load32 的逆过程）
+ */
+template <ByteOrder Order>
+inline void store32(uint32_t v, uint16_t* r) {
+    uint16_t hi = static_cast<uint16_t>(v >> 16);
+    uint16_t lo = static_cast<uint16_t>(v & 0xFFFF);
+    if constexpr (Order == ByteOrder::BADC || Order == ByteOrder::DCBA) {
+        hi = static_cast<uint16_t>((hi << 8) | (hi >> 8));
+        lo = static_cast<uint16_t>((lo << 8) | (lo >> 8));
+    }
+    if constexpr (Order == ByteOrder::CDAB || Order == ByteOrder::DCBA) {
+        std::swap(hi, lo);
+    }
+    r[0] = hi;
+    r[1] = lo;
+}
+
+/**
+ * 按字节序将 64 位值拆分到四个寄存器（load64 的逆过程）
+ */
+template <ByteOrder Order>
+inline void store64(uint64_t v, uint16_t* r) {
+    constexpr bool low_first = Order == ByteOrder::CDAB || Order == ByteOrder::DCBA;
+    for (int i = 3; i >= 0; --i) {
+        store16<Order>(static_cast<uint16_t>(v & 0xFFFF), r + (low_first ? 3 - i : i));
+        v >>= 16;
+    }
+}
+
+/**
+ * 取数值型标签值
+ * 整数类型保持精确值，浮点数四舍五入到 integer；string 返回 false。
+ * @param exact 输出 integer 是否可信（浮点数超出 int64 范围时为 false）
+ */
+bool numeric_value(const DataValue& value, double& real, int64_t& integer, bool& exact) {
+    exact = true;
+    if (const auto* v = std::get_if<bool>(&value.value)) { integer = *v ? 1 : 0; real = integer; return true; }
+    if (const auto* v = std::get_if<int32_t>(&value.value)) { integer = *v; real = *v; return true; }
+    if (const auto* v = std::get_if<uint32_t>(&value.value)) { integer = *v; real = *v; return true; }
+    if (const auto* v = std::get_if<int64_t>(&value.value)) { integer = *v; real = static_cast<double>(*v); return true; }
+    if (const auto* v = std::get_if<float>(&value.value)) { real = *v; }
+    else if (const auto* v = std::get_if<double>(&value.value)) { real = *v; }
+    else { return false; }
+    if (!std::isfinite(real) || std::fabs(real) > 9.0e18) {
+        integer = std::numeric_limits<int64_t>::max(); // 超出任何整数类型的范围
+        exact = false;
+    } else {
+        integer = std::llround(real);
+    }
+    return true;
+}
+
+template <ByteOrder Order>
+StatusCode encode(DataType type, const DataValue& value, uint16_t* r) {
+    double real = 0.0;
+    int64_t integer = 0;
+    bool exact = true;
+    if (!numeric_value(value, real, integer, exact)) {
+        return StatusCode::InvalidParam;
+    }
+
+    switch (type) {
+        case DataType::Int16:
+            if (integer < INT16_MIN || integer > INT16_MAX) return StatusCode::InvalidParam;
+            store16<Order>(static_cast<uint16_t>(integer), r);
+            break;
+        case DataType::Uint16:
+            if (integer < 0 || integer > UINT16_MAX) return StatusCode::InvalidParam;
+            store16<Order>(static_cast<uint16_t>(integer), r);
+            break;
+        case DataType::Int32:
+            if (integer < INT32_MIN || integer > INT32_MAX) return StatusCode::InvalidParam;
+            store32<Order>(static_cast<uint32_t>(integer), r);
+            break;
+        case DataType::Uint32:
+            if (integer < 0 || integer > UINT32_MAX) return StatusCode::InvalidParam;
+            store32<Order>(static_cast<uint32_t>(integer), r);
+            break;
+        case DataType::Float32: {
+            float fval = static_cast<float>(real);
+            uint32_t bits;
+            std::memcpy(&bits, &fval, sizeof(float));
+            store32<Order>(bits, r);
+            break;
+        }
+        case DataType::Int64:
+            if (!exact) return StatusCode::InvalidParam;
+            store64<Order>(static_cast<uint64_t>(integer), r);
+            break;
+        case DataType::Float64: {
+            uint64_t bits;
+            std::memcpy(&bits, &real, sizeof(double));
+            store64<Order>(bits, r);
+            break;
+        }
+        case DataType::Register:
+        default:
+            // 寄存器原值：接受有符号或无符号 16 位范围
+            if (integer < INT16_MIN || integer > UINT16_MAX) return StatusCode::InvalidParam;
+            store16<Order>(static_cast<uint16_t>(integer), r);
+            break;
+    }
+    return StatusCode::OK;
+}
+
+/**
+ * 解析数据类型名称
+ * @param name data_type 属性值
+ * @param type 输出数据类型
+ * @return 是否为已知的类型名
+ */
+bool parse_data_type(const std::string& name, DataType& type) {
+    if (name == "int16") { type = DataType::Int16; return true; }
+    if (name == "uint16") { type = DataType::Uint16; return true; }
+    if (name == "int32") { type = DataType::Int32; return true; }
+    if (name == "uint32") { type = DataType::Uint32; return true; }
+    if (name == "float32" || name == "float") { type = DataType::Float32; return true; }
+    if (name == "int64") { type = DataType::Int64; return true; }
+    if (name == "float64" || name == "double") { type = DataType::Float64; return true; }
+    return false;
+}
+
+/**
+ * 由配置文件写法的 type 得到功能码
+ */
+int function_code_for_type(const std::string& type) {
+    if (type == "coil") return 1;
+    if (type == "discrete") return 2;
+    if (type == "holding") return 3;
+    if (type == "input") return 4;
+    return 0;
+}
+
+/**
+ * 由 Modicon 数据表前缀（0/1/3/4）得到功能码
+ */
+int function_code_for_table(int table) {
+    switch (table) {
+        case 0: return 1;
+        case 1: return 2;
+        case 3: return 4;
+        case 4: return 3;
+        default: return 0;
+    }
+}
+
+/**
+ * 解析配置文件写法的地址
+ * address 为 1 起的参考号；5 位（40001）或 6 位（400001）参考号的首位为数据表前缀，
+ * 未给出 type 时用它推断功能码，更短的地址默认为保持寄存器。
+ * @return 是否解析成功
+ */
+bool parse_reference(const std::string& address_text, const std::string* type, int& function_code, int& address) {
+    int reference = 0;
+    if (!parse_int(address_text, reference) || reference < 1) {
+        return false;
+    }
+
+    int table = -1;
+    int offset = reference;
+    if (reference > 99999) {
+        table = reference / 100000;
+        offset = reference % 100000;
+    } else if (reference > 9999) {
+        table = reference / 10000;
+        offset = reference % 10000;
+    }
+
+    if (type) {
+        function_code = function_code_for_type(*type);
+    } else if (table >= 0) {
+        function_code = function_code_for_table(table);
+    } else {
+        function_code = 3;
+    }
+
+    address = offset - 1;
+    return function_code != 0 && address >= 0;
+}
+
+} // namespace
+
+/**
+ * 将 DeviceTag 编译为描述符
+ * 适配器键 register_address 优先；否则按配置文件写法解析 address/type。
+ * 从站 ID 取自 slave_id 或 slave 属性，缺省为设备级 slave_id。
+ * @param tag 设备标签
+ * @param defaults 设备级默认值（从站 ID、字节序）
+ * @param descriptor 输出描述符
+ * @return StatusCode::OK 成功；InvalidParam 属性缺失或非法
+ */
+StatusCode compile_tag(const DeviceTag& tag, const TagDefaults& defaults, TagDescriptor& descriptor) {
+    descriptor = TagDescriptor();
+
+    int function_code = 3;
+    int address = 0;
+
+    if (const std::string* text = find_attribute(tag, "register_address")) {
+        if (!parse_int(*text, address)) {
+            return StatusCode::InvalidParam;
+        }
+        if (const std::string* fc = find_attribute(tag, "function_code")) {
+            if (!parse_int(*fc, function_code)) {
+                return StatusCode::InvalidParam;
+            }
+        }
+    } else if (const std::string* text = find_attribute(tag, "address")) {
+        if (!parse_reference(*text, find_attribute(tag, "type"), function_code, address)) {
+            return StatusCode::InvalidParam;
+        }
+    } else {
+        return StatusCode::InvalidParam;
+    }
+
+    // 未指定 data_type 时取寄存器原值；写错的类型名（如 flaot32）不能悄悄退化为原值
+    DataType data_type = DataType::Register;
+    if (const std::string* text = find_attribute(tag, "data_type")) {
+        if (!parse_data_type(*text, data_type)) {
+            return StatusCode::InvalidParam;
+        }
+    }
+    int count = register_width(data_type);
+    if (const std::string* text = find_attribute(tag, "register_count")) {
+        if (!parse_int(*text, count)) {
+            return StatusCode::InvalidParam;
+        }
+    }
+
+    int slave_id = defaults.slave_id;
+    const std::string* slave_text = find_attribute(tag, "slave_id");
+    if (!slave_text) {
+        slave_text = find_attribute(tag, "slave");
+    }
+    if (slave_text && !parse_int(*slave_text, slave_id)) {
+        return StatusCode::InvalidParam;
+    }
+
+    ByteOrder byte_order = defaults.byte_order;
+    if (const std::string* text = find_attribute(tag, "byte_order")) {
+        if (!parse_byte_order(*text, byte_order)) {
+            return StatusCode::InvalidParam;
+        }
+    }
+
+    int register_bit = -1;
+    if (const std::string* text = find_attribute(tag, "bit")) {
+        if (!parse_int(*text, register_bit) || register_bit < 0 || register_bit > 15) {
+            return StatusCode::InvalidParam;
+        }
+    }
+
+    bool bit = function_code == 1 || function_code == 2 || function_code == 5 || function_code == 15;
+    if (address < 0 || address > 0xFFFF || count < 1 || count > 0xFFFF || function_code < 1 || function_code > 0xFF
+        || slave_id < 0 || slave_id > 0xFF) {
+        return StatusCode::InvalidParam;
+    }
+    if (!bit && count < register_width(data_type)) {
+        return StatusCode::InvalidParam;
+    }
+    // 寄存器位只用于 16 位寄存器表
+    if (register_bit >= 0 && (bit || register_width(data_type) != 1)) {
+        return StatusCode::InvalidParam;
+    }
+
+    descriptor.address = static_cast<uint16_t>(address);
+    descriptor.count = static_cast<uint16_t>(count);
+    descriptor.slave_id = static_cast<uint8_t>(slave_id);
+    descriptor.data_type = data_type;
+    descriptor.byte_order = byte_order;
+    descriptor.bit = static_cast<int8_t>(register_bit);
+    descriptor.decode = register_bit >= 0 ? select_bit_decoder(byte_order, register_bit)
+                                          : select_decoder(data_type, byte_order);
+    descriptor.function_code = static_cast<uint8_t>(function_code);
+    return StatusCode::OK;
+}
+
+/**
+ * 将标签值编码为寄存器
+ * 按描述符的数据类型与字节序写出 register_width(data_type) 个寄存器，
+ * 数值按目标类型转换（浮点写入整数类型时四舍五入），超出目标类型范围视为非法。
+ * @param tag 标签描述符
+ * @param value 待写入的值
+ * @param registers 输出寄存器，至少 register_width(tag.data_type) 个
+ * @return StatusCode::OK 成功；InvalidParam 值类型不匹配或超出范围
+ */
+StatusCode encode_registers(const TagDescriptor& tag, const DataValue& value, uint16_t* registers) {
+    switch (tag.byte_order) {
+        case ByteOrder::CDAB: return encode<ByteOrder::CDAB>(tag.data_type, value, registers);
+        case ByteOrder::BADC: return encode<ByteOrder::BADC>(tag.data_type, value, registers);
+        case ByteOrder::DCBA: return encode<ByteOrder::DCBA>(tag.data_type, value, registers);
+        case ByteOrder::ABCD:
+        default: return encode<ByteOrder::ABCD>(tag.data_type, value, registers);
+    }
+}
+
+/**
+ * 将寄存器位标签的值编码为 FC22 掩码
+ * 字节交换的字节序（BADC/DCBA）下，还原值的第 n 位在线上寄存器的第 n ^ 8 位。
+ * @param tag 标签描述符（bit >= 0）
+ * @param value 待写入的值
+ * @param and_mask 输出 AND 掩码（目标位为 0，其余为 1）
+ * @param or_mask 输出 OR 掩码（目标位为写入值）
+ * @return StatusCode::OK 成功；InvalidParam 值类型不匹配
+ */
+StatusCode encode_register_bit(const TagDescriptor& tag, const DataValue& value, uint16_t& and_mask, uint16_t& or_mask) {
+    uint8_t state = 0;
+    StatusCode result = encode_bit(value, state);
+    if (result != StatusCode::OK || tag.bit < 0) {
+        return StatusCode::InvalidParam;
+    }
+    bool swap = tag.byte_order == ByteOrder::BADC || tag.byte_order == ByteOrder::DCBA;
+    int position = swap ? (tag.bit ^ 8) : tag.bit;
+    and_mask = static_cast<uint16_t>(~(1u << position));
+    or_mask = static_cast<uint16_t>(state << position);
+    return StatusCode::OK;
+}
+
+/**
+ * 由位数据生成线圈/离散输入标签的值
+ * @param tag 标签描述符
+ * @param bits 标签起始位
+ * @param value 输出数据值
+ */
+void decode_bits(const TagDescriptor& tag, const uint8_t* bits, DataValue& value) {
+    if (!tag.is_packed_bits()) {
+        value.value = static_cast<bool>(bits[0]);
+        return;
+    }
+    uint32_t packed = 0;
+    for (int i = tag.count - 1; i >= 0; --i) {
+        packed = (packed << 1) | (bits[i] ? 1u : 0u);
+    }
+    value.value = packed;
+}
+
+/**
+ * 将线圈标签的值编码为打包的位
+ * @param tag 标签描述符
+ * @param value 待写入的值
+ * @param bits 输出打包的位
+ * @return StatusCode::OK 成功；InvalidParam 值类型不匹配或超出范围
+ */
+StatusCode encode_bits(const TagDescriptor& tag, const DataValue& value, uint32_t& bits) {
+    if (!tag.is_packed_bits()) {
+        uint8_t state = 0;
+        StatusCode result = encode_bit(value, state);
+        bits = state;
+        return result;
+    }
+    double real = 0.0;
+    int64_t integer = 0;
+    bool exact = true;
+    if (!numeric_value(value, real, integer, exact) || integer < 0 || integer >= (int64_t(1) << tag.count)) {
+        return StatusCode::InvalidParam;
+    }
+    bits = static_cast<uint32_t>(integer);
+    return StatusCode::OK;
+}
+
+/**
+ * 将标签值编码为线圈状态
+ * @param value 待写入的值，bool 或数值（非零为 ON）
+ * @param bit 输出线圈状态（0/1）
+ * @return StatusCode::OK 成功；InvalidParam 值类型不匹配
+ */
+StatusCode encode_bit(const DataValue& value, uint8_t& bit) {
+    double real = 0.0;
+    int64_t integer = 0;
+    bool exact = true;
+    if (!numeric_value(value, real, integer, exact)) {
+        return StatusCode::InvalidParam;
+    }
+    bit = real != 0.0 ? 1 : 0;
+    return StatusCode::OK;
+}
+
+/**
+ * 解析字节序名称
+ * @param name ABCD/CDAB/BADC/DCBA，不区分大小写
+ * @param order 输出字节序
+ * @return 是否解析成功
+ */
+bool parse_byte_order(const std::string& name, ByteOrder& order) {
+    std::string upper(name);
+    std::transform(upper.begin(), upper.end(), upper.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::toupper(c)); });
+    if (upper == "ABCD") { order = ByteOrder::ABCD; return true; }
+    if (upper == "CDAB") { order = ByteOrder::CDAB; return true; }
+    if (upper == "BADC") { order = ByteOrder::BADC; return true; }
+    if (upper == "DCBA") { order = ByteOrder::DCBA; return true; }
+    return false;
+}
+
+/**
+ * 数据类型占用的寄存器数量
+ * @param type 数据类型
+ * @return 寄存器数量
+ */
+int register_width(DataType type) {
+    switch (type) {
+        case DataType::Int32:
+        case DataType::Uint32:
+        case DataType::Float32:
+            return 2;
+        case DataType::Int64:
+        case DataType::Float64:
+            return 4;
+        default:
+            return 1;
+    }
+}
+
+} // namespace southbound
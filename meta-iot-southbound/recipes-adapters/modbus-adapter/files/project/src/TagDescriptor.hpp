@@ -0,0 +1,142 @@
+#pragma once
+
+#include <southbound/Types.hpp>
+#include <cstdint>
+#include <string>
+
+namespace southbound {
+
+/**
+ * @brief 寄存器数据类型
+ */
+enum class DataType : uint8_t {
+    Register, // 未指定 data_type：寄存器原值存入 int32_t
+    Int16,
+    Uint16,
+    Int32,
+    Uint32,
+    Float32,
+    Int64,
+    Float64
+};
+
+/**
+ * @brief 多字节数据的字节/字序，A 为最高字节
+ * ABCD: 大端（高字在前）  CDAB: 字交换  BADC: 字节交换  DCBA: 小端
+ * 64 位类型同理：ABCD/BADC 高字在前，CDAB/DCBA 低字在前；BADC/DCBA 交换每个寄存器的两个字节。
+ */
+enum class ByteOrder : uint8_t {
+    ABCD,
+    CDAB,
+    BADC,
+    DCBA
+};
+
+// 解码函数：由标签起始寄存器生成标签值
+using DecodeFunc = void (*)(const uint16_t* registers, DataValue& value);
+
+/**
+ * @brief 编译后的标签描述符
+ * 由 DeviceTag 的字符串属性一次性解析得到，轮询热路径只使用描述符。
+ * 数据类型与字节序各占 4 位，64 位平台上整个描述符为 16 字节。
+ */
+struct TagDescriptor {
+    uint16_t address{0};       // PDU 地址（0 起）
+    uint16_t count{0};         // 寄存器数量或位数量
+    uint8_t function_code{0};  // 功能码，0 表示标签无效
+    uint8_t slave_id{1};       // 从站 ID
+    DataType data_type : 4;
+    ByteOrder byte_order : 4;
+    int8_t bit{-1};            // 寄存器内的位号 0..15（bit 属性），-1 表示整个寄存器
+    DecodeFunc decode{nullptr}; // 寄存器解码函数（FC3/FC4）
+
+    // C++17 的位域不能有默认成员初始化器
+    TagDescriptor() : data_type(DataType::Register), byte_order(ByteOrder::ABCD) {}
+
+    bool is_read() const { return function_code >= 1 && function_code <= 4; }
+    bool is_bit() const { return function_code == 1 || function_code == 2; }
+    // 多位线圈/离散输入标签（2..32 位）的值打包为 uint32_t；更宽的标签与单个位一样只取首个位
+    bool is_packed_bits() const { return count > 1 && count <= 32; }
+};
+
+static_assert(sizeof(TagDescriptor) <= 8 + sizeof(DecodeFunc), "TagDescriptor must stay compact");
+
+/**
+ * @brief 编译标签时使用的设备级默认值
+ */
+struct TagDefaults {
+    int slave_id{1};
+    ByteOrder byte_order{ByteOrder::ABCD};
+};
+
+/**
+ * @brief 将 DeviceTag 编译为描述符
+ * 支持适配器键（register_address/register_count/function_code/data_type/byte_order/slave_id）
+ * 与配置文件写法（address:40001,type:holding,slave:1）。
+ * @param tag 设备标签
+ * @param defaults 设备级默认值
+ * @param descriptor 输出描述符；失败时 function_code 为 0
+ * @return StatusCode::OK 成功；InvalidParam 属性缺失或非法
+ */
+StatusCode compile_tag(const DeviceTag& tag, const TagDefaults& defaults, TagDescriptor& descriptor);
+
+/**
+ * @brief 将标签值按数据类型与字节序编码为寄存器（写 FC6/FC16）
+ * @param tag 标签描述符
+ * @param value 待写入的值
+ * @param registers 输出寄存器，至少 register_width(tag.data_type) 个
+ * @return StatusCode::OK 成功；InvalidParam 值类型不匹配或超出范围
+ */
+StatusCode encode_registers(const TagDescriptor& tag, const DataValue& value, uint16_t* registers);
+
+/**
+ * @brief 将寄存器位标签（bit 属性）的值编码为 FC22 掩码写的掩码
+ * 寄存器新值 = (原值 AND and_mask) OR (or_mask AND NOT and_mask)；位号按字节序换算到线上的位置。
+ * @param tag 标签描述符（bit >= 0）
+ * @param value 待写入的值，bool 或数值（非零为 1）
+ * @param and_mask 输出 AND 掩码
+ * @param or_mask 输出 OR 掩码
+ * @return StatusCode::OK 成功；InvalidParam 值类型不匹配
+ */
+StatusCode encode_register_bit(const TagDescriptor& tag, const DataValue& value, uint16_t& and_mask, uint16_t& or_mask);
+
+/**
+ * @brief 由位数据生成线圈/离散输入标签的值
+ * 多个位（register_count 2..32）按地址由低到高打包为 uint32_t，首个地址为最低位；其余为首个位的 bool。
+ * @param tag 标签描述符
+ * @param bits 标签起始位（libmodbus 格式，每字节一位）
+ * @param value 输出数据值
+ */
+void decode_bits(const TagDescriptor& tag, const uint8_t* bits, DataValue& value);
+
+/**
+ * @brief 将线圈标签的值编码为打包的位（写 FC5/FC15）
+ * 打包标签（2..32 个线圈）接受 0..2^N-1 的整数，最低位对应首个地址；其余只写首个线圈，
+ * 接受 bool 或数值（非零为 ON）。
+ * @param tag 标签描述符
+ * @param value 待写入的值
+ * @param bits 输出打包的位
+ * @return StatusCode::OK 成功；InvalidParam 值类型不匹配或超出范围
+ */
+StatusCode encode_bits(const TagDescriptor& tag, const DataValue& value, uint32_t& bits);
+
+/**
+ * @brief 将标签值编码为线圈状态（写 FC5/FC15）
+ * @param value 待写入的值，bool 或数值（非零为 ON）
+ * @param bit 输出线圈状态（0/1）
+ * @return StatusCode::OK 成功；InvalidParam 值类型不匹配
+ */
+StatusCode encode_bit(const DataValue& value, uint8_t& bit);
+
+/**
+ * @brief 解析字节序名称（ABCD/CDAB/BADC/DCBA，不区分大小写）
+ * @return 是否解析成功
+ */
+bool parse_byte_order(const std::string& name, ByteOrder& order);
+
+/**
+ * @brief 数据类型占用的寄存器数量
+ */
+int register_width(DataType type);
+
+} // namespace southbound
@@ -0,0 +1,146 @@
+#include "BlockDecoder.hpp"
+#include <southbound/TestCheck.hpp>
+#include <cstring>
+#include <iostream>
+#include <type_traits>
+#include <vector>
+
+using namespace southbound;
+
+namespace {
+
+const ByteOrder ORDERS[] = {ByteOrder::ABCD, ByteOrder::CDAB, ByteOrder::BADC, ByteOrder::DCBA};
+const char* const ORDER_NAMES[] = {"ABCD", "CDAB", "BADC", "DCBA"};
+
+/**
+ * 覆盖所有位模式（含 NaN、负数与最高位）的伪随机寄存器
+ */
+std::vector<uint16_t> random_registers(size_t count) {
+    std::vector<uint16_t> registers(count);
+    uint32_t seed = 0x12345678;
+    for (uint16_t& r : registers) {
+        seed = seed * 1664525 + 1013904223;
+        r = static_cast<uint16_t>(seed >> 16);
+    }
+    return registers;
+}
+
+/**
+ * 两个数据值的类型相同且按位相等（NaN 也视为相等）
+ */
+bool same_value(const DataValue& a, const DataValue& b) {
+    if (a.value.index() != b.value.index()) {
+        return false;
+    }
+    return std::visit([&b](const auto& x) {
+        using V = std::decay_t<decltype(x)>;
+        const V& y = std::get<V>(b.value);
+        if constexpr (std::is_same_v<V, std::string>) {
+            return x == y;
+        } else {
+            return std::memcmp(&x, &y, sizeof(V)) == 0;
+        }
+    }, a.value);
+}
+
+/**
+ * 向量实现与标量参考实现逐位一致；数值个数覆盖向量宽度的整数倍与剩余部分
+ */
+template <typename T>
+void check_block() {
+    constexpr size_t W = sizeof(T) / 2;
+    std::vector<uint16_t> registers = random_registers(40 * W);
+    for (ByteOrder order : ORDERS) {
+        for (size_t count = 0; count <= 40; ++count) {
+            std::vector<T> fast(count + 1), scalar(count + 1);
+            std::memset(fast.data(), 0x5A, sizeof(T) * fast.size());
+            std::memset(scalar.data(), 0x5A, sizeof(T) * scalar.size());
+            decode_block(registers.data(), count, order, fast.data());
+            decode_block_scalar(registers.data(), count, order, scalar.data());
+            CHECK(std::memcmp(fast.data(), scalar.data(), sizeof(T) * fast.size()) == 0); // 不越界写
+        }
+    }
+}
+
+void test_block_matches_scalar() {
+    check_block<int16_t>();
+    check_block<uint16_t>();
+    check_block<int32_t>();
+    check_block<uint32_t>();
+    check_block<float>();
+    check_block<int64_t>();
+    check_block<double>();
+}
+
+/**
+ * 已知向量：四种字节序下的 1.0f、0x0102030405060708 与 -2
+ */
+void test_known_values() {
+    const uint16_t floats[4][2] = {{0x3F80, 0x0000}, {0x0000, 0x3F80}, {0x803F, 0x0000}, {0x0000, 0x803F}};
+    for (int i = 0; i < 4; ++i) {
+        float f = 0;
+        decode_block(floats[i], 1, ORDERS[i], &f);
+        CHECK(f == 1.0f);
+    }
+
+    const uint16_t int64s[4][4] = {{0x0102, 0x0304, 0x0506, 0x0708},
+                                   {0x0708, 0x0506, 0x0304, 0x0102},
+                                   {0x0201, 0x0403, 0x0605, 0x0807},
+                                   {0x0807, 0x0605, 0x0403, 0x0201}};
+    for (int i = 0; i < 4; ++i) {
+        int64_t v = 0;
+        decode_block(int64s[i], 1, ORDERS[i], &v);
+        CHECK(v == 0x0102030405060708LL);
+    }
+
+    const uint16_t minus_two[2] = {0xFFFE, 0xFEFF};
+    int16_t s[2] = {};
+    decode_block(minus_two, 1, ByteOrder::ABCD, &s[0]);
+    decode_block(minus_two + 1, 1, ByteOrder::BADC, &s[1]);
+    CHECK(s[0] == -2 && s[1] == -2);
+}
+
+/**
+ * decode_values 与逐个标签的 TagDescriptor::decode 结果一致（包括数据值的变体类型）
+ */
+void test_values_match_descriptor() {
+    const char* const types[] = {nullptr, "int16", "uint16", "int32", "uint32", "float32", "int64", "float64"};
+    std::vector<uint16_t> registers = random_registers(4 * 70);
+
+    for (const char* type : types) {
+        for (const char* order : ORDER_NAMES) {
+            DeviceTag tag;
+            tag.attributes = {{"register_address", "0"}, {"byte_order", order}};
+            if (type) {
+                tag.attributes["data_type"] = type;
+            }
+            TagDescriptor d;
+            CHECK(compile_tag(tag, TagDefaults(), d) == StatusCode::OK);
+            const size_t width = static_cast<size_t>(register_width(d.data_type));
+            const size_t count = 70; // 超过一次分段（64 个）
+
+            std::vector<DataValue> batch(count);
+            std::vector<DataValue*> pointers;
+            for (DataValue& value : batch) {
+                pointers.push_back(&value);
+            }
+            decode_values(registers.data(), count, d.data_type, d.byte_order, pointers.data());
+
+            for (size_t i = 0; i < count; ++i) {
+                DataValue single;
+                d.decode(registers.data() + i * width, single);
+                CHECK(same_value(batch[i], single));
+            }
+        }
+    }
+}
+
+} // namespace
+
+int main() {
+    test_block_matches_scalar();
+    test_known_values();
+    test_values_match_descriptor();
+    std::cout << "BlockDecoderTest passed" << std::endl;
+    return 0;
+}
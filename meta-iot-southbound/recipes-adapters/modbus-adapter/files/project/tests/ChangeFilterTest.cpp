@@ -0,0 +1,155 @@
+#include "ChangeFilter.hpp"
+#include <southbound/TestCheck.hpp>
+#include <cmath>
+#include <iostream>
+#include <limits>
+#include <string>
+
+using namespace southbound;
+
+namespace {
+
+template <typename T>
+DataValue value_of(T v, uint8_t quality = 1) {
+    DataValue value;
+    value.value = v;
+    value.quality = quality;
+    return value;
+}
+
+DeadbandSpec spec(double absolute, double percent = 0.0, uint32_t max_silence_ms = 0) {
+    DeadbandSpec result;
+    result.absolute = absolute;
+    result.percent = percent;
+    result.max_silence_ms = max_silence_ms;
+    return result;
+}
+
+/**
+ * 未配置死区：首次读到、数值变化、质量变化与类型变化上报，相同值不上报
+ */
+void test_exact() {
+    ChangeFilter filter;
+    filter.reset({spec(0.0), spec(0.0), spec(0.0)});
+
+    CHECK(filter.update(0, value_of(int32_t(5)), 0));
+    CHECK(!filter.update(0, value_of(int32_t(5)), 10));
+    CHECK(filter.update(0, value_of(int32_t(6)), 20));
+    CHECK(filter.update(0, value_of(int32_t(6), 0), 30));
+    CHECK(filter.update(0, value_of(uint32_t(6), 0), 40));
+
+    CHECK(filter.update(1, value_of(true), 0));
+    CHECK(!filter.update(1, value_of(true), 10));
+    CHECK(filter.update(1, value_of(false), 20));
+
+    CHECK(filter.update(2, value_of(std::string("a")), 0));
+    CHECK(!filter.update(2, value_of(std::string("a")), 10));
+    CHECK(filter.update(2, value_of(std::string("b")), 20));
+
+    CHECK(filter.update(3, value_of(int32_t(1)), 0)); // 越界下标总是上报
+    CHECK(filter.update(3, value_of(int32_t(1)), 10));
+}
+
+/**
+ * 绝对死区：与上次上报值比较，未上报的小变化不会累计成新的基准
+ */
+void test_absolute() {
+    ChangeFilter filter;
+    filter.reset({spec(0.5)});
+    CHECK(filter.update(0, value_of(10.0f), 0));
+    CHECK(!filter.update(0, value_of(10.4f), 10));
+    CHECK(!filter.update(0, value_of(10.5f), 20));
+    CHECK(filter.update(0, value_of(10.9f), 30));
+    CHECK(!filter.update(0, value_of(10.5f), 40));
+    CHECK(filter.update(0, value_of(10.3f), 50));
+}
+
+/**
+ * 百分比死区按上次上报值的绝对值计算；同时配置时须超过两个死区
+ */
+void test_percent() {
+    ChangeFilter filter;
+    filter.reset({spec(0.0, 5.0), spec(1.0, 10.0), spec(0.0, 5.0)});
+
+    CHECK(filter.update(0, value_of(100.0), 0));
+    CHECK(!filter.update(0, value_of(104.0), 10));
+    CHECK(filter.update(0, value_of(106.0), 20));
+
+    CHECK(filter.update(1, value_of(int32_t(100)), 0));
+    CHECK(!filter.update(1, value_of(int32_t(105)), 10)); // 超过绝对死区，未超过百分比死区
+    CHECK(filter.update(1, value_of(int32_t(111)), 20));
+
+    CHECK(filter.update(2, value_of(-200.0), 0));
+    CHECK(!filter.update(2, value_of(-195.0), 10));
+    CHECK(filter.update(2, value_of(-189.0), 20));
+}
+
+/**
+ * 最长静默：未变化的值在静默达到 max_silence 时上报一次，并重新计时
+ */
+void test_max_silence() {
+    ChangeFilter filter;
+    filter.reset({spec(0.5, 0.0, 1000)});
+    CHECK(filter.update(0, value_of(1.0), 5000));
+    CHECK(!filter.update(0, value_of(1.0), 5999));
+    CHECK(filter.update(0, value_of(1.0), 6000));
+    CHECK(!filter.update(0, value_of(1.2), 6500));
+    CHECK(filter.update(0, value_of(1.2), 7000));
+}
+
+/**
+ * NaN：连续的 NaN 不上报，NaN 与数值之间的切换上报
+ */
+void test_nan() {
+    const double nan = std::numeric_limits<double>::quiet_NaN();
+    ChangeFilter filter;
+    filter.reset({spec(0.5)});
+    CHECK(filter.update(0, value_of(nan), 0));
+    CHECK(!filter.update(0, value_of(nan), 10));
+    CHECK(filter.update(0, value_of(1.0), 20));
+    CHECK(filter.update(0, value_of(nan), 30));
+}
+
+/**
+ * 64 位整数按数值比较
+ */
+void test_int64() {
+    ChangeFilter filter;
+    filter.reset({spec(10.0)});
+    CHECK(filter.update(0, value_of(int64_t(1) << 40), 0));
+    CHECK(!filter.update(0, value_of((int64_t(1) << 40) + 10), 10));
+    CHECK(filter.update(0, value_of((int64_t(1) << 40) + 11), 20));
+}
+
+/**
+ * 上报参数：标签属性覆盖设备默认值，非法或负数属性保留默认值
+ */
+void test_parse_spec() {
+    DeadbandSpec defaults = spec(1.0, 2.0, 3000);
+
+    DeviceTag tag;
+    DeadbandSpec parsed = ChangeFilter::parse_spec(tag, defaults);
+    CHECK(parsed.absolute == 1.0 && parsed.percent == 2.0 && parsed.max_silence_ms == 3000);
+
+    tag.attributes = {{"deadband", "0.25"}, {"deadband_percent", "1.5"}, {"max_silence", "60000"}};
+    parsed = ChangeFilter::parse_spec(tag, defaults);
+    CHECK(parsed.absolute == 0.25 && parsed.percent == 1.5 && parsed.max_silence_ms == 60000);
+
+    tag.attributes = {{"deadband", "-1"}, {"deadband_percent", "abc"}, {"max_silence", "10ms"}};
+    parsed = ChangeFilter::parse_spec(tag, defaults);
+    CHECK(parsed.absolute == 1.0 && parsed.percent == 2.0 && parsed.max_silence_ms == 3000);
+}
+
+} // namespace
+
+int main() {
+    test_exact();
+    test_absolute();
+    test_percent();
+    test_max_silence();
+    test_nan();
+    test_int64();
+    test_parse_spec();
+    std::cout << "ChangeFilterTest passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,291 @@
+#include "IoActor.hpp"
+#include <southbound/TestCheck.hpp>
+#include <condition_variable>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace southbound;
+
+namespace {
+
+/**
+ * @brief 一次性闸门：I/O 线程在 wait() 处停住，直到测试线程 open()
+ */
+class Gate {
+public:
+    void wait() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_entered = true;
+        m_cv.notify_all();
+        m_cv.wait(lock, [this] { return m_open; });
+    }
+
+    void wait_entered() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_cv.wait(lock, [this] { return m_entered; });
+    }
+
+    void open() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_open = true;
+        m_cv.notify_all();
+    }
+
+private:
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_entered{false};
+    bool m_open{false};
+};
+
+/**
+ * @brief 线程安全的执行顺序记录
+ */
+class Trace {
+public:
+    void add(const std::string& event) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_events.push_back(event);
+    }
+
+    std::vector<std::string> events() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_events;
+    }
+
+private:
+    std::mutex m_mutex;
+    std::vector<std::string> m_events;
+};
+
+/**
+ * 给其他线程留出入队的时间
+ */
+void settle() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+}
+
+/**
+ * 同步调用在 I/O 线程上执行并返回结果；请求内的嵌套调用直接执行
+ */
+void test_call() {
+    IoActor actor;
+    actor.start();
+
+    std::thread::id io_thread;
+    StatusCode result = actor.call(IoKind::Read, [&] {
+        io_thread = std::this_thread::get_id();
+        return actor.call(IoKind::Write, [] { return StatusCode::Timeout; });
+    });
+    CHECK(result == StatusCode::Timeout);
+    CHECK(io_thread != std::thread::id() && io_thread != std::this_thread::get_id());
+
+    int steps = 0;
+    actor.call_steps(IoKind::Scan, [&steps] { return ++steps < 3; });
+    CHECK(steps == 3);
+
+    IoLaneStatistics normal = actor.statistics(false);
+    IoLaneStatistics urgent = actor.statistics(true);
+    CHECK(normal.requests == 2 && urgent.requests == 0); // 嵌套调用不入队
+}
+
+/**
+ * 同一通道的请求按入队顺序逐个执行
+ */
+void test_order() {
+    IoActor actor;
+    actor.start();
+    Gate gate;
+    Trace trace;
+
+    CHECK(actor.post(IoKind::Scan, [&] {
+        gate.wait();
+        trace.add("scan");
+        return false;
+    }));
+    gate.wait_entered();
+    CHECK(actor.post(IoKind::Read, [&] {
+        trace.add("read");
+        return false;
+    }));
+    std::thread control([&] {
+        actor.call(IoKind::Control, [&] {
+            trace.add("control");
+            return StatusCode::OK;
+        });
+    });
+    settle();
+    gate.open();
+    control.join();
+    actor.stop();
+
+    CHECK((trace.events() == std::vector<std::string>{"scan", "read", "control"}));
+}
+
+/**
+ * 优先通道：排队中的写请求先于排队的读请求，并在分步请求的两步之间执行
+ */
+void test_lane_order() {
+    IoActor actor;
+    actor.start();
+    Gate first_step;
+    Trace trace;
+
+    std::thread scan([&] {
+        int step = 0;
+        actor.call_steps(IoKind::Scan, [&] {
+            ++step;
+            if (step == 1) {
+                first_step.wait();
+            }
+            trace.add("scan" + std::to_string(step));
+            return step < 3;
+        });
+    });
+    first_step.wait_entered();
+
+    CHECK(actor.post(IoKind::Read, [&] {
+        trace.add("read");
+        return false;
+    }));
+    std::thread write([&] {
+        actor.call(IoKind::Write, [&] {
+            trace.add("write");
+            return StatusCode::OK;
+        });
+    });
+    settle();
+    first_step.open();
+    write.join();
+    scan.join();
+    actor.stop();
+
+    CHECK((trace.events() == std::vector<std::string>{"scan1", "write", "scan2", "scan3", "read"}));
+    CHECK(actor.statistics(true).requests == 1 && actor.statistics(false).requests == 2);
+}
+
+/**
+ * 未启动时同步调用返回 NotConnected，不在调用线程上执行
+ */
+void test_not_started() {
+    IoActor actor;
+    bool ran = false;
+    CHECK(actor.call(IoKind::Control, [&ran] {
+        ran = true;
+        return StatusCode::OK;
+    }) == StatusCode::NotConnected);
+    CHECK(!ran);
+    CHECK(!actor.post(IoKind::Read, [] { return false; }));
+}
+
+/**
+ * 停止时先执行完已入队的请求；停止后的调用返回 NotConnected；停止后可再次启动
+ */
+void test_stop_restart() {
+    IoActor actor;
+    actor.start();
+    Gate gate;
+    Trace trace;
+
+    CHECK(actor.post(IoKind::Control, [&] {
+        gate.wait();
+        return false;
+    }));
+    gate.wait_entered();
+    for (int i = 0; i < 3; ++i) {
+        CHECK(actor.post(IoKind::Read, [&trace, i] {
+            trace.add("post" + std::to_string(i));
+            return false;
+        }));
+    }
+    std::thread stopper([&] { actor.stop(); });
+    settle();
+    gate.open();
+    stopper.join();
+    CHECK((trace.events() == std::vector<std::string>{"post0", "post1", "post2"}));
+
+    CHECK(!actor.post(IoKind::Read, [] { return false; }));
+    bool ran = false;
+    CHECK(actor.call(IoKind::Read, [&ran] {
+        ran = true;
+        return StatusCode::OK;
+    }) == StatusCode::NotConnected);
+    CHECK(actor.call_steps(IoKind::Scan, [&ran] { return ran = true; }) == StatusCode::NotConnected);
+    CHECK(!ran);
+
+    actor.start();
+    std::thread::id io_thread;
+    CHECK(actor.call(IoKind::Read, [&] {
+        io_thread = std::this_thread::get_id();
+        return StatusCode::OK;
+    }) == StatusCode::OK);
+    CHECK(io_thread != std::this_thread::get_id());
+    actor.stop();
+}
+
+/**
+ * 在 I/O 线程自身的请求内停止并析构执行器：不等待自身，剩余请求照常执行
+ */
+void test_stop_on_io_thread() {
+    IoActor* actor = new IoActor();
+    actor->start();
+    Gate queued;
+    Gate done;
+    CHECK(actor->post(IoKind::Control, [actor, &queued] {
+        queued.wait();
+        actor->stop();
+        delete actor;
+        return false;
+    }));
+    CHECK(actor->post(IoKind::Read, [&done] {
+        done.open();
+        return false;
+    }));
+    queued.open();
+    done.wait();
+}
+
+/**
+ * 在 I/O 线程上停止后，其他线程的调用返回 NotConnected，而请求内剩余的嵌套调用仍在当前线程执行；
+ * 再次启动后使用新的 I/O 线程
+ */
+void test_restart_after_stop_on_io_thread() {
+    IoActor actor;
+    actor.start();
+    std::thread::id first;
+    bool nested = false;
+    CHECK(actor.call(IoKind::Control, [&] {
+        first = std::this_thread::get_id();
+        actor.stop();
+        nested = actor.call(IoKind::Read, [] { return StatusCode::OK; }) == StatusCode::OK;
+        return StatusCode::OK;
+    }) == StatusCode::OK);
+    CHECK(nested);
+    CHECK(actor.call(IoKind::Read, [] { return StatusCode::OK; }) == StatusCode::NotConnected);
+
+    actor.start();
+    std::thread::id second;
+    CHECK(actor.call(IoKind::Read, [&] {
+        second = std::this_thread::get_id();
+        return StatusCode::OK;
+    }) == StatusCode::OK);
+    CHECK(second != std::thread::id() && second != std::this_thread::get_id());
+    actor.stop();
+}
+
+} // namespace
+
+int main() {
+    test_call();
+    test_order();
+    test_lane_order();
+    test_not_started();
+    test_stop_restart();
+    test_stop_on_io_thread();
+    test_restart_after_stop_on_io_thread();
+    std::cout << "IoActorTest passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,158 @@
+#include "LastValueCache.hpp"
+#include <southbound/TestCheck.hpp>
+#include <iostream>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace southbound;
+using std::chrono::milliseconds;
+
+namespace {
+
+TagDescriptor descriptor(const std::map<std::string, std::string>& attributes) {
+    DeviceTag tag;
+    tag.attributes = attributes;
+    TagDescriptor d;
+    CHECK(compile_tag(tag, TagDefaults(), d) == StatusCode::OK);
+    return d;
+}
+
+template <typename T>
+DataValue value_of(T v) {
+    DataValue value;
+    value.value = v;
+    value.quality = 1;
+    value.timestamp_ms = 1234;
+    return value;
+}
+
+/**
+ * 查找一组标签，返回未命中的下标
+ */
+std::vector<size_t> lookup(LastValueCache& cache, const std::vector<TagDescriptor>& tags,
+                           std::vector<DataValue>& values, milliseconds max_age = milliseconds(60000)) {
+    std::vector<StatusCode> results(tags.size(), StatusCode::OK);
+    std::vector<size_t> misses;
+    values.assign(tags.size(), DataValue());
+    cache.lookup(tags, results, max_age, values, misses);
+    return misses;
+}
+
+/**
+ * 只缓存结果为 OK 的标签；命中的值与时间戳、质量一并还原，并累计命中数
+ */
+void test_store_lookup() {
+    LastValueCache cache;
+    std::vector<TagDescriptor> tags = {descriptor({{"register_address", "10"}, {"data_type", "float32"}}),
+                                       descriptor({{"register_address", "20"}}),
+                                       descriptor({{"register_address", "30"}})};
+    std::vector<DataValue> values = {value_of(1.5f), value_of(int32_t(7)), value_of(int32_t(9))};
+    cache.store(tags, values, {StatusCode::OK, StatusCode::OK, StatusCode::Timeout});
+    CHECK(cache.size() == 2);
+
+    std::vector<DataValue> out;
+    CHECK((lookup(cache, tags, out) == std::vector<size_t>{2}));
+    CHECK(std::get<float>(out[0].value) == 1.5f && out[0].quality == 1 && out[0].timestamp_ms == 1234);
+    CHECK(std::get<int32_t>(out[1].value) == 7);
+    CHECK(cache.hits() == 2 && cache.misses() == 1);
+
+    std::vector<StatusCode> results = {StatusCode::InvalidParam, StatusCode::OK, StatusCode::OK};
+    std::vector<size_t> misses;
+    cache.lookup(tags, results, milliseconds(60000), out, misses);
+    CHECK((misses == std::vector<size_t>{2})); // 编译失败的标签既不命中也不计为未命中
+}
+
+/**
+ * 按下标部分写入；同一地址的不同解释是不同的缓存项，同一点位的不同写法共享缓存项
+ */
+void test_keys() {
+    LastValueCache cache;
+    std::vector<TagDescriptor> tags = {descriptor({{"register_address", "10"}, {"data_type", "int16"}}),
+                                       descriptor({{"register_address", "10"}, {"data_type", "uint16"}}),
+                                       descriptor({{"register_address", "10"}, {"bit", "3"}}),
+                                       descriptor({{"register_address", "10"}, {"slave_id", "2"}})};
+    std::vector<DataValue> values = {value_of(int32_t(-1)), value_of(uint32_t(65535)), value_of(true),
+                                     value_of(int32_t(5))};
+    std::vector<StatusCode> results(tags.size(), StatusCode::OK);
+    cache.store(tags, values, results, {0, 2});
+    CHECK(cache.size() == 2);
+
+    std::vector<DataValue> out;
+    CHECK((lookup(cache, tags, out) == std::vector<size_t>{1, 3}));
+    CHECK(std::get<int32_t>(out[0].value) == -1 && std::get<bool>(out[2].value));
+
+    std::vector<TagDescriptor> alias = {descriptor({{"address", "40011"}, {"data_type", "int16"}})};
+    CHECK(lookup(cache, alias, out).empty());
+    CHECK(std::get<int32_t>(out[0].value) == -1);
+}
+
+/**
+ * 超过 max_age 的缓存项视为未命中
+ */
+void test_max_age() {
+    LastValueCache cache;
+    std::vector<TagDescriptor> tags = {descriptor({{"register_address", "0"}})};
+    cache.store(tags, {value_of(int32_t(1))}, {StatusCode::OK});
+    std::this_thread::sleep_for(milliseconds(20));
+
+    std::vector<DataValue> out;
+    CHECK((lookup(cache, tags, out, milliseconds(5)) == std::vector<size_t>{0}));
+    CHECK(lookup(cache, tags, out, milliseconds(10000)).empty());
+}
+
+/**
+ * 写入失效：回溯覆盖起点在写入范围之前的多寄存器标签，只影响同一从站的同一数据表
+ */
+void test_invalidate() {
+    LastValueCache cache;
+    std::vector<TagDescriptor> tags = {
+        descriptor({{"register_address", "8"}, {"data_type", "float64"}}),   // 8..11
+        descriptor({{"register_address", "12"}, {"data_type", "float32"}}),  // 12..13
+        descriptor({{"register_address", "14"}}),
+        descriptor({{"register_address", "12"}, {"slave_id", "2"}}),
+        descriptor({{"register_address", "12"}, {"function_code", "4"}}),
+        descriptor({{"register_address", "12"}, {"function_code", "1"}}),
+    };
+    std::vector<DataValue> values = {value_of(1.0), value_of(2.0f), value_of(int32_t(3)), value_of(int32_t(4)),
+                                     value_of(int32_t(5)), value_of(true)};
+    std::vector<StatusCode> results(tags.size(), StatusCode::OK);
+    std::vector<DataValue> out;
+
+    cache.store(tags, values, results);
+    cache.invalidate(1, false, 11, 2); // 覆盖 float64 的最后一个寄存器与 float32 的第一个寄存器
+    CHECK((lookup(cache, tags, out) == std::vector<size_t>{0, 1}));
+
+    cache.store(tags, values, results);
+    cache.invalidate(1, false, 15, 1);
+    CHECK(lookup(cache, tags, out).empty());
+
+    cache.invalidate(1, true, 12, 1);
+    CHECK((lookup(cache, tags, out) == std::vector<size_t>{5}));
+
+    cache.clear();
+    CHECK(cache.size() == 0);
+}
+
+/**
+ * 字符串值无法以紧凑形式保存，不缓存
+ */
+void test_strings() {
+    LastValueCache cache;
+    std::vector<TagDescriptor> tags = {descriptor({{"register_address", "0"}})};
+    cache.store(tags, {value_of(std::string("text"))}, {StatusCode::OK});
+    CHECK(cache.size() == 0);
+}
+
+} // namespace
+
+int main() {
+    test_store_lookup();
+    test_keys();
+    test_max_age();
+    test_invalidate();
+    test_strings();
+    std::cout << "LastValueCacheTest passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,183 @@
+#include "ModbusRtuTransport.hpp"
+#include <southbound/TestCheck.hpp>
+#include <modbus/modbus.h>
+#include <cerrno>
+#include <cstdlib>
+#include <fcntl.h>
+#include <iostream>
+#include <poll.h>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+using namespace southbound;
+
+namespace {
+
+/**
+ * 逐位计算的 CRC16，作为查表法的对照
+ */
+uint16_t reference_crc16(const uint8_t* data, size_t length) {
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < length; ++i) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 1) ? static_cast<uint16_t>((crc >> 1) ^ 0xA001) : static_cast<uint16_t>(crc >> 1);
+        }
+    }
+    return crc;
+}
+
+/**
+ * 追加 CRC（低字节在前）
+ */
+std::vector<uint8_t> with_crc(std::vector<uint8_t> frame) {
+    uint16_t crc = ModbusRtuTransport::crc16(frame.data(), frame.size());
+    frame.push_back(static_cast<uint8_t>(crc & 0xFF));
+    frame.push_back(static_cast<uint8_t>(crc >> 8));
+    return frame;
+}
+
+/**
+ * @brief pty 主端上的假从站
+ * 每个事务先由 expect() 登记请求长度与应答，再由传输发起；finish() 返回收到的请求帧。
+ */
+class PtySlave {
+public:
+    PtySlave() {
+        m_master = posix_openpt(O_RDWR | O_NOCTTY);
+        CHECK(m_master >= 0 && grantpt(m_master) == 0 && unlockpt(m_master) == 0);
+        m_path = ptsname(m_master);
+    }
+
+    ~PtySlave() { close(m_master); }
+
+    const std::string& path() const { return m_path; }
+
+    void expect(size_t request_length, std::vector<uint8_t> response) {
+        m_request.clear();
+        m_thread = std::thread([this, request_length, response] {
+            while (m_request.size() < request_length) {
+                struct pollfd pfd = {m_master, POLLIN, 0};
+                if (poll(&pfd, 1, 1000) <= 0) {
+                    return;
+                }
+                uint8_t buffer[MODBUS_RTU_MAX_ADU_LENGTH];
+                ssize_t n = read(m_master, buffer, sizeof(buffer));
+                if (n <= 0) {
+                    return;
+                }
+                m_request.insert(m_request.end(), buffer, buffer + n);
+            }
+            if (!response.empty()) {
+                CHECK(write(m_master, response.data(), response.size()) == static_cast<ssize_t>(response.size()));
+            }
+        });
+    }
+
+    std::vector<uint8_t> finish() {
+        m_thread.join();
+        return m_request;
+    }
+
+private:
+    int m_master{-1};
+    std::string m_path;
+    std::thread m_thread;
+    std::vector<uint8_t> m_request;
+};
+
+/**
+ * CRC16：已知向量与逐位算法一致
+ */
+void test_crc16() {
+    const uint8_t frame[] = {0x01, 0x03, 0x00, 0x00, 0x00, 0x01};
+    CHECK(ModbusRtuTransport::crc16(frame, sizeof(frame)) == 0x0A84);
+    CHECK(ModbusRtuTransport::crc16(frame, 0) == 0xFFFF);
+
+    std::vector<uint8_t> data(256);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>(i * 37 + 11);
+    }
+    for (size_t length = 1; length <= data.size(); length += 17) {
+        CHECK(ModbusRtuTransport::crc16(data.data(), length) == reference_crc16(data.data(), length));
+    }
+}
+
+/**
+ * 请求帧格式与正常应答解析：寄存器、位与写回显
+ */
+void test_transactions(PtySlave& slave, ModbusRtuTransport& transport) {
+    uint16_t registers[2] = {};
+    slave.expect(8, with_crc({0x11, 0x03, 0x04, 0x12, 0x34, 0xAB, 0xCD}));
+    CHECK(transport.read_registers(0x11, 3, 10, 2, registers) == 2);
+    CHECK(slave.finish() == with_crc({0x11, 0x03, 0x00, 0x0A, 0x00, 0x02}));
+    CHECK(registers[0] == 0x1234 && registers[1] == 0xABCD);
+
+    uint8_t bits[10] = {};
+    slave.expect(8, with_crc({0x01, 0x02, 0x02, 0xA5, 0x02}));
+    CHECK(transport.read_bits(1, 2, 0, 10, bits) == 10);
+    CHECK(slave.finish() == with_crc({0x01, 0x02, 0x00, 0x00, 0x00, 0x0A}));
+    const uint8_t expected_bits[10] = {1, 0, 1, 0, 0, 1, 0, 1, 0, 1};
+    for (int i = 0; i < 10; ++i) {
+        CHECK(bits[i] == expected_bits[i]);
+    }
+
+    std::vector<uint8_t> write_request = with_crc({0x01, 0x06, 0x00, 0x05, 0xBE, 0xEF});
+    slave.expect(8, write_request);
+    CHECK(transport.write_register(1, 5, 0xBEEF) == 1);
+    CHECK(slave.finish() == write_request);
+
+    slave.expect(8, {}); // 广播不等待应答
+    CHECK(transport.write_register(MODBUS_BROADCAST_ADDRESS, 5, 1) == 1);
+    CHECK(slave.finish() == with_crc({0x00, 0x06, 0x00, 0x05, 0x00, 0x01}));
+}
+
+/**
+ * 错误应答：异常码、CRC 错误、从站地址不符、功能码不符与超时，errno 与 libmodbus 一致
+ */
+void test_errors(PtySlave& slave, ModbusRtuTransport& transport) {
+    uint16_t registers[2] = {};
+
+    slave.expect(8, with_crc({0x01, 0x83, 0x02}));
+    CHECK(transport.read_registers(1, 3, 0, 2, registers) == -1 && errno == EMBXILADD);
+    slave.finish();
+
+    std::vector<uint8_t> corrupted = with_crc({0x01, 0x03, 0x04, 0x00, 0x01, 0x00, 0x02});
+    corrupted.back() ^= 0xFF;
+    slave.expect(8, corrupted);
+    CHECK(transport.read_registers(1, 3, 0, 2, registers) == -1 && errno == EMBBADCRC);
+    slave.finish();
+
+    slave.expect(8, with_crc({0x02, 0x03, 0x04, 0x00, 0x01, 0x00, 0x02}));
+    CHECK(transport.read_registers(1, 3, 0, 2, registers) == -1 && errno == EMBBADDATA);
+    slave.finish();
+
+    slave.expect(8, with_crc({0x01, 0x04, 0x04, 0x00, 0x01, 0x00, 0x02}));
+    CHECK(transport.read_registers(1, 3, 0, 2, registers) == -1 && errno == EMBBADDATA);
+    slave.finish();
+
+    slave.expect(8, {});
+    CHECK(transport.read_registers(1, 3, 0, 2, registers) == -1 && errno == ETIMEDOUT);
+    slave.finish();
+
+    CHECK(transport.read_registers(1, 3, 0, 0, registers) == -1 && errno == EMBMDATA);
+}
+
+} // namespace
+
+int main() {
+    test_crc16();
+
+    PtySlave slave;
+    ModbusRtuTransport transport;
+    CHECK(transport.open(slave.path(), 115200, 'N', 8, 1) == 0);
+    transport.set_response_timeout(std::chrono::milliseconds(100));
+    test_transactions(slave, transport);
+    test_errors(slave, transport);
+    transport.close();
+    CHECK(!transport.is_open());
+
+    std::cout << "ModbusRtuTransportTest passed" << std::endl;
+    return 0;
+}
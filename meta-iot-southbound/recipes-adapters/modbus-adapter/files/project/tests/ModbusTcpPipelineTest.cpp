@@ -0,0 +1,268 @@
+#include "ModbusTcpPipeline.hpp"
+#include <southbound/TestCheck.hpp>
+#include <modbus/modbus.h>
+#include <cerrno>
+#include <functional>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include <sys/socket.h>
+#include <unistd.h>
+
+using namespace southbound;
+
+namespace {
+
+/**
+ * @brief 收到的一条读请求（MBAP + PDU）
+ */
+struct Frame {
+    uint16_t transaction_id;
+    uint8_t slave_id;
+    uint8_t function_code;
+    uint16_t address;
+    uint16_t count;
+};
+
+/**
+ * @brief socketpair 上的假服务器
+ * 每收满 batch 条请求调用一次 respond，由其决定应答的顺序与内容；共收 total 条后退出。
+ */
+class FakeServer {
+public:
+    using Respond = std::function<void(int socket, std::vector<Frame>& batch)>;
+
+    FakeServer(size_t batch, size_t total, Respond respond) {
+        CHECK(socketpair(AF_UNIX, SOCK_STREAM, 0, m_fds) == 0);
+        m_thread = std::thread([this, batch, total, respond] { serve(batch, total, respond); });
+    }
+
+    ~FakeServer() {
+        m_thread.join();
+        close(m_fds[0]);
+        if (m_fds[1] >= 0) {
+            close(m_fds[1]);
+        }
+    }
+
+    int client() const { return m_fds[0]; }
+
+private:
+    int m_fds[2]{-1, -1};
+    std::thread m_thread;
+
+    void serve(size_t batch, size_t total, const Respond& respond) {
+        std::vector<Frame> frames;
+        for (size_t received = 0; received < total; ++received) {
+            uint8_t request[12];
+            size_t length = 0;
+            while (length < sizeof(request)) {
+                ssize_t n = read(m_fds[1], request + length, sizeof(request) - length);
+                if (n <= 0) {
+                    return;
+                }
+                length += static_cast<size_t>(n);
+            }
+            frames.push_back(Frame{static_cast<uint16_t>((request[0] << 8) | request[1]), request[6], request[7],
+                                   static_cast<uint16_t>((request[8] << 8) | request[9]),
+                                   static_cast<uint16_t>((request[10] << 8) | request[11])});
+            if (frames.size() == batch || received + 1 == total) {
+                respond(m_fds[1], frames);
+                frames.clear();
+            }
+        }
+    }
+};
+
+/**
+ * 发送一条应答 ADU
+ */
+void send_adu(int socket, uint16_t transaction_id, uint8_t slave_id, const std::vector<uint8_t>& pdu) {
+    std::vector<uint8_t> adu{static_cast<uint8_t>(transaction_id >> 8), static_cast<uint8_t>(transaction_id), 0, 0,
+                             static_cast<uint8_t>((pdu.size() + 1) >> 8), static_cast<uint8_t>(pdu.size() + 1),
+                             slave_id};
+    adu.insert(adu.end(), pdu.begin(), pdu.end());
+    CHECK(write(socket, adu.data(), adu.size()) == static_cast<ssize_t>(adu.size()));
+}
+
+/**
+ * 正常应答：寄存器值为地址本身，位为地址的奇偶；地址 999 以非法地址异常应答
+ */
+void answer(int socket, const Frame& frame) {
+    if (frame.address == 999) {
+        send_adu(socket, frame.transaction_id, frame.slave_id,
+                 {static_cast<uint8_t>(frame.function_code | 0x80), 0x02});
+        return;
+    }
+    std::vector<uint8_t> pdu{frame.function_code};
+    if (frame.function_code == 1 || frame.function_code == 2) {
+        pdu.push_back(static_cast<uint8_t>((frame.count + 7) / 8));
+        pdu.resize(2 + (frame.count + 7) / 8, 0);
+        for (uint16_t i = 0; i < frame.count; ++i) {
+            if ((frame.address + i) % 2) {
+                pdu[2 + i / 8] |= static_cast<uint8_t>(1 << (i % 8));
+            }
+        }
+    } else {
+        pdu.push_back(static_cast<uint8_t>(frame.count * 2));
+        for (uint16_t i = 0; i < frame.count; ++i) {
+            uint16_t value = static_cast<uint16_t>(frame.address + i);
+            pdu.push_back(static_cast<uint8_t>(value >> 8));
+            pdu.push_back(static_cast<uint8_t>(value));
+        }
+    }
+    send_adu(socket, frame.transaction_id, frame.slave_id, pdu);
+}
+
+PipelineRequest read_request(uint8_t function_code, uint16_t address, uint16_t count, uint16_t* registers,
+                             uint8_t* bits = nullptr) {
+    PipelineRequest request;
+    request.function_code = function_code;
+    request.address = address;
+    request.count = count;
+    request.registers = registers;
+    request.bits = bits;
+    return request;
+}
+
+/**
+ * 多个事务在途、应答乱序且夹杂未知事务号时，按事务号匹配到各自的请求
+ */
+void test_out_of_order() {
+    const size_t depth = 4;
+    const size_t total = 8;
+    FakeServer server(depth, total, [](int socket, std::vector<Frame>& batch) {
+        send_adu(socket, 0xBEEF, 1, {3, 2, 0xDE, 0xAD}); // 已超时事务的迟到应答
+        for (auto it = batch.rbegin(); it != batch.rend(); ++it) {
+            answer(socket, *it);
+        }
+    });
+
+    std::vector<uint16_t> registers(total * 2);
+    std::vector<PipelineRequest> requests;
+    for (size_t i = 0; i < total; ++i) {
+        requests.push_back(read_request(i % 2 ? 4 : 3, static_cast<uint16_t>(i * 10), 2, &registers[i * 2]));
+    }
+
+    ModbusTcpPipeline pipeline(depth);
+    CHECK(pipeline.execute(server.client(), requests));
+    for (size_t i = 0; i < total; ++i) {
+        CHECK(requests[i].result == 2 && requests[i].error == 0);
+        CHECK(registers[i * 2] == i * 10 && registers[i * 2 + 1] == i * 10 + 1);
+    }
+    CHECK(pipeline.depth() == static_cast<int>(depth));
+    CHECK(!pipeline.had_timeout());
+}
+
+/**
+ * 位读取按位解包；异常应答只使对应请求失败，错误码与 libmodbus 一致
+ */
+void test_bits_and_exception() {
+    FakeServer server(2, 2, [](int socket, std::vector<Frame>& batch) {
+        answer(socket, batch[1]);
+        answer(socket, batch[0]);
+    });
+
+    uint8_t bits[10] = {};
+    uint16_t registers[1] = {};
+    std::vector<PipelineRequest> requests{read_request(1, 5, 10, nullptr, bits), read_request(3, 999, 1, registers)};
+
+    ModbusTcpPipeline pipeline(2);
+    CHECK(!pipeline.execute(server.client(), requests));
+    CHECK(requests[0].result == 10);
+    for (int i = 0; i < 10; ++i) {
+        CHECK(bits[i] == (5 + i) % 2);
+    }
+    CHECK(requests[1].result == -1 && requests[1].error == EMBXILADD);
+    CHECK(pipeline.depth() == 2 && !pipeline.had_timeout());
+}
+
+/**
+ * 多个事务在途时超时：各自以 ETIMEDOUT 失败，退回深度 1，reset() 后恢复
+ */
+void test_timeout_fallback() {
+    FakeServer server(2, 2, [](int, std::vector<Frame>&) {});
+
+    uint16_t registers[2] = {};
+    std::vector<PipelineRequest> requests{read_request(3, 0, 1, &registers[0]), read_request(3, 1, 1, &registers[1])};
+
+    ModbusTcpPipeline pipeline(2);
+    pipeline.set_response_timeout(std::chrono::milliseconds(50));
+    CHECK(!pipeline.execute(server.client(), requests));
+    CHECK(requests[0].error == ETIMEDOUT && requests[1].error == ETIMEDOUT);
+    CHECK(pipeline.had_timeout());
+    CHECK(pipeline.depth() == 1);
+    pipeline.reset();
+    CHECK(pipeline.depth() == 2);
+}
+
+/**
+ * 事务号对上而单元标识不符的应答只使对应请求以 EMBBADDATA 失败
+ */
+void test_unit_id_mismatch() {
+    FakeServer server(2, 2, [](int socket, std::vector<Frame>& batch) {
+        Frame other = batch[0];
+        other.slave_id = static_cast<uint8_t>(other.slave_id + 1);
+        answer(socket, other);
+        answer(socket, batch[1]);
+    });
+
+    uint16_t registers[2] = {};
+    std::vector<PipelineRequest> requests{read_request(3, 0, 1, &registers[0]), read_request(3, 1, 1, &registers[1])};
+
+    ModbusTcpPipeline pipeline(2);
+    CHECK(!pipeline.execute(server.client(), requests));
+    CHECK(requests[0].result == -1 && requests[0].error == EMBBADDATA);
+    CHECK(requests[1].result == 1 && registers[1] == 1);
+    CHECK(pipeline.depth() == 2 && !pipeline.had_timeout());
+}
+
+/**
+ * 帧错位（MBAP 长度非法）：在途与未发送的请求都以 EMBBADDATA 失败
+ */
+void test_framing_error() {
+    FakeServer server(1, 1, [](int socket, std::vector<Frame>& batch) {
+        const uint8_t adu[7] = {static_cast<uint8_t>(batch[0].transaction_id >> 8),
+                                static_cast<uint8_t>(batch[0].transaction_id), 0, 0, 0, 0, 1};
+        CHECK(write(socket, adu, sizeof(adu)) == static_cast<ssize_t>(sizeof(adu)));
+    });
+
+    uint16_t registers[2] = {};
+    std::vector<PipelineRequest> requests{read_request(3, 0, 1, &registers[0]), read_request(3, 1, 1, &registers[1])};
+
+    ModbusTcpPipeline pipeline(1);
+    CHECK(!pipeline.execute(server.client(), requests));
+    CHECK(requests[0].error == EMBBADDATA && requests[1].error == EMBBADDATA);
+    CHECK(pipeline.had_timeout());
+}
+
+/**
+ * 对端关闭连接：在途与未发送的请求都失败
+ */
+void test_connection_closed() {
+    FakeServer server(1, 1, [](int socket, std::vector<Frame>&) { shutdown(socket, SHUT_RDWR); });
+
+    uint16_t registers[3] = {};
+    std::vector<PipelineRequest> requests{read_request(3, 0, 1, &registers[0]), read_request(3, 1, 1, &registers[1]),
+                                          read_request(3, 2, 1, &registers[2])};
+
+    ModbusTcpPipeline pipeline(1);
+    CHECK(!pipeline.execute(server.client(), requests));
+    for (const PipelineRequest& request : requests) {
+        CHECK(request.result == -1 && request.error == ECONNRESET);
+    }
+    CHECK(pipeline.had_timeout());
+}
+
+} // namespace
+
+int main() {
+    test_out_of_order();
+    test_bits_and_exception();
+    test_timeout_fallback();
+    test_unit_id_mismatch();
+    test_framing_error();
+    test_connection_closed();
+    std::cout << "ModbusTcpPipelineTest passed" << std::endl;
+    return 0;
+}
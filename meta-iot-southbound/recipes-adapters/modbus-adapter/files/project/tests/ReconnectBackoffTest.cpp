@@ -0,0 +1,87 @@
+#include "ReconnectBackoff.hpp"
+#include <southbound/TestCheck.hpp>
+#include <iostream>
+#include <set>
+
+using namespace southbound;
+using std::chrono::milliseconds;
+
+namespace {
+
+/**
+ * 每次等待在 [min_delay, min(max_delay, 上次 × 3)] 内，并能增长到上限
+ */
+void test_bounds() {
+    ReconnectBackoff backoff;
+    backoff.configure(milliseconds(100), milliseconds(5000));
+
+    for (int run = 0; run < 100; ++run) {
+        backoff.reset();
+        milliseconds previous(100);
+        milliseconds largest(0);
+        for (int i = 0; i < 50; ++i) {
+            milliseconds delay = backoff.next();
+            CHECK(delay >= milliseconds(100));
+            CHECK(delay <= std::min(milliseconds(5000), previous * 3));
+            largest = std::max(largest, delay);
+            previous = delay;
+        }
+        CHECK(largest > milliseconds(300));
+    }
+}
+
+/**
+ * reset() 后第一次等待回到 [min_delay, 3 × min_delay]
+ */
+void test_reset() {
+    ReconnectBackoff backoff;
+    backoff.configure(milliseconds(100), milliseconds(5000));
+    for (int i = 0; i < 20; ++i) {
+        backoff.next();
+    }
+    backoff.reset();
+    milliseconds delay = backoff.next();
+    CHECK(delay >= milliseconds(100) && delay <= milliseconds(300));
+}
+
+/**
+ * 抖动：多个实例的等待序列互不相同
+ */
+void test_jitter() {
+    std::set<int64_t> first_delays;
+    for (int i = 0; i < 20; ++i) {
+        ReconnectBackoff backoff;
+        backoff.configure(milliseconds(100), milliseconds(5000));
+        int64_t sum = 0;
+        for (int k = 0; k < 5; ++k) {
+            sum = sum * 7 + backoff.next().count();
+        }
+        first_delays.insert(sum);
+    }
+    CHECK(first_delays.size() > 1);
+}
+
+/**
+ * 范围修正：最短等待至少 1 毫秒，最长等待不小于最短等待
+ */
+void test_configure_limits() {
+    ReconnectBackoff backoff;
+    backoff.configure(milliseconds(500), milliseconds(200));
+    for (int i = 0; i < 10; ++i) {
+        CHECK(backoff.next() == milliseconds(500));
+    }
+
+    backoff.configure(milliseconds(0), milliseconds(0));
+    CHECK(backoff.next() == milliseconds(1));
+}
+
+} // namespace
+
+int main() {
+    test_bounds();
+    test_reset();
+    test_jitter();
+    test_configure_limits();
+    std::cout << "ReconnectBackoffTest passed" << std::endl;
+    return 0;
+}
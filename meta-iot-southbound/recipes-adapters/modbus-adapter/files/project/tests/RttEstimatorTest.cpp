@@ -0,0 +1,106 @@
+#include "RttEstimator.hpp"
+#include <southbound/TestCheck.hpp>
+#include <iostream>
+
+using namespace southbound;
+using std::chrono::microseconds;
+
+namespace {
+
+/**
+ * 尚无样本时超时取上限
+ */
+void test_initial() {
+    RttEstimator estimator;
+    estimator.configure(microseconds(20000), microseconds(500000));
+    CHECK(estimator.timeout() == microseconds(500000));
+    CHECK(estimator.srtt() == microseconds(0) && estimator.rttvar() == microseconds(0));
+}
+
+/**
+ * RFC 6298：首个样本 SRTT = R、RTTVAR = R/2，之后按 1/8 与 1/4 平滑，超时为 SRTT + 4 × RTTVAR
+ */
+void test_samples() {
+    RttEstimator estimator;
+    estimator.configure(microseconds(1000), microseconds(1000000));
+
+    estimator.sample(microseconds(10000));
+    CHECK(estimator.srtt() == microseconds(10000) && estimator.rttvar() == microseconds(5000));
+    CHECK(estimator.timeout() == microseconds(30000));
+
+    estimator.sample(microseconds(20000));
+    CHECK(estimator.rttvar() == microseconds((5000 * 3 + 10000) / 4));
+    CHECK(estimator.srtt() == microseconds((10000 * 7 + 20000) / 8));
+    CHECK(estimator.timeout() == microseconds(11250 + 4 * 6250));
+
+    for (int i = 0; i < 200; ++i) {
+        estimator.sample(microseconds(8000));
+    }
+    CHECK(estimator.srtt() >= microseconds(8000) && estimator.srtt() <= microseconds(8010));
+    CHECK(estimator.rttvar() <= microseconds(10));
+    CHECK(estimator.timeout() == estimator.srtt() + microseconds(1000)); // RTTVAR 项不低于时钟粒度
+}
+
+/**
+ * 超时限制在 [min_timeout, max_timeout] 内；负样本按 0 处理
+ */
+void test_clamp() {
+    RttEstimator estimator;
+    estimator.configure(microseconds(20000), microseconds(100000));
+    estimator.sample(microseconds(100));
+    CHECK(estimator.timeout() == microseconds(20000));
+    estimator.sample(microseconds(-5000));
+    CHECK(estimator.srtt() < microseconds(100));
+
+    estimator.configure(microseconds(20000), microseconds(100000));
+    estimator.sample(microseconds(90000));
+    CHECK(estimator.timeout() == microseconds(100000));
+}
+
+/**
+ * Karn：超时后超时值加倍直到上限，下一个有效样本恢复按估计值计算
+ */
+void test_backoff() {
+    RttEstimator estimator;
+    estimator.configure(microseconds(1000), microseconds(100000));
+    estimator.sample(microseconds(10000));
+    CHECK(estimator.timeout() == microseconds(30000));
+
+    estimator.backoff();
+    CHECK(estimator.timeout() == microseconds(60000));
+    estimator.backoff();
+    CHECK(estimator.timeout() == microseconds(100000));
+    estimator.backoff();
+    CHECK(estimator.timeout() == microseconds(100000));
+    CHECK(estimator.srtt() == microseconds(10000));
+
+    estimator.sample(microseconds(10000));
+    CHECK(estimator.timeout() == microseconds(10000 + 4 * 3750));
+}
+
+/**
+ * 范围修正：下限不低于时钟粒度，上限不低于下限；重新配置清空样本
+ */
+void test_configure_limits() {
+    RttEstimator estimator;
+    estimator.configure(microseconds(0), microseconds(0));
+    CHECK(estimator.timeout() == microseconds(1000));
+    CHECK(estimator.max_timeout() == microseconds(1000));
+
+    estimator.configure(microseconds(5000), microseconds(50000));
+    estimator.sample(microseconds(1000));
+    estimator.configure(microseconds(5000), microseconds(50000));
+    CHECK(estimator.timeout() == microseconds(50000) && estimator.srtt() == microseconds(0));
+}
+
+} // namespace
+
+int main() {
+    test_initial();
+    test_samples();
+    test_clamp();
+    test_backoff();
+    test_configure_limits();
+    std::cout << "RttEstimatorTest passed" << std::endl;
+    return 0;
+}
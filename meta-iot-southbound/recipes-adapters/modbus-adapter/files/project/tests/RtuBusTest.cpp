@@ -0,0 +1,141 @@
+#include "RtuBus.hpp"
+#include <southbound/TestCheck.hpp>
+#include <fcntl.h>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+using namespace southbound;
+
+namespace {
+
+RtuSettings settings(const std::string& device_path, int baudrate = 115200) {
+    RtuSettings result;
+    result.device_path = device_path;
+    result.baudrate = baudrate;
+    return result;
+}
+
+/**
+ * 同一串口共享一个总线，串口参数不一致时拒绝；全部释放后重新创建
+ */
+void test_acquire() {
+    StatusCode result = StatusCode::Error;
+    std::shared_ptr<RtuBus> first = RtuBus::acquire(settings("/dev/ttyTEST0"), result);
+    CHECK(first && result == StatusCode::OK);
+    std::shared_ptr<RtuBus> second = RtuBus::acquire(settings("/dev/ttyTEST0"), result);
+    CHECK(second == first && result == StatusCode::OK);
+
+    CHECK(!RtuBus::acquire(settings("/dev/ttyTEST0", 9600), result));
+    CHECK(result == StatusCode::BadConfig);
+
+    std::shared_ptr<RtuBus> other = RtuBus::acquire(settings("/dev/ttyTEST1", 9600), result);
+    CHECK(other && other != first && result == StatusCode::OK);
+
+    first.reset();
+    second.reset();
+    std::shared_ptr<RtuBus> again = RtuBus::acquire(settings("/dev/ttyTEST0", 9600), result); // 新参数生效
+    CHECK(again && result == StatusCode::OK);
+}
+
+/**
+ * 帧间静默：3.5 个字符时间，波特率高于 19200 时固定 1750 微秒
+ */
+void test_silence() {
+    StatusCode result = StatusCode::Error;
+    std::shared_ptr<RtuBus> slow = RtuBus::acquire(settings("/dev/ttyTEST2", 9600), result);
+    CHECK(slow && slow->silence() == std::chrono::microseconds(10 * 3500000 / 9600));
+
+    RtuSettings even = settings("/dev/ttyTEST3", 19200);
+    even.parity = 'E';
+    std::shared_ptr<RtuBus> parity = RtuBus::acquire(even, result);
+    CHECK(parity && parity->silence() == std::chrono::microseconds(11 * 3500000 / 19200));
+
+    std::shared_ptr<RtuBus> fast = RtuBus::acquire(settings("/dev/ttyTEST4", 115200), result);
+    CHECK(fast && fast->silence() == std::chrono::microseconds(1750));
+}
+
+/**
+ * 总线占用期间排队的事务：高优先级先于普通事务，同一优先级先来先服务；两个事务之间满足帧间静默
+ */
+void test_lock_order() {
+    StatusCode result = StatusCode::Error;
+    std::shared_ptr<RtuBus> bus = RtuBus::acquire(settings("/dev/ttyTEST5", 9600), result);
+    CHECK(bus);
+
+    std::mutex order_mutex;
+    std::vector<int> order;
+    std::vector<std::chrono::steady_clock::time_point> acquired;
+    std::vector<std::thread> waiters;
+
+    bus->lock(false);
+    auto enqueue = [&](int id, bool urgent) {
+        waiters.emplace_back([&, id, urgent] {
+            bus->lock(urgent);
+            {
+                std::lock_guard<std::mutex> lock(order_mutex);
+                order.push_back(id);
+                acquired.push_back(std::chrono::steady_clock::now());
+            }
+            bus->unlock();
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(50)); // 保证入队顺序
+    };
+    enqueue(1, false);
+    enqueue(2, true);
+    enqueue(3, false);
+    enqueue(4, true);
+    std::chrono::steady_clock::time_point released = std::chrono::steady_clock::now();
+    bus->unlock();
+    for (std::thread& waiter : waiters) {
+        waiter.join();
+    }
+
+    CHECK((order == std::vector<int>{2, 4, 1, 3}));
+    CHECK(acquired[0] - released >= bus->silence());
+    for (size_t i = 1; i < acquired.size(); ++i) {
+        CHECK(acquired[i] - acquired[i - 1] >= bus->silence());
+    }
+}
+
+/**
+ * 串口按引用计数打开：首个 open() 真正打开，最后一个 close() 关闭
+ */
+void test_open_count() {
+    int master = posix_openpt(O_RDWR | O_NOCTTY);
+    CHECK(master >= 0 && grantpt(master) == 0 && unlockpt(master) == 0);
+
+    RtuSettings native = settings(ptsname(master));
+    native.native = true;
+    StatusCode result = StatusCode::Error;
+    std::shared_ptr<RtuBus> bus = RtuBus::acquire(native, result);
+    CHECK(bus && bus->native() && !bus->native()->is_open());
+
+    CHECK(bus->open() == 0);
+    CHECK(bus->open() == 0);
+    CHECK(bus->native()->is_open());
+    bus->close();
+    CHECK(bus->native()->is_open());
+    bus->close();
+    CHECK(!bus->native()->is_open());
+    bus->close(); // 多余的 close() 不影响计数
+    CHECK(bus->open() == 0 && bus->native()->is_open());
+    bus->close();
+    CHECK(!bus->native()->is_open());
+
+    ::close(master);
+}
+
+} // namespace
+
+int main() {
+    test_acquire();
+    test_silence();
+    test_lock_order();
+    test_open_count();
+    std::cout << "RtuBusTest passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,124 @@
+#include "ScanPlanner.hpp"
+#include <southbound/TestCheck.hpp>
+#include <iostream>
+#include <vector>
+
+using namespace southbound;
+
+namespace {
+
+TagDescriptor tag(int slave_id, int function_code, int address, int count = 1) {
+    TagDescriptor descriptor;
+    descriptor.slave_id = static_cast<uint8_t>(slave_id);
+    descriptor.function_code = static_cast<uint8_t>(function_code);
+    descriptor.address = static_cast<uint16_t>(address);
+    descriptor.count = static_cast<uint16_t>(count);
+    return descriptor;
+}
+
+/**
+ * 相邻寄存器合并为一块，items 按地址排列并保留输入下标
+ */
+void test_adjacent_merge() {
+    std::vector<TagDescriptor> tags{tag(1, 3, 12, 2), tag(1, 3, 10, 2), tag(1, 3, 14)};
+    std::vector<ScanBlock> blocks = ScanPlanner().plan(tags);
+    CHECK(blocks.size() == 1);
+    CHECK(blocks[0].slave_id == 1 && blocks[0].function_code == 3);
+    CHECK(blocks[0].start_address == 10 && blocks[0].count == 5);
+    CHECK((blocks[0].items == std::vector<size_t>{1, 0, 2}));
+}
+
+/**
+ * 间隔不超过 register_gap 时多读空闲寄存器合并，超过时另起一块
+ */
+void test_gap_tolerance() {
+    ScanPlannerOptions options;
+    options.register_gap = 4;
+    std::vector<TagDescriptor> tags{tag(1, 3, 0), tag(1, 3, 5), tag(1, 3, 11)};
+    std::vector<ScanBlock> blocks = ScanPlanner(options).plan(tags);
+    CHECK(blocks.size() == 2);
+    CHECK(blocks[0].start_address == 0 && blocks[0].count == 6);
+    CHECK(blocks[1].start_address == 11 && blocks[1].count == 1);
+
+    options.register_gap = 0;
+    CHECK(ScanPlanner(options).plan(tags).size() == 3);
+}
+
+/**
+ * 块长度不超过 max_registers，超出协议上限的配置被限制为 125
+ */
+void test_block_limit() {
+    std::vector<TagDescriptor> tags;
+    for (int address = 0; address < 130; ++address) {
+        tags.push_back(tag(1, 4, address));
+    }
+    ScanPlannerOptions options;
+    options.max_registers = 500;
+    ScanPlanner planner(options);
+    CHECK(planner.options().max_registers == 125);
+
+    std::vector<ScanBlock> blocks = planner.plan(tags);
+    CHECK(blocks.size() == 2);
+    CHECK(blocks[0].start_address == 0 && blocks[0].count == 125);
+    CHECK(blocks[1].start_address == 125 && blocks[1].count == 5);
+    CHECK(blocks[0].items.size() + blocks[1].items.size() == tags.size());
+}
+
+/**
+ * 不同从站或功能码不合并，块按从站、功能码、地址排序
+ */
+void test_grouping() {
+    std::vector<TagDescriptor> tags{tag(2, 3, 0), tag(1, 4, 1), tag(1, 3, 1), tag(1, 3, 0)};
+    std::vector<ScanBlock> blocks = ScanPlanner().plan(tags);
+    CHECK(blocks.size() == 3);
+    CHECK(blocks[0].slave_id == 1 && blocks[0].function_code == 3 && blocks[0].count == 2);
+    CHECK(blocks[1].slave_id == 1 && blocks[1].function_code == 4);
+    CHECK(blocks[2].slave_id == 2 && blocks[2].function_code == 3);
+}
+
+/**
+ * 位标签使用 bit_gap；写功能码的标签不参与规划
+ */
+void test_bits_and_writes() {
+    std::vector<TagDescriptor> tags{tag(1, 1, 0), tag(1, 1, 30), tag(1, 1, 100), tag(1, 5, 1), tag(1, 16, 2, 2)};
+    std::vector<ScanBlock> blocks = ScanPlanner().plan(tags);
+    CHECK(blocks.size() == 2);
+    CHECK(blocks[0].function_code == 1 && blocks[0].start_address == 0 && blocks[0].count == 31);
+    CHECK(blocks[1].start_address == 100 && blocks[1].count == 1);
+}
+
+/**
+ * 重叠的标签合并后覆盖两者的并集
+ */
+void test_overlap() {
+    std::vector<TagDescriptor> tags{tag(1, 3, 10), tag(1, 3, 10, 4), tag(1, 3, 12)};
+    std::vector<ScanBlock> blocks = ScanPlanner().plan(tags);
+    CHECK(blocks.size() == 1);
+    CHECK(blocks[0].start_address == 10 && blocks[0].count == 4);
+    CHECK(blocks[0].items.size() == 3);
+}
+
+/**
+ * 只为部分标签规划时 items 仍为完整列表中的下标
+ */
+void test_subset() {
+    std::vector<TagDescriptor> tags{tag(1, 3, 0), tag(1, 3, 50), tag(1, 3, 1), tag(1, 3, 51)};
+    std::vector<ScanBlock> blocks = ScanPlanner().plan(tags, {1, 3});
+    CHECK(blocks.size() == 1);
+    CHECK(blocks[0].start_address == 50 && blocks[0].count == 2);
+    CHECK((blocks[0].items == std::vector<size_t>{1, 3}));
+}
+
+} // namespace
+
+int main() {
+    test_adjacent_merge();
+    test_gap_tolerance();
+    test_block_limit();
+    test_grouping();
+    test_bits_and_writes();
+    test_overlap();
+    test_subset();
+    std::cout << "ScanPlannerTest passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,116 @@
+#include "ScanScheduler.hpp"
+#include <southbound/TestCheck.hpp>
+#include <iostream>
+#include <vector>
+
+using namespace southbound;
+
+namespace {
+
+/**
+ * 推进 ticks 个节拍，返回每个节拍的到期掩码
+ */
+std::vector<uint32_t> run(ScanScheduler& scheduler, size_t ticks) {
+    std::vector<uint32_t> due;
+    for (size_t i = 0; i < ticks; ++i) {
+        due.push_back(scheduler.advance());
+    }
+    return due;
+}
+
+/**
+ * 第 scan_class 个扫描类在 ticks 个节拍内的到期节拍序号
+ */
+std::vector<size_t> due_ticks(const std::vector<uint32_t>& due, size_t scan_class) {
+    std::vector<size_t> ticks;
+    for (size_t i = 0; i < due.size(); ++i) {
+        if (due[i] & (1u << scan_class)) {
+            ticks.push_back(i);
+        }
+    }
+    return ticks;
+}
+
+/**
+ * 节拍为各周期的最大公约数，所有扫描类在第一个节拍同时到期
+ */
+void test_tick() {
+    ScanScheduler scheduler;
+    scheduler.configure({100, 150});
+    CHECK(scheduler.tick() == std::chrono::milliseconds(50));
+    std::vector<uint32_t> due = run(scheduler, 7);
+    CHECK((due == std::vector<uint32_t>{0x3, 0x0, 0x1, 0x2, 0x1, 0x0, 0x3}));
+
+    scheduler.configure({1000});
+    CHECK(scheduler.tick() == std::chrono::milliseconds(1000));
+    CHECK((run(scheduler, 3) == std::vector<uint32_t>{0x1, 0x1, 0x1}));
+}
+
+/**
+ * 节拍不小于 MIN_TICK_MS，周期按节拍四舍五入且至少一个节拍
+ */
+void test_rounding() {
+    ScanScheduler scheduler;
+    scheduler.configure({25, 10, 0});
+    CHECK(scheduler.tick() == std::chrono::milliseconds(ScanScheduler::MIN_TICK_MS));
+    std::vector<uint32_t> due = run(scheduler, 7);
+    CHECK((due_ticks(due, 0) == std::vector<size_t>{0, 3, 6}));
+    CHECK(due_ticks(due, 1).size() == 7);
+    CHECK(due_ticks(due, 2).size() == 7);
+}
+
+/**
+ * 周期超过时间轮槽数的定时器按圈数等待，周期为槽数整数倍时留在原槽
+ */
+void test_rounds() {
+    const size_t slots = ScanScheduler::WHEEL_SLOTS;
+    ScanScheduler scheduler;
+    scheduler.configure({10, 10 * slots, 10 * (slots + 1), 10 * 3 * slots + 50});
+    std::vector<uint32_t> due = run(scheduler, 4 * slots + 1);
+
+    CHECK(due_ticks(due, 0).size() == due.size());
+    CHECK((due_ticks(due, 1) == std::vector<size_t>{0, slots, 2 * slots, 3 * slots, 4 * slots}));
+    CHECK((due_ticks(due, 2) == std::vector<size_t>{0, slots + 1, 2 * slots + 2, 3 * slots + 3}));
+    CHECK((due_ticks(due, 3) == std::vector<size_t>{0, 3 * slots + 5}));
+}
+
+/**
+ * 最多 MAX_CLASSES 个扫描类，多余的忽略；未配置或没有扫描类时不产生到期
+ */
+void test_limits() {
+    ScanScheduler scheduler;
+    CHECK(scheduler.advance() == 0);
+
+    scheduler.configure({});
+    CHECK((run(scheduler, 3) == std::vector<uint32_t>{0, 0, 0}));
+
+    std::vector<uint32_t> periods(ScanScheduler::MAX_CLASSES + 1, 100);
+    periods.back() = 10; // 被忽略，不参与节拍计算
+    scheduler.configure(periods);
+    CHECK(scheduler.tick() == std::chrono::milliseconds(100));
+    CHECK(scheduler.advance() == 0xFFFFFFFFu);
+    CHECK(scheduler.advance() == 0xFFFFFFFFu);
+}
+
+/**
+ * 重新配置后从头开始计时
+ */
+void test_reconfigure() {
+    ScanScheduler scheduler;
+    scheduler.configure({100, 300});
+    run(scheduler, 2);
+    scheduler.configure({100, 300});
+    CHECK((run(scheduler, 4) == std::vector<uint32_t>{0x3, 0x1, 0x1, 0x3}));
+}
+
+} // namespace
+
+int main() {
+    test_tick();
+    test_rounding();
+    test_rounds();
+    test_limits();
+    test_reconfigure();
+    std::cout << "ScanSchedulerTest passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,238 @@
+#include "TagDescriptor.hpp"
+#include <southbound/TestCheck.hpp>
+#include <iostream>
+#include <map>
+#include <string>
+
+using namespace southbound;
+
+namespace {
+
+StatusCode compile(const std::map<std::string, std::string>& attributes, TagDescriptor& descriptor,
+                   const TagDefaults& defaults = TagDefaults()) {
+    DeviceTag tag;
+    tag.attributes = attributes;
+    return compile_tag(tag, defaults, descriptor);
+}
+
+/**
+ * 适配器键写法：PDU 地址、功能码、数据类型与寄存器数量
+ */
+void test_adapter_keys() {
+    TagDescriptor d;
+    CHECK(compile({{"register_address", "100"}}, d) == StatusCode::OK);
+    CHECK(d.function_code == 3 && d.address == 100 && d.count == 1 && d.slave_id == 1);
+    CHECK(d.data_type == DataType::Register && d.decode != nullptr);
+
+    CHECK(compile({{"register_address", "7"}, {"function_code", "4"}, {"data_type", "float32"}, {"slave_id", "9"}}, d)
+          == StatusCode::OK);
+    CHECK(d.function_code == 4 && d.address == 7 && d.count == 2 && d.slave_id == 9);
+    CHECK(d.data_type == DataType::Float32);
+
+    CHECK(compile({{"register_address", "0"}, {"data_type", "double"}}, d) == StatusCode::OK);
+    CHECK(d.data_type == DataType::Float64 && d.count == 4);
+
+    CHECK(compile({{"register_address", "0"}, {"function_code", "1"}, {"register_count", "8"}}, d) == StatusCode::OK);
+    CHECK(d.is_bit() && d.is_packed_bits() && d.count == 8);
+}
+
+/**
+ * 配置文件写法：1 起的参考号、数据表前缀与 type
+ */
+void test_config_dialect() {
+    TagDescriptor d;
+    CHECK(compile({{"address", "40001"}, {"type", "holding"}, {"slave", "3"}}, d) == StatusCode::OK);
+    CHECK(d.function_code == 3 && d.address == 0 && d.slave_id == 3);
+
+    CHECK(compile({{"address", "30002"}}, d) == StatusCode::OK);
+    CHECK(d.function_code == 4 && d.address == 1);
+
+    CHECK(compile({{"address", "10005"}}, d) == StatusCode::OK);
+    CHECK(d.function_code == 2 && d.address == 4);
+
+    CHECK(compile({{"address", "400010"}}, d) == StatusCode::OK);
+    CHECK(d.function_code == 3 && d.address == 9);
+
+    CHECK(compile({{"address", "12"}}, d) == StatusCode::OK);
+    CHECK(d.function_code == 3 && d.address == 11);
+
+    // type 优先于数据表前缀
+    CHECK(compile({{"address", "10001"}, {"type", "coil"}}, d) == StatusCode::OK);
+    CHECK(d.function_code == 1 && d.address == 0);
+
+    // 两种写法同时给出时适配器键优先
+    CHECK(compile({{"register_address", "5"}, {"address", "40001"}}, d) == StatusCode::OK);
+    CHECK(d.address == 5);
+}
+
+/**
+ * 设备级默认值：从站 ID 与字节序，标签属性可覆盖
+ */
+void test_defaults() {
+    TagDefaults defaults;
+    defaults.slave_id = 17;
+    defaults.byte_order = ByteOrder::CDAB;
+
+    TagDescriptor d;
+    CHECK(compile({{"register_address", "0"}, {"data_type", "uint32"}}, d, defaults) == StatusCode::OK);
+    CHECK(d.slave_id == 17 && d.byte_order == ByteOrder::CDAB);
+
+    CHECK(compile({{"register_address", "0"}, {"data_type", "uint32"}, {"slave_id", "2"}, {"byte_order", "dcba"}}, d,
+                  defaults) == StatusCode::OK);
+    CHECK(d.slave_id == 2 && d.byte_order == ByteOrder::DCBA);
+}
+
+/**
+ * 非法属性编译失败，描述符的 function_code 为 0
+ */
+void test_invalid() {
+    TagDescriptor d;
+    CHECK(compile({}, d) == StatusCode::InvalidParam);
+    CHECK(compile({{"register_address", "x"}}, d) == StatusCode::InvalidParam);
+    CHECK(d.function_code == 0);
+    CHECK(compile({{"register_address", "70000"}}, d) == StatusCode::InvalidParam);
+    CHECK(compile({{"register_address", "0"}, {"slave_id", "256"}}, d) == StatusCode::InvalidParam);
+    CHECK(compile({{"register_address", "0"}, {"byte_order", "XYZW"}}, d) == StatusCode::InvalidParam);
+    CHECK(compile({{"register_address", "0"}, {"data_type", "flaot32"}}, d) == StatusCode::InvalidParam);
+    CHECK(compile({{"register_address", "0"}, {"data_type", ""}}, d) == StatusCode::InvalidParam);
+    CHECK(compile({{"register_address", "0"}, {"data_type", "int32"}, {"register_count", "1"}}, d)
+          == StatusCode::InvalidParam);
+    CHECK(compile({{"address", "0"}}, d) == StatusCode::InvalidParam);
+    CHECK(compile({{"address", "1"}, {"type", "analog"}}, d) == StatusCode::InvalidParam);
+    CHECK(compile({{"register_address", "0"}, {"bit", "16"}}, d) == StatusCode::InvalidParam);
+    CHECK(compile({{"register_address", "0"}, {"bit", "3"}, {"data_type", "float32"}}, d) == StatusCode::InvalidParam);
+    CHECK(compile({{"register_address", "0"}, {"bit", "3"}, {"function_code", "1"}}, d) == StatusCode::InvalidParam);
+}
+
+/**
+ * 四种字节序下的 32 位解码，以及编码后再解码还原
+ */
+void test_byte_orders() {
+    const uint16_t registers[2] = {0x1234, 0x5678};
+    const struct {
+        const char* name;
+        uint32_t expected;
+    } cases[] = {{"ABCD", 0x12345678u}, {"CDAB", 0x56781234u}, {"BADC", 0x34127856u}, {"DCBA", 0x78563412u}};
+
+    for (const auto& c : cases) {
+        TagDescriptor d;
+        CHECK(compile({{"register_address", "0"}, {"data_type", "uint32"}, {"byte_order", c.name}}, d)
+              == StatusCode::OK);
+        DataValue value;
+        d.decode(registers, value);
+        CHECK(std::get<uint32_t>(value.value) == c.expected);
+
+        uint16_t encoded[2] = {0, 0};
+        CHECK(encode_registers(d, value, encoded) == StatusCode::OK);
+        CHECK(encoded[0] == registers[0] && encoded[1] == registers[1]);
+    }
+
+    const uint16_t negative = 0xFFFE;
+    TagDescriptor d;
+    DataValue value;
+    CHECK(compile({{"register_address", "0"}, {"data_type", "int16"}}, d) == StatusCode::OK);
+    d.decode(&negative, value);
+    CHECK(std::get<int32_t>(value.value) == -2);
+    CHECK(compile({{"register_address", "0"}}, d) == StatusCode::OK);
+    d.decode(&negative, value);
+    CHECK(std::get<int32_t>(value.value) == 0xFFFE);
+}
+
+/**
+ * 写入值的类型与范围检查：整数不得超出数据类型的范围，开关量按 0/1 编码
+ */
+void test_encode() {
+    TagDescriptor d;
+    uint16_t registers[4] = {0, 0, 0, 0};
+    DataValue value;
+
+    CHECK(compile({{"register_address", "0"}, {"data_type", "int16"}}, d) == StatusCode::OK);
+    value.value = int32_t(-2);
+    CHECK(encode_registers(d, value, registers) == StatusCode::OK && registers[0] == 0xFFFE);
+    value.value = int32_t(40000);
+    CHECK(encode_registers(d, value, registers) == StatusCode::InvalidParam);
+    value.value = std::string("1");
+    CHECK(encode_registers(d, value, registers) == StatusCode::InvalidParam);
+
+    CHECK(compile({{"register_address", "0"}, {"data_type", "float32"}}, d) == StatusCode::OK);
+    value.value = 1.0f;
+    CHECK(encode_registers(d, value, registers) == StatusCode::OK);
+    CHECK(registers[0] == 0x3F80 && registers[1] == 0x0000);
+
+    CHECK(compile({{"register_address", "0"}, {"data_type", "int64"}}, d) == StatusCode::OK);
+    value.value = int64_t(-2);
+    CHECK(encode_registers(d, value, registers) == StatusCode::OK);
+    CHECK(registers[0] == 0xFFFF && registers[1] == 0xFFFF && registers[2] == 0xFFFF && registers[3] == 0xFFFE);
+
+    CHECK(compile({{"register_address", "0"}, {"data_type", "float64"}}, d) == StatusCode::OK);
+    value.value = 1.0;
+    CHECK(encode_registers(d, value, registers) == StatusCode::OK);
+    CHECK(registers[0] == 0x3FF0 && registers[1] == 0 && registers[2] == 0 && registers[3] == 0);
+
+    uint8_t bit = 0;
+    value.value = true;
+    CHECK(encode_bit(value, bit) == StatusCode::OK && bit == 1);
+    value.value = int32_t(0);
+    CHECK(encode_bit(value, bit) == StatusCode::OK && bit == 0);
+}
+
+/**
+ * 寄存器位标签：解码取指定位，掩码写只改变该位
+ */
+void test_register_bit() {
+    TagDescriptor d;
+    CHECK(compile({{"register_address", "3"}, {"bit", "4"}}, d) == StatusCode::OK);
+    CHECK(d.bit == 4 && d.count == 1);
+
+    const uint16_t set = 0x0010;
+    const uint16_t clear = 0xFFEF;
+    DataValue value;
+    d.decode(&set, value);
+    CHECK(std::get<bool>(value.value));
+    d.decode(&clear, value);
+    CHECK(!std::get<bool>(value.value));
+
+    uint16_t and_mask = 0;
+    uint16_t or_mask = 0;
+    value.value = true;
+    CHECK(encode_register_bit(d, value, and_mask, or_mask) == StatusCode::OK);
+    CHECK(and_mask == 0xFFEF && or_mask == 0x0010);
+}
+
+/**
+ * 多位线圈打包为 uint32_t，首个地址为最低位
+ */
+void test_packed_bits() {
+    TagDescriptor d;
+    CHECK(compile({{"register_address", "0"}, {"function_code", "1"}, {"register_count", "4"}}, d) == StatusCode::OK);
+    const uint8_t bits[4] = {1, 0, 1, 1};
+    DataValue value;
+    decode_bits(d, bits, value);
+    CHECK(std::get<uint32_t>(value.value) == 0xDu);
+
+    uint32_t packed = 0;
+    CHECK(encode_bits(d, value, packed) == StatusCode::OK);
+    CHECK(packed == 0xDu);
+    value.value = static_cast<uint32_t>(0x10);
+    CHECK(encode_bits(d, value, packed) == StatusCode::InvalidParam);
+
+    // 超过 32 位的线圈标签只取首个位
+    CHECK(compile({{"register_address", "0"}, {"function_code", "1"}, {"register_count", "40"}}, d) == StatusCode::OK);
+    decode_bits(d, bits, value);
+    CHECK(std::get<bool>(value.value));
+}
+
+} // namespace
+
+int main() {
+    test_adapter_keys();
+    test_config_dialect();
+    test_defaults();
+    test_invalid();
+    test_byte_orders();
+    test_encode();
+    test_register_bit();
+    test_packed_bits();
+    std::cout << "TagDescriptorTest passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,737 @@
+#include "BlockDecoder.hpp"
+#include "ChangeFilter.hpp"
+#include "ModbusAdapter.hpp"
+#include "ModbusRtuTransport.hpp"
+#include "ScanPlanner.hpp"
+#include "TagDescriptor.hpp"
+#include <southbound/CompactValue.hpp>
+#include <southbound/Types.hpp>
+#include <modbus/modbus.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <getopt.h>
+#include <iostream>
+#include <map>
+#include <new>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <termios.h>
+#include <unistd.h>
+
+using namespace southbound;
+
+// 全局分配计数，用于统计每次操作的堆分配次数
+static std::atomic<uint64_t> g_allocations{0};
+
+void* operator new(std::size_t size) {
+    ++g_allocations;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+/**
+ * @brief 单项测量结果
+ */
+struct BenchmarkResult {
+    std::string name;
+    size_t tags;
+    uint64_t iterations;
+    double ns_per_op;   // 每次操作（处理全部标签）的耗时
+    double ns_per_tag;  // 折算到每个标签的耗时
+    double allocs_per_op{0.0}; // 每次操作的堆分配次数
+};
+
+/**
+ * @brief 运行参数
+ */
+struct BenchmarkOptions {
+    std::vector<size_t> sizes{10, 100, 1000, 10000, 100000};
+    std::string filter;
+    std::chrono::milliseconds min_time{200};
+    std::string output;
+    bool rtu{false};    // 通过 pty 比较 RTU 收发实现并测量完整扫描周期
+};
+
+// 防止被测代码被优化掉
+volatile uint64_t g_sink = 0;
+
+/**
+ * @brief 重复执行 body 直到累计耗时不少于 min_time，返回平均耗时
+ * 迭代次数按上一轮耗时倍增，计时不含 setup。
+ * @param body 被测操作，返回校验值
+ */
+template <typename Body>
+BenchmarkResult measure(const std::string& name, size_t tags, const BenchmarkOptions& options, Body&& body) {
+    using clock = std::chrono::steady_clock;
+    uint64_t iterations = 1;
+    for (;;) {
+        uint64_t checksum = 0;
+        uint64_t allocations = g_allocations;
+        auto start = clock::now();
+        for (uint64_t i = 0; i < iterations; ++i) {
+            checksum += body();
+        }
+        auto elapsed = clock::now() - start;
+        allocations = g_allocations - allocations;
+        g_sink = g_sink + checksum;
+        if (elapsed >= options.min_time || iterations >= (uint64_t(1) << 30)) {
+            double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+            double per_op = ns / static_cast<double>(iterations);
+            return BenchmarkResult{name, tags, iterations, per_op, per_op / static_cast<double>(tags),
+                                   static_cast<double>(allocations) / static_cast<double>(iterations)};
+        }
+        iterations *= elapsed < options.min_time / 10 ? 10 : 2;
+    }
+}
+
+/**
+ * @brief 生成 n 个保持寄存器 float32 标签（适配器键写法）
+ */
+std::vector<DeviceTag> make_tags(size_t n) {
+    std::vector<DeviceTag> tags(n);
+    for (size_t i = 0; i < n; ++i) {
+        tags[i].attributes["register_address"] = std::to_string((i * 2) % 65534);
+        tags[i].attributes["function_code"] = "3";
+        tags[i].attributes["data_type"] = "float32";
+        tags[i].attributes["slave_id"] = std::to_string(1 + i / 32767);
+    }
+    return tags;
+}
+
+std::vector<DataValue> make_values(size_t n) {
+    std::vector<DataValue> values(n);
+    for (size_t i = 0; i < n; ++i) {
+        values[i].value = static_cast<float>(i) * 0.5f;
+        values[i].timestamp_ms = 1700000000000ull + i;
+        values[i].quality = 1;
+    }
+    return values;
+}
+
+std::vector<TagDescriptor> compile_all(const std::vector<DeviceTag>& tags) {
+    std::vector<TagDescriptor> descriptors(tags.size());
+    for (size_t i = 0; i < tags.size(); ++i) {
+        compile_tag(tags[i], TagDefaults(), descriptors[i]);
+    }
+    return descriptors;
+}
+
+/**
+ * @brief 运行一种标签数量下的全部测量
+ */
+void run_size(size_t n, const BenchmarkOptions& options, std::vector<BenchmarkResult>& results) {
+    std::vector<DeviceTag> tags = make_tags(n);
+    std::vector<DataValue> values = make_values(n);
+    std::vector<TagDescriptor> descriptors = compile_all(tags);
+    std::vector<uint16_t> registers(2 * n);
+    for (size_t i = 0; i < registers.size(); ++i) {
+        registers[i] = static_cast<uint16_t>(i * 2654435761u >> 16);
+    }
+
+    auto run = [&](const char* name, auto&& body) {
+        if (options.filter.empty() || std::strstr(name, options.filter.c_str())) {
+            results.push_back(measure(name, n, options, body));
+            std::cerr << name << " tags=" << n << " " << results.back().ns_per_tag << " ns/tag "
+                      << results.back().allocs_per_op << " allocs/op" << std::endl;
+        }
+    };
+
+    // DeviceTag::operator< 排序（含复制）
+    run("tag_sort", [&]() -> uint64_t {
+        std::vector<DeviceTag> copy(tags);
+        std::sort(copy.begin(), copy.end());
+        return copy.size();
+    });
+
+    // 以 DeviceTag 为键的查找
+    std::map<DeviceTag, size_t> index;
+    for (size_t i = 0; i < n; ++i) {
+        index.emplace(tags[i], i);
+    }
+    run("tag_lookup", [&]() -> uint64_t {
+        uint64_t sum = 0;
+        for (const DeviceTag& tag : tags) {
+            auto it = index.find(tag);
+            sum += it == index.end() ? 0 : it->second;
+        }
+        return sum;
+    });
+
+    // 按 DeviceTag 订阅时的值 map 构造（subscribe() 兼容包装每周期由序列转换的写法）
+    run("value_map_build", [&]() -> uint64_t {
+        std::map<DeviceTag, DataValue> map;
+        for (size_t i = 0; i < n; ++i) {
+            map[tags[i]] = values[i];
+        }
+        return map.size();
+    });
+
+    // DataValue 变体复制
+    run("value_copy", [&]() -> uint64_t {
+        std::vector<DataValue> copy(values);
+        return copy.back().timestamp_ms;
+    });
+
+    // 紧凑数据值复制（可平凡复制，整体 memcpy）
+    std::vector<CompactValue> compact;
+    to_compact(values, compact);
+    run("compact_copy", [&]() -> uint64_t {
+        std::vector<CompactValue> copy(compact);
+        return copy.back().timestamp_ms();
+    });
+
+    // 标签属性解析
+    run("compile_tag", [&]() -> uint64_t {
+        uint64_t sum = 0;
+        TagDescriptor descriptor;
+        for (const DeviceTag& tag : tags) {
+            compile_tag(tag, TagDefaults(), descriptor);
+            sum += descriptor.address;
+        }
+        return sum;
+    });
+
+    // 扫描规划
+    ScanPlanner planner;
+    run("scan_plan", [&]() -> uint64_t {
+        return planner.plan(descriptors).size();
+    });
+
+    // 逐标签解码
+    std::vector<DataValue> decoded(n);
+    run("decode_per_tag", [&]() -> uint64_t {
+        for (size_t i = 0; i < n; ++i) {
+            descriptors[i].decode(registers.data() + 2 * i, decoded[i]);
+        }
+        return decoded.back().value.index();
+    });
+
+    // 批量解码
+    std::vector<DataValue*> targets(n);
+    for (size_t i = 0; i < n; ++i) {
+        targets[i] = &decoded[i];
+    }
+    run("decode_block", [&]() -> uint64_t {
+        decode_values(registers.data(), n, DataType::Float32, ByteOrder::ABCD, targets.data());
+        return decoded.back().value.index();
+    });
+
+    // 按例外上报过滤
+    ChangeFilter filter;
+    filter.reset(std::vector<DeadbandSpec>(n));
+    uint64_t now_ms = 0;
+    run("change_filter", [&]() -> uint64_t {
+        uint64_t reported = 0;
+        ++now_ms;
+        for (size_t i = 0; i < n; ++i) {
+            reported += filter.update(i, values[i], now_ms);
+        }
+        return reported;
+    });
+
+    // 回调分发：构造好的 map 交给 std::function 回调，回调遍历全部值
+    std::map<DeviceTag, DataValue> map;
+    for (size_t i = 0; i < n; ++i) {
+        map[tags[i]] = values[i];
+    }
+    uint64_t visited = 0;
+    OnDataReceivedCallback callback = [&visited](const std::map<DeviceTag, DataValue>& received) {
+        for (const auto& pair : received) {
+            visited += pair.second.quality;
+        }
+    };
+    run("callback_dispatch", [&]() -> uint64_t {
+        callback(map);
+        return visited;
+    });
+
+    // 每周期上报：构造 map 后回调（原订阅路径）
+    run("deliver_map", [&]() -> uint64_t {
+        std::map<DeviceTag, DataValue> received;
+        for (size_t i = 0; i < n; ++i) {
+            received[tags[i]] = values[i];
+        }
+        callback(received);
+        return visited;
+    });
+
+}
+
+/**
+ * @brief pty 上的最小 RTU 从站
+ * 只应答 FC3，寄存器值为地址本身；用于测量主站侧收发实现的开销。
+ */
+class PtySlave {
+public:
+    ~PtySlave() {
+        m_running = false;
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+        if (m_slave >= 0) close(m_slave);
+        if (m_master >= 0) close(m_master);
+    }
+
+    bool open() {
+        m_master = posix_openpt(O_RDWR | O_NOCTTY);
+        if (m_master < 0 || grantpt(m_master) != 0 || unlockpt(m_master) != 0) {
+            return false;
+        }
+        m_path = ptsname(m_master);
+        m_slave = ::open(m_path.c_str(), O_RDWR | O_NOCTTY); // 保持从端打开，主端不会读到 EIO
+        struct termios tios;
+        if (m_slave < 0 || tcgetattr(m_slave, &tios) != 0) {
+            return false;
+        }
+        cfmakeraw(&tios);
+        tcsetattr(m_slave, TCSANOW, &tios);
+        m_running = true;
+        m_thread = std::thread(&PtySlave::serve, this);
+        return true;
+    }
+
+    const std::string& path() const { return m_path; }
+
+private:
+    int m_master{-1};
+    int m_slave{-1};
+    std::string m_path;
+    std::atomic<bool> m_running{false};
+    std::thread m_thread;
+
+    void serve() {
+        uint8_t request[8];
+        size_t received = 0;
+        while (m_running) {
+            struct pollfd pfd = {m_master, POLLIN, 0};
+            if (poll(&pfd, 1, 100) <= 0) {
+                continue;
+            }
+            ssize_t n = read(m_master, request + received, sizeof(request) - received);
+            if (n <= 0) {
+                continue;
+            }
+            received += static_cast<size_t>(n);
+            if (received < sizeof(request)) {
+                continue;
+            }
+            received = 0;
+            int address = (request[2] << 8) | request[3];
+            int count = (request[4] << 8) | request[5];
+            uint8_t response[MODBUS_RTU_MAX_ADU_LENGTH] = { request[0], 3, static_cast<uint8_t>(2 * count) };
+            for (int i = 0; i < count; ++i) {
+                response[3 + 2 * i] = static_cast<uint8_t>((address + i) >> 8);
+                response[4 + 2 * i] = static_cast<uint8_t>(address + i);
+            }
+            size_t length = 3 + 2 * static_cast<size_t>(count);
+            uint16_t crc = ModbusRtuTransport::crc16(response, length);
+            response[length] = static_cast<uint8_t>(crc & 0xFF);
+            response[length + 1] = static_cast<uint8_t>(crc >> 8);
+            if (write(m_master, response, length + 2) < 0) {
+                continue;
+            }
+        }
+    }
+};
+
+/**
+ * @brief 比较 RTU 收发实现的单次 FC3 往返耗时
+ * 标签数量即每次读取的寄存器数（不超过 125）。
+ */
+void run_rtu(const BenchmarkOptions& options, std::vector<BenchmarkResult>& results) {
+    PtySlave slave;
+    if (!slave.open()) {
+        std::cerr << "创建 pty 失败，跳过 RTU 测量" << std::endl;
+        return;
+    }
+
+    ModbusRtuTransport native;
+    modbus_t* ctx = modbus_new_rtu(slave.path().c_str(), 115200, 'N', 8, 1);
+    if (native.open(slave.path(), 115200, 'N', 8, 1) != 0 || !ctx || modbus_connect(ctx) != 0) {
+        std::cerr << "打开 " << slave.path() << " 失败，跳过 RTU 测量" << std::endl;
+        if (ctx) modbus_free(ctx);
+        return;
+    }
+    modbus_set_slave(ctx, 1);
+
+    uint16_t registers[MODBUS_MAX_READ_REGISTERS];
+    for (size_t n : options.sizes) {
+        if (n > MODBUS_MAX_READ_REGISTERS) {
+            continue;
+        }
+        int count = static_cast<int>(n);
+        auto run = [&](const char* name, auto&& body) {
+            if (options.filter.empty() || std::strstr(name, options.filter.c_str())) {
+                results.push_back(measure(name, n, options, body));
+                std::cerr << name << " registers=" << n << " " << results.back().ns_per_op << " ns/op" << std::endl;
+            }
+        };
+        run("rtu_read_native", [&]() -> uint64_t {
+            return static_cast<uint64_t>(native.read_registers(1, 3, 0, count, registers));
+        });
+        run("rtu_read_libmodbus", [&]() -> uint64_t {
+            return static_cast<uint64_t>(modbus_read_registers(ctx, 0, count, registers));
+        });
+    }
+
+    modbus_close(ctx);
+    modbus_free(ctx);
+}
+
+/**
+ * @brief 回环 TCP 上的最小 Modbus TCP 从站
+ * 只应答 FC3/FC4，寄存器值为地址本身；每收到一条请求立即应答，可以有多个事务在途。
+ * 依次接受连接，每个连接服务到对端关闭为止。
+ */
+class TcpSlave {
+public:
+    ~TcpSlave() {
+        m_running = false;
+        if (m_thread.joinable()) {
+            m_thread.join();
+        }
+        if (m_listener >= 0) close(m_listener);
+    }
+
+    bool open() {
+        m_listener = socket(AF_INET, SOCK_STREAM, 0);
+        struct sockaddr_in address {};
+        address.sin_family = AF_INET;
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        socklen_t length = sizeof(address);
+        if (m_listener < 0 || bind(m_listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0
+            || listen(m_listener, 1) != 0
+            || getsockname(m_listener, reinterpret_cast<sockaddr*>(&address), &length) != 0) {
+            return false;
+        }
+        m_port = ntohs(address.sin_port);
+        m_running = true;
+        m_thread = std::thread(&TcpSlave::serve, this);
+        return true;
+    }
+
+    int port() const { return m_port; }
+
+private:
+    int m_listener{-1};
+    int m_port{0};
+    std::atomic<bool> m_running{false};
+    std::thread m_thread;
+
+    void serve() {
+        while (m_running) {
+            struct pollfd pfd = {m_listener, POLLIN, 0};
+            if (poll(&pfd, 1, 100) <= 0) {
+                continue;
+            }
+            int client = accept(m_listener, nullptr, nullptr);
+            if (client >= 0) {
+                int on = 1; // 逐条应答，关闭 Nagle 以免与主站的延迟确认相互等待
+                setsockopt(client, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+                serve_client(client);
+                close(client);
+            }
+        }
+    }
+
+    void serve_client(int client) {
+        uint8_t request[12];
+        size_t received = 0;
+        while (m_running) {
+            struct pollfd pfd = {client, POLLIN, 0};
+            if (poll(&pfd, 1, 100) <= 0) {
+                continue;
+            }
+            ssize_t n = read(client, request + received, sizeof(request) - received);
+            if (n <= 0) {
+                return;
+            }
+            received += static_cast<size_t>(n);
+            if (received < sizeof(request)) {
+                continue;
+            }
+            received = 0;
+            int address = (request[8] << 8) | request[9];
+            int count = std::min((request[10] << 8) | request[11], MODBUS_MAX_READ_REGISTERS);
+            size_t length = 9 + 2 * static_cast<size_t>(count);
+            uint8_t response[MODBUS_TCP_MAX_ADU_LENGTH] = {
+                request[0], request[1], 0, 0, static_cast<uint8_t>((length - 6) >> 8),
+                static_cast<uint8_t>(length - 6), request[6], request[7], static_cast<uint8_t>(2 * count)
+            };
+            for (int i = 0; i < count; ++i) {
+                response[9 + 2 * i] = static_cast<uint8_t>((address + i) >> 8);
+                response[10 + 2 * i] = static_cast<uint8_t>(address + i);
+            }
+            if (write(client, response, length) < 0) {
+                return;
+            }
+        }
+    }
+};
+
+/**
+ * @brief 测量一种连接配置下完整的订阅扫描周期
+ * 批量订阅全部标签（每周期全部上报），按最小节拍扫描；耗时取适配器自身统计的节拍处理耗时
+ * （块读、解码、过滤与回调），分配次数为稳态周期内全部线程的堆分配。
+ * @return 连接失败返回 false，调用方不再测量其余标签数量
+ */
+bool measure_scan(const char* name, const AdapterConfig& connection, size_t n, const BenchmarkOptions& options,
+                  std::vector<BenchmarkResult>& results) {
+    ModbusAdapter adapter;
+    AdapterConfig config = connection;
+    config["poll_interval"] = std::to_string(ScanScheduler::MIN_TICK_MS);
+    config["report_by_exception"] = "false";
+    config["auto_reconnect"] = "false";
+    if (adapter.init(config) != StatusCode::OK || adapter.connect() != StatusCode::OK) {
+        return false;
+    }
+
+    // 每次回调记录当时的累计分配次数，统计窗口内主线程不分配
+    std::vector<uint64_t> marks(1 << 16);
+    std::atomic<size_t> callbacks{0};
+    uint64_t visited = 0;
+    StatusCode subscribed = adapter.subscribe_batch(make_tags(n), [&](const TagSampleSpan& samples) {
+        for (const TagSample& sample : samples) {
+            visited += sample.value.quality;
+        }
+        size_t k = callbacks.load();
+        if (k < marks.size()) {
+            marks[k] = g_allocations;
+        }
+        callbacks = k + 1;
+    });
+    if (subscribed != StatusCode::OK) {
+        return true;
+    }
+    auto wait_callbacks = [&](size_t count) {
+        while (callbacks < count) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    };
+
+    // 前几个周期建立块读计划、过滤器状态与缓冲区，不计入
+    wait_callbacks(3);
+    AdapterStatistics before;
+    adapter.get_statistics(before);
+    size_t first = callbacks + 1;
+    std::this_thread::sleep_for(options.min_time);
+    wait_callbacks(first + 10);
+    size_t last = std::min(callbacks.load(), marks.size()) - 1;
+    AdapterStatistics after;
+    adapter.get_statistics(after);
+    adapter.unsubscribe();
+    adapter.disconnect();
+
+    uint64_t cycles = after["scan_cycles"] - before["scan_cycles"];
+    double total_us = static_cast<double>(after["scan_duration_avg_us"] * after["scan_cycles"])
+        - static_cast<double>(before["scan_duration_avg_us"] * before["scan_cycles"]);
+    double per_op = cycles ? total_us * 1000.0 / static_cast<double>(cycles) : 0.0;
+    double allocs = static_cast<double>(marks[last] - marks[first]) / static_cast<double>(last - first);
+    g_sink = g_sink + visited;
+    results.push_back(BenchmarkResult{name, n, cycles, per_op, per_op / static_cast<double>(n), allocs});
+    std::cerr << name << " tags=" << n << " " << results.back().ns_per_tag << " ns/tag "
+              << results.back().allocs_per_op << " allocs/op" << std::endl;
+    return true;
+}
+
+/**
+ * @brief 测量完整的订阅扫描周期
+ * scan_cycle：以原生 RTU 收发经 pty 连接最小从站，逐块读取；
+ * scan_cycle_tcp_pipelined：经回环 TCP 连接最小从站，多块时走流水线（pipeline_depth=8）。
+ */
+void run_scan(const BenchmarkOptions& options, std::vector<BenchmarkResult>& results) {
+    auto selected = [&options](const char* name) {
+        return options.filter.empty() || std::strstr(name, options.filter.c_str());
+    };
+
+    if (selected("scan_cycle")) {
+        PtySlave slave;
+        if (!slave.open()) {
+            std::cerr << "创建 pty 失败，跳过 RTU 扫描周期测量" << std::endl;
+        } else {
+            AdapterConfig config{
+                {"connection_type", "rtu"}, {"device_path", slave.path()}, {"baudrate", "115200"},
+                {"rtu_engine", "native"}
+            };
+            for (size_t n : options.sizes) {
+                if (!measure_scan("scan_cycle", config, n, options, results)) {
+                    std::cerr << "打开 " << slave.path() << " 失败，跳过 RTU 扫描周期测量" << std::endl;
+                    break;
+                }
+            }
+        }
+    }
+
+    if (selected("scan_cycle_tcp_pipelined")) {
+        TcpSlave slave;
+        if (!slave.open()) {
+            std::cerr << "创建回环 TCP 从站失败，跳过流水线扫描周期测量" << std::endl;
+            return;
+        }
+        AdapterConfig config{
+            {"connection_type", "tcp"}, {"ip_address", "127.0.0.1"}, {"port", std::to_string(slave.port())},
+            {"pipeline_depth", "8"}
+        };
+        for (size_t n : options.sizes) {
+            if (!measure_scan("scan_cycle_tcp_pipelined", config, n, options, results)) {
+                std::cerr << "连接 127.0.0.1:" << slave.port() << " 失败，跳过流水线扫描周期测量" << std::endl;
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * @brief 转义 JSON 字符串
+ */
+std::string json_string(const std::string& text) {
+    std::string out = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+        }
+        out += c;
+    }
+    return out + "\"";
+}
+
+/**
+ * @brief 以 JSON 输出全部结果
+ */
+void write_json(std::ostream& out, const std::vector<BenchmarkResult>& results, const BenchmarkOptions& options) {
+    out << "{\n"
+        << "  \"suite\": \"modbus-adapter\",\n"
+        << "  \"timestamp\": " << std::time(nullptr) << ",\n"
+        << "  \"compiler\": " << json_string(__VERSION__) << ",\n"
+        << "  \"min_time_ms\": " << options.min_time.count() << ",\n"
+        << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchmarkResult& r = results[i];
+        out << "    {\"name\": " << json_string(r.name) << ", \"tags\": " << r.tags
+            << ", \"iterations\": " << r.iterations << ", \"ns_per_op\": " << r.ns_per_op
+            << ", \"ns_per_tag\": " << r.ns_per_tag << ", \"allocs_per_op\": " << r.allocs_per_op << "}"
+            << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+/**
+ * @brief 打印使用说明
+ */
+void print_usage(const char* program_name) {
+    std::cout << "Usage: " << program_name << " [OPTIONS]\n"
+              << "Options:\n"
+              << "  -s, --sizes N,N,...   标签数量 (默认: 10,100,1000,10000,100000)\n"
+              << "  -f, --filter TEXT     只运行名称包含 TEXT 的测量\n"
+              << "  -t, --min-time MS     每项测量的最短计时 (默认: 200)\n"
+              << "  -o, --output FILE     JSON 输出文件 (默认: 标准输出)\n"
+              << "  -r, --rtu             同时经 pty 比较原生与 libmodbus RTU 收发（标签数量即寄存器数），\n"
+              << "                        并测量完整的订阅扫描周期（RTU 逐块读取与回环 TCP 流水线）\n"
+              << "  -h, --help            显示此帮助信息\n"
+              << std::endl;
+}
+
+/**
+ * @brief 解析逗号分隔的标签数量
+ */
+bool parse_sizes(const char* text, std::vector<size_t>& sizes) {
+    sizes.clear();
+    std::stringstream stream(text);
+    for (std::string item; std::getline(stream, item, ',');) {
+        char* end = nullptr;
+        unsigned long value = std::strtoul(item.c_str(), &end, 10);
+        if (item.empty() || *end != '\0' || value == 0) {
+            return false;
+        }
+        sizes.push_back(value);
+    }
+    return !sizes.empty();
+}
+
+} // namespace
+
+/**
+ * @brief 主程序入口函数
+ * 进度输出到标准错误，JSON 结果输出到标准输出或 --output 指定的文件。
+ */
+int main(int argc, char* argv[]) {
+    BenchmarkOptions options;
+
+    static struct option long_options[] = {
+        {"sizes",    required_argument, 0, 's'},
+        {"filter",   required_argument, 0, 'f'},
+        {"min-time", required_argument, 0, 't'},
+        {"output",   required_argument, 0, 'o'},
+        {"rtu",      no_argument,       0, 'r'},
+        {"help",     no_argument,       0, 'h'},
+        {0, 0, 0, 0}
+    };
+
+    int c;
+    while ((c = getopt_long(argc, argv, "s:f:t:o:rh", long_options, nullptr)) != -1) {
+        switch (c) {
+            case 's':
+                if (!parse_sizes(optarg, options.sizes)) {
+                    print_usage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 'f': options.filter = optarg; break;
+            case 't': options.min_time = std::chrono::milliseconds(std::atoi(optarg)); break;
+            case 'o': options.output = optarg; break;
+            case 'r': options.rtu = true; break;
+            case 'h':
+                print_usage(argv[0]);
+                return 0;
+            default:
+                print_usage(argv[0]);
+                return 1;
+        }
+    }
+
+    std::vector<BenchmarkResult> results;
+    for (size_t n : options.sizes) {
+        run_size(n, options, results);
+    }
+    if (options.rtu) {
+        run_rtu(options, results);
+        run_scan(options, results);
+    }
+
+    if (options.output.empty()) {
+        write_json(std::cout, results, options);
+    } else {
+        std::ofstream file(options.output);
+        if (!file) {
+            std::cerr << "无法写入 " << options.output << std::endl;
+            return 1;
+        }
+        write_json(file, results, options);
+    }
+    return 0;
+}
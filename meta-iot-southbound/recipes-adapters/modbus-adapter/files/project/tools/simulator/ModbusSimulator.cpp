@@ -0,0 +1,631 @@
+#include "ModbusSimulator.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <netinet/in.h>
+#include <sys/select.h>
+#include <sys/socket.h>
+#include <termios.h>
+#include <unistd.h>
+
+namespace southbound {
+
+namespace {
+
+/**
+ * 解析十进制整数
+ */
+bool parse_int(const std::string& text, long& out) {
+    char* end = nullptr;
+    errno = 0;
+    out = std::strtol(text.c_str(), &end, 0);
+    return errno == 0 && end != text.c_str() && *end == '\0';
+}
+
+/**
+ * 解析浮点数
+ */
+bool parse_double(const std::string& text, double& out) {
+    char* end = nullptr;
+    errno = 0;
+    out = std::strtod(text.c_str(), &end);
+    return errno == 0 && end != text.c_str() && *end == '\0';
+}
+
+/**
+ * 脚本命令及其参数个数范围
+ */
+struct CommandSpec {
+    const char* name;
+    size_t min_args;
+    size_t max_args;
+};
+
+const CommandSpec COMMANDS[] = {
+    {"set", 3, 125},        // set <表> <地址> <值>...
+    {"float", 3, 62},       // float <表> <地址> <值>...（float32，高字在前）
+    {"inc", 2, 4},          // inc <表> <地址> [数量] [步长]
+    {"random", 2, 3},       // random <表> <地址> [数量]
+    {"sleep", 1, 1},        // sleep <毫秒>
+    {"latency", 1, 2},      // latency <下限毫秒> [上限毫秒]
+    {"drop", 1, 1},         // drop <百分比>
+    {"exception", 1, 2},    // exception <百分比> [异常码]
+    {"hole", 3, 3},         // hole <表> <地址> <数量>
+    {"clear", 0, 0},        // clear：清除全部故障与非法区间
+    {"repeat", 0, 0},       // repeat：从头重新执行脚本
+};
+
+const CommandSpec* find_command(const std::string& name) {
+    for (const CommandSpec& spec : COMMANDS) {
+        if (name == spec.name) {
+            return &spec;
+        }
+    }
+    return nullptr;
+}
+
+/**
+ * 请求访问的数据表
+ * @return 不访问数据表的功能码返回 false
+ */
+bool request_table(int function_code, SimTable& table) {
+    switch (function_code) {
+        case 1: case 5: case 15: table = SimTable::Coils; return true;
+        case 2: table = SimTable::DiscreteInputs; return true;
+        case 3: case 6: case 16: case 22: case 23: table = SimTable::HoldingRegisters; return true;
+        case 4: table = SimTable::InputRegisters; return true;
+        default: return false;
+    }
+}
+
+} // namespace
+
+/**
+ * 解析数据表名称
+ * @param name coil/discrete/holding/input
+ * @param table 输出数据表
+ * @return 是否解析成功
+ */
+bool parse_sim_table(const std::string& name, SimTable& table) {
+    if (name == "coil") { table = SimTable::Coils; return true; }
+    if (name == "discrete") { table = SimTable::DiscreteInputs; return true; }
+    if (name == "holding") { table = SimTable::HoldingRegisters; return true; }
+    if (name == "input") { table = SimTable::InputRegisters; return true; }
+    return false;
+}
+
+/**
+ * 析构函数
+ * 停止脚本线程并释放上下文、数据表与 pty。
+ */
+ModbusSimulator::~ModbusSimulator() {
+    m_running = false;
+    if (m_script_thread.joinable()) {
+        m_script_thread.join();
+    }
+    if (m_listen_socket >= 0) {
+        close(m_listen_socket);
+    }
+    if (m_ctx) {
+        if (m_pty_master >= 0) {
+            modbus_set_socket(m_ctx, -1); // pty 由本类关闭
+        }
+        modbus_close(m_ctx);
+        modbus_free(m_ctx);
+    }
+    if (m_mapping) {
+        modbus_mapping_free(m_mapping);
+    }
+    if (m_pty_slave >= 0) {
+        close(m_pty_slave);
+    }
+    if (m_pty_master >= 0) {
+        close(m_pty_master);
+    }
+    if (!m_options.pty_link.empty()) {
+        unlink(m_options.pty_link.c_str());
+    }
+}
+
+/**
+ * 创建数据表与监听端点，加载脚本
+ * @param options 模拟器参数
+ * @return 是否成功
+ */
+bool ModbusSimulator::start(const SimulatorOptions& options) {
+    m_options = options;
+    m_faults = options.faults;
+    m_random.seed(options.seed);
+
+    if (!options.script.empty() && !load_script(options.script)) {
+        return false;
+    }
+
+    m_mapping = modbus_mapping_new_start_address(
+        options.coils.start, options.coils.count,
+        options.discrete_inputs.start, options.discrete_inputs.count,
+        options.holding_registers.start, options.holding_registers.count,
+        options.input_registers.start, options.input_registers.count);
+    if (!m_mapping) {
+        std::cerr << "创建数据表失败: " << modbus_strerror(errno) << std::endl;
+        return false;
+    }
+
+    bool opened = options.mode == "rtu" ? open_pty() : options.mode == "tcp" ? open_tcp() : false;
+    if (!opened) {
+        return false;
+    }
+
+    m_running = true;
+    if (!m_script.empty()) {
+        m_script_thread = std::thread(&ModbusSimulator::script_worker, this);
+    }
+    return true;
+}
+
+/**
+ * 在 TCP 端口上监听
+ * @return 是否成功
+ */
+bool ModbusSimulator::open_tcp() {
+    m_ctx = modbus_new_tcp(m_options.address.c_str(), m_options.port);
+    if (!m_ctx) {
+        std::cerr << "创建 TCP 上下文失败" << std::endl;
+        return false;
+    }
+    m_listen_socket = modbus_tcp_listen(m_ctx, 16);
+    if (m_listen_socket == -1) {
+        std::cerr << "监听 " << m_options.address << ":" << m_options.port << " 失败: "
+                  << modbus_strerror(errno) << std::endl;
+        return false;
+    }
+    std::cout << "Modbus TCP 模拟器监听 " << m_options.address << ":" << m_options.port << std::endl;
+    return true;
+}
+
+/**
+ * 创建 pty 对作为 RTU 串口
+ * 模拟器在主端收发，适配器打开从端（或 pty_link 符号链接）。本类保持从端打开，
+ * 适配器断开重连期间主端不会读到 EIO。
+ * @return 是否成功
+ */
+bool ModbusSimulator::open_pty() {
+    m_pty_master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (m_pty_master < 0 || grantpt(m_pty_master) != 0 || unlockpt(m_pty_master) != 0) {
+        std::cerr << "创建 pty 失败: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    m_device_path = ptsname(m_pty_master);
+    m_pty_slave = open(m_device_path.c_str(), O_RDWR | O_NOCTTY);
+    if (m_pty_slave < 0) {
+        std::cerr << "打开 " << m_device_path << " 失败: " << std::strerror(errno) << std::endl;
+        return false;
+    }
+    struct termios tios;
+    if (tcgetattr(m_pty_slave, &tios) == 0) {
+        cfmakeraw(&tios);
+        tcsetattr(m_pty_slave, TCSANOW, &tios);
+    }
+
+    if (!m_options.pty_link.empty()) {
+        unlink(m_options.pty_link.c_str());
+        if (symlink(m_device_path.c_str(), m_options.pty_link.c_str()) != 0) {
+            std::cerr << "创建链接 " << m_options.pty_link << " 失败: " << std::strerror(errno) << std::endl;
+            return false;
+        }
+    }
+
+    // libmodbus 只用上下文中的描述符收发，不调用 modbus_connect 即可直接使用 pty 主端
+    m_ctx = modbus_new_rtu(m_device_path.c_str(), m_options.baudrate, m_options.parity,
+                           m_options.data_bits, m_options.stop_bits);
+    if (!m_ctx) {
+        std::cerr << "创建 RTU 上下文失败" << std::endl;
+        return false;
+    }
+    modbus_set_slave(m_ctx, m_options.slave_id);
+    modbus_set_socket(m_ctx, m_pty_master);
+
+    std::cout << "Modbus RTU 模拟器（从站 " << m_options.slave_id << "）串口: "
+              << (m_options.pty_link.empty() ? m_device_path : m_options.pty_link) << std::endl;
+    return true;
+}
+
+/**
+ * 服务请求直到 stop()
+ */
+void ModbusSimulator::run() {
+    if (m_pty_master >= 0) {
+        run_rtu();
+    } else {
+        run_tcp();
+    }
+}
+
+/**
+ * TCP 服务循环
+ * 以 select 同时服务多个连接；请求按到达顺序逐个处理。
+ */
+void ModbusSimulator::run_tcp() {
+    fd_set all;
+    FD_ZERO(&all);
+    FD_SET(m_listen_socket, &all);
+    int max_fd = m_listen_socket;
+    uint8_t request[MODBUS_TCP_MAX_ADU_LENGTH];
+    auto last = std::chrono::steady_clock::now();
+    uint64_t last_requests = 0;
+
+    while (m_running) {
+        fd_set ready = all;
+        struct timeval tv = {0, 200000};
+        int n = select(max_fd + 1, &ready, nullptr, nullptr, &tv);
+        print_statistics(last, last_requests);
+        if (n <= 0) {
+            continue;
+        }
+
+        for (int fd = 0; fd <= max_fd; ++fd) {
+            if (!FD_ISSET(fd, &ready)) {
+                continue;
+            }
+            if (fd == m_listen_socket) {
+                int client = accept(m_listen_socket, nullptr, nullptr);
+                if (client >= 0 && client < FD_SETSIZE) {
+                    FD_SET(client, &all);
+                    max_fd = std::max(max_fd, client);
+                } else if (client >= 0) {
+                    close(client);
+                }
+                continue;
+            }
+
+            modbus_set_socket(m_ctx, fd);
+            int length = modbus_receive(m_ctx, request);
+            if (length > 0) {
+                handle_request(request, length);
+            } else if (length == -1) {
+                close(fd);
+                FD_CLR(fd, &all);
+            }
+        }
+    }
+}
+
+/**
+ * RTU 服务循环
+ * 帧错误（CRC、非本站地址）由 libmodbus 丢弃后继续等待下一帧。
+ */
+void ModbusSimulator::run_rtu() {
+    uint8_t request[MODBUS_RTU_MAX_ADU_LENGTH];
+    auto last = std::chrono::steady_clock::now();
+    uint64_t last_requests = 0;
+
+    while (m_running) {
+        fd_set ready;
+        FD_ZERO(&ready);
+        FD_SET(m_pty_master, &ready);
+        struct timeval tv = {0, 200000};
+        int n = select(m_pty_master + 1, &ready, nullptr, nullptr, &tv);
+        print_statistics(last, last_requests);
+        if (n <= 0) {
+            continue;
+        }
+
+        int length = modbus_receive(m_ctx, request);
+        if (length > 0) {
+            handle_request(request, length);
+        } else if (length == -1 && errno != EMBBADCRC && errno != EMBBADDATA && errno != ETIMEDOUT) {
+            // pty 异常：稍候重试，避免忙等
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+}
+
+/**
+ * 处理一个请求
+ * 依次应用丢弃、延迟、随机异常与非法地址区间，其余请求由 libmodbus 按数据表应答。
+ * @param request 请求 ADU
+ * @param length 请求长度
+ */
+void ModbusSimulator::handle_request(const uint8_t* request, int length) {
+    ++m_requests;
+
+    bool drop = false;
+    bool exception = false;
+    int exception_code = 0;
+    std::chrono::milliseconds latency(0);
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        std::uniform_real_distribution<double> percent(0.0, 100.0);
+        drop = m_faults.drop_percent > 0.0 && percent(m_random) < m_faults.drop_percent;
+        if (!drop && m_faults.exception_percent > 0.0 && percent(m_random) < m_faults.exception_percent) {
+            exception = true;
+            exception_code = m_faults.exception_code;
+        } else if (!drop && in_hole(request)) {
+            exception = true;
+            exception_code = MODBUS_EXCEPTION_ILLEGAL_DATA_ADDRESS;
+        }
+        if (m_faults.max_latency_ms > 0) {
+            std::uniform_int_distribution<int> delay(m_faults.min_latency_ms, m_faults.max_latency_ms);
+            latency = std::chrono::milliseconds(delay(m_random));
+        }
+    }
+
+    if (drop) {
+        ++m_dropped;
+        return;
+    }
+    if (latency.count() > 0) {
+        std::this_thread::sleep_for(latency);
+    }
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (exception) {
+        modbus_reply_exception(m_ctx, request, static_cast<unsigned int>(exception_code));
+        ++m_exceptions;
+    } else {
+        modbus_reply(m_ctx, request, length, m_mapping);
+    }
+    ++m_replies;
+}
+
+/**
+ * 请求是否访问了非法地址区间
+ * 调用方须持有 m_mutex。
+ * @param request 请求 ADU
+ */
+bool ModbusSimulator::in_hole(const uint8_t* request) const {
+    if (m_holes.empty()) {
+        return false;
+    }
+    const uint8_t* pdu = request + modbus_get_header_length(m_ctx);
+    int function_code = pdu[0];
+    SimTable table;
+    if (!request_table(function_code, table)) {
+        return false;
+    }
+
+    // 读请求 / FC23 的读部分
+    int address = (pdu[1] << 8) | pdu[2];
+    int count = 1;
+    if (function_code <= 4 || function_code == 15 || function_code == 16 || function_code == 23) {
+        count = (pdu[3] << 8) | pdu[4];
+    }
+    auto overlaps = [&](int first, int n) {
+        for (const Hole& hole : m_holes) {
+            if (hole.table == table && first < hole.start + hole.count && hole.start < first + n) {
+                return true;
+            }
+        }
+        return false;
+    };
+    if (overlaps(address, count)) {
+        return true;
+    }
+    // FC23 的写部分
+    return function_code == 23 && overlaps((pdu[5] << 8) | pdu[6], (pdu[7] << 8) | pdu[8]);
+}
+
+/**
+ * 加载脚本
+ * 每行一条命令，# 起为注释；命令名与参数个数在加载时检查，参数取值在执行时检查。
+ * @param path 脚本文件
+ * @return 是否成功
+ */
+bool ModbusSimulator::load_script(const std::string& path) {
+    std::ifstream file(path);
+    if (!file) {
+        std::cerr << "无法打开脚本: " << path << std::endl;
+        return false;
+    }
+
+    std::string line;
+    int line_number = 0;
+    while (std::getline(file, line)) {
+        ++line_number;
+        line = line.substr(0, line.find('#'));
+        std::istringstream words(line);
+        std::vector<std::string> command;
+        for (std::string word; words >> word;) {
+            command.push_back(word);
+        }
+        if (command.empty()) {
+            continue;
+        }
+        const CommandSpec* spec = find_command(command[0]);
+        if (!spec || command.size() - 1 < spec->min_args || command.size() - 1 > spec->max_args) {
+            std::cerr << path << ":" << line_number << ": 无效命令: " << line << std::endl;
+            return false;
+        }
+        m_script.push_back(command);
+    }
+    return true;
+}
+
+/**
+ * 脚本线程
+ * 顺序执行命令，遇到 repeat 从头开始；命令执行失败时停止脚本。
+ */
+void ModbusSimulator::script_worker() {
+    size_t pc = 0;
+    while (m_running && pc < m_script.size()) {
+        const std::vector<std::string>& command = m_script[pc++];
+        if (command[0] == "repeat") {
+            pc = 0;
+            continue;
+        }
+        if (command[0] == "sleep") {
+            long ms = 0;
+            if (!parse_int(command[1], ms) || ms < 0) {
+                std::cerr << "脚本: 无效的 sleep 时长: " << command[1] << std::endl;
+                return;
+            }
+            // 分段睡眠以便及时响应 stop()
+            auto until = std::chrono::steady_clock::now() + std::chrono::milliseconds(ms);
+            while (m_running && std::chrono::steady_clock::now() < until) {
+                std::this_thread::sleep_for(std::min<std::chrono::steady_clock::duration>(
+                    until - std::chrono::steady_clock::now(), std::chrono::milliseconds(100)));
+            }
+            continue;
+        }
+        if (!execute(command)) {
+            std::cerr << "脚本: 命令执行失败，停止脚本: " << command[0] << std::endl;
+            return;
+        }
+    }
+}
+
+/**
+ * 执行一条数据或故障命令
+ * @param command 命令及参数
+ * @return 参数是否有效
+ */
+bool ModbusSimulator::execute(const std::vector<std::string>& command) {
+    const std::string& name = command[0];
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    if (name == "latency") {
+        long low = 0;
+        long high = 0;
+        if (!parse_int(command[1], low) || low < 0) return false;
+        high = low;
+        if (command.size() > 2 && (!parse_int(command[2], high) || high < low)) return false;
+        m_faults.min_latency_ms = static_cast<int>(low);
+        m_faults.max_latency_ms = static_cast<int>(high);
+        return true;
+    }
+    if (name == "drop") {
+        return parse_double(command[1], m_faults.drop_percent);
+    }
+    if (name == "exception") {
+        long code = m_faults.exception_code;
+        if (!parse_double(command[1], m_faults.exception_percent)) return false;
+        if (command.size() > 2 && (!parse_int(command[2], code) || code < 1 || code > 0xFF)) return false;
+        m_faults.exception_code = static_cast<int>(code);
+        return true;
+    }
+    if (name == "clear") {
+        m_faults = SimFaults();
+        m_holes.clear();
+        return true;
+    }
+
+    SimTable table;
+    long address = 0;
+    if (!parse_sim_table(command[1], table) || !parse_int(command[2], address)) {
+        return false;
+    }
+    bool bits = table == SimTable::Coils || table == SimTable::DiscreteInputs;
+
+    if (name == "hole") {
+        long count = 0;
+        if (!parse_int(command[3], count) || count < 1) return false;
+        m_holes.push_back(Hole{table, static_cast<int>(address), static_cast<int>(count)});
+        return true;
+    }
+    if (name == "set") {
+        for (size_t i = 3; i < command.size(); ++i) {
+            long value = 0;
+            int target = static_cast<int>(address + static_cast<long>(i) - 3);
+            if (!parse_int(command[i], value)) return false;
+            if (bits) {
+                uint8_t* slot = bit_slot(table, target);
+                if (!slot) return false;
+                *slot = value ? 1 : 0;
+            } else {
+                uint16_t* slot = register_slot(table, target);
+                if (!slot || value < -32768 || value > 65535) return false;
+                *slot = static_cast<uint16_t>(value);
+            }
+        }
+        return true;
+    }
+    if (name == "float") {
+        for (size_t i = 3; i < command.size(); ++i) {
+            double value = 0.0;
+            int target = static_cast<int>(address + 2 * (static_cast<long>(i) - 3));
+            uint16_t* high = register_slot(table, target);
+            uint16_t* low = register_slot(table, target + 1);
+            if (bits || !high || !low || !parse_double(command[i], value)) return false;
+            float fval = static_cast<float>(value);
+            uint32_t raw;
+            std::memcpy(&raw, &fval, sizeof(raw));
+            *high = static_cast<uint16_t>(raw >> 16);
+            *low = static_cast<uint16_t>(raw & 0xFFFF);
+        }
+        return true;
+    }
+
+    long count = 1;
+    long step = 1;
+    if (command.size() > 3 && (!parse_int(command[3], count) || count < 1)) return false;
+    if (command.size() > 4 && !parse_int(command[4], step)) return false;
+    for (long i = 0; i < count; ++i) {
+        int target = static_cast<int>(address + i);
+        if (bits) {
+            uint8_t* slot = bit_slot(table, target);
+            if (!slot) return false;
+            *slot = name == "random" ? static_cast<uint8_t>(m_random() & 1) : static_cast<uint8_t>(!*slot);
+        } else {
+            uint16_t* slot = register_slot(table, target);
+            if (!slot) return false;
+            *slot = name == "random" ? static_cast<uint16_t>(m_random()) : static_cast<uint16_t>(*slot + step);
+        }
+    }
+    return true;
+}
+
+/**
+ * 按间隔输出统计
+ * @param last 上次输出时刻
+ * @param last_requests 上次输出时的请求数
+ */
+void ModbusSimulator::print_statistics(std::chrono::steady_clock::time_point& last, uint64_t& last_requests) {
+    if (m_options.stats_interval <= 0) {
+        return;
+    }
+    auto now = std::chrono::steady_clock::now();
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - last);
+    if (elapsed < std::chrono::seconds(m_options.stats_interval)) {
+        return;
+    }
+    uint64_t requests = m_requests;
+    std::cout << "requests=" << requests << " replies=" << m_replies << " exceptions=" << m_exceptions
+              << " dropped=" << m_dropped
+              << " rate=" << (requests - last_requests) * 1000 / std::max<int64_t>(elapsed.count(), 1) << "/s"
+              << std::endl;
+    last = now;
+    last_requests = requests;
+}
+
+/**
+ * 线圈/离散输入地址对应的存储
+ * @return 超出数据表范围时为空
+ */
+uint8_t* ModbusSimulator::bit_slot(SimTable table, int address) {
+    if (table == SimTable::Coils) {
+        int offset = address - static_cast<int>(m_mapping->start_bits);
+        return offset >= 0 && offset < m_mapping->nb_bits ? &m_mapping->tab_bits[offset] : nullptr;
+    }
+    int offset = address - static_cast<int>(m_mapping->start_input_bits);
+    return offset >= 0 && offset < m_mapping->nb_input_bits ? &m_mapping->tab_input_bits[offset] : nullptr;
+}
+
+/**
+ * 保持/输入寄存器地址对应的存储
+ * @return 超出数据表范围时为空
+ */
+uint16_t* ModbusSimulator::register_slot(SimTable table, int address) {
+    if (table == SimTable::HoldingRegisters) {
+        int offset = address - static_cast<int>(m_mapping->start_registers);
+        return offset >= 0 && offset < m_mapping->nb_registers ? &m_mapping->tab_registers[offset] : nullptr;
+    }
+    int offset = address - static_cast<int>(m_mapping->start_input_registers);
+    return offset >= 0 && offset < m_mapping->nb_input_registers ? &m_mapping->tab_input_registers[offset] : nullptr;
+}
+
+} // namespace southbound
@@ -0,0 +1,155 @@
+#pragma once
+
+#include <modbus/modbus.h>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace southbound {
+
+/**
+ * @brief 模拟器的数据表
+ */
+enum class SimTable {
+    Coils,
+    DiscreteInputs,
+    HoldingRegisters,
+    InputRegisters
+};
+
+/**
+ * @brief 数据表的地址范围
+ */
+struct SimRange {
+    int start{0};
+    int count{10000};
+};
+
+/**
+ * @brief 故障注入参数
+ */
+struct SimFaults {
+    int min_latency_ms{0};      // 应答前的延迟下限
+    int max_latency_ms{0};      // 应答前的延迟上限，在 [下限, 上限] 内均匀分布
+    double drop_percent{0.0};   // 不应答的请求比例（%）
+    double exception_percent{0.0}; // 以异常应答的请求比例（%）
+    int exception_code{MODBUS_EXCEPTION_SLAVE_OR_SERVER_FAILURE};
+};
+
+/**
+ * @brief 模拟器参数
+ */
+struct SimulatorOptions {
+    std::string mode{"tcp"};    // tcp 或 rtu
+    std::string address{"0.0.0.0"};
+    int port{1502};
+    int slave_id{1};            // RTU 从站地址（TCP 应答任意单元标识）
+    int baudrate{115200};
+    char parity{'N'};
+    int data_bits{8};
+    int stop_bits{1};
+    std::string pty_link;       // RTU：为 pty 从端创建的符号链接
+    SimRange coils;
+    SimRange discrete_inputs;
+    SimRange holding_registers;
+    SimRange input_registers;
+    SimFaults faults;
+    std::string script;         // 脚本文件
+    int stats_interval{0};      // 统计输出间隔（秒），0 不输出
+    uint32_t seed{1};           // 故障注入与 random 命令的随机种子
+};
+
+/**
+ * @brief Modbus 从站模拟器
+ * 基于 libmodbus 服务端接口，在 TCP 或 pty（RTU）上应答可配置的数据表。
+ * 支持以脚本按时间修改数据、调整故障参数，并可注入应答延迟、异常应答、丢弃请求与非法地址区间，
+ * 便于在普通 Linux 主机上可重复地测试适配器的吞吐、延迟与故障处理。
+ */
+class ModbusSimulator {
+public:
+    ModbusSimulator() = default;
+    ~ModbusSimulator();
+
+    ModbusSimulator(const ModbusSimulator&) = delete;
+    ModbusSimulator& operator=(const ModbusSimulator&) = delete;
+
+    /**
+     * @brief 创建数据表与监听端点，加载脚本
+     * @param options 模拟器参数
+     * @return 是否成功
+     */
+    bool start(const SimulatorOptions& options);
+
+    /**
+     * @brief 服务请求直到 stop()
+     */
+    void run();
+
+    /**
+     * @brief 请求停止（可在信号处理函数中调用）
+     */
+    void stop() { m_running = false; }
+
+    /**
+     * @brief RTU 模式下供适配器连接的串口路径
+     */
+    const std::string& device_path() const { return m_device_path; }
+
+private:
+    /**
+     * @brief 非法地址区间（应答非法数据地址异常）
+     */
+    struct Hole {
+        SimTable table;
+        int start;
+        int count;
+    };
+
+    SimulatorOptions m_options;
+    modbus_t* m_ctx{nullptr};
+    modbus_mapping_t* m_mapping{nullptr};
+    int m_listen_socket{-1};
+    int m_pty_master{-1};
+    int m_pty_slave{-1};
+    std::string m_device_path;
+
+    std::atomic<bool> m_running{false};
+    std::mutex m_mutex;             // 保护数据表、故障参数、非法区间与随机数发生器
+    SimFaults m_faults;
+    std::vector<Hole> m_holes;
+    std::mt19937 m_random;
+
+    std::vector<std::vector<std::string>> m_script;
+    std::thread m_script_thread;
+
+    std::atomic<uint64_t> m_requests{0};
+    std::atomic<uint64_t> m_replies{0};
+    std::atomic<uint64_t> m_exceptions{0};
+    std::atomic<uint64_t> m_dropped{0};
+
+    bool open_tcp();
+    bool open_pty();
+    void run_tcp();
+    void run_rtu();
+    void handle_request(const uint8_t* request, int length);
+    bool in_hole(const uint8_t* request) const;
+    bool load_script(const std::string& path);
+    bool execute(const std::vector<std::string>& command);
+    void script_worker();
+    void print_statistics(std::chrono::steady_clock::time_point& last, uint64_t& last_requests);
+    uint8_t* bit_slot(SimTable table, int address);
+    uint16_t* register_slot(SimTable table, int address);
+};
+
+/**
+ * @brief 解析数据表名称（coil/discrete/holding/input）
+ * @return 是否解析成功
+ */
+bool parse_sim_table(const std::string& name, SimTable& table);
+
+} // namespace southbound
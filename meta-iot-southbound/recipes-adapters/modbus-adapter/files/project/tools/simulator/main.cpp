@@ -0,0 +1,180 @@
+#include "ModbusSimulator.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <getopt.h>
+#include <iostream>
+#include <signal.h>
+#include <string>
+
+using namespace southbound;
+
+// 全局模拟器实例，用于信号处理
+ModbusSimulator* g_simulator = nullptr;
+
+/**
+ * @brief 终止信号处理函数
+ * @param signal 接收到的信号值
+ */
+void term_handler(int) {
+    if (g_simulator) g_simulator->stop();
+}
+
+/**
+ * @brief 打印使用说明
+ * @param program_name 程序名称
+ */
+void print_usage(const char* program_name) {
+    std::cout << "Usage: " << program_name << " [OPTIONS]\n"
+              << "Options:\n"
+              << "  -m, --mode tcp|rtu          连接方式 (默认: tcp)\n"
+              << "  -a, --address IP            TCP 监听地址 (默认: 0.0.0.0)\n"
+              << "  -p, --port PORT             TCP 端口 (默认: 1502)\n"
+              << "  -s, --slave ID              RTU 从站地址 (默认: 1)\n"
+              << "  -b, --baudrate BAUD         RTU 波特率 (默认: 115200)\n"
+              << "  -l, --link PATH             RTU：为 pty 创建符号链接 (如 /tmp/ttySIM0)\n"
+              << "      --coils START:COUNT     线圈地址范围 (默认: 0:10000)\n"
+              << "      --discrete START:COUNT  离散输入地址范围 (默认: 0:10000)\n"
+              << "      --holding START:COUNT   保持寄存器地址范围 (默认: 0:10000)\n"
+              << "      --input START:COUNT     输入寄存器地址范围 (默认: 0:10000)\n"
+              << "      --latency MIN[:MAX]     应答延迟毫秒数，在 [MIN, MAX] 内均匀分布\n"
+              << "      --drop PERCENT          不应答的请求比例\n"
+              << "      --exception PERCENT[:CODE] 以异常应答的请求比例 (默认异常码 4)\n"
+              << "  -x, --script FILE           脚本文件\n"
+              << "      --stats SECONDS         按间隔输出请求统计\n"
+              << "      --seed N                随机种子 (默认: 1)\n"
+              << "  -h, --help                  显示此帮助信息\n"
+              << "\n"
+              << "示例:\n"
+              << "  " << program_name << " -p 1502 --latency 2:5 --stats 1\n"
+              << "  " << program_name << " -m rtu -l /tmp/ttySIM0 -x scenario.sim\n"
+              << std::endl;
+}
+
+/**
+ * @brief 解析 "A:B" 形式的整数对
+ * @param text 输入
+ * @param first 输出 A
+ * @param second 输出 B；未给出时保持不变
+ * @return 是否解析成功
+ */
+bool parse_pair(const char* text, long& first, long& second) {
+    char* end = nullptr;
+    first = std::strtol(text, &end, 10);
+    if (end == text) return false;
+    if (*end == '\0') return true;
+    if (*end != ':') return false;
+    const char* rest = end + 1;
+    second = std::strtol(rest, &end, 10);
+    return end != rest && *end == '\0';
+}
+
+/**
+ * @brief 解析地址范围
+ */
+bool parse_range(const char* text, SimRange& range) {
+    long start = range.start;
+    long count = range.count;
+    if (!parse_pair(text, start, count) || start < 0 || count < 0 || start + count > 0x10000) {
+        return false;
+    }
+    range.start = static_cast<int>(start);
+    range.count = static_cast<int>(count);
+    return true;
+}
+
+/**
+ * @brief 主程序入口函数
+ * @param argc 命令行参数个数
+ * @param argv 命令行参数数组
+ * @return 程序退出码，0表示成功，非0表示失败
+ */
+int main(int argc, char* argv[]) {
+    SimulatorOptions options;
+
+    enum { OPT_COILS = 256, OPT_DISCRETE, OPT_HOLDING, OPT_INPUT, OPT_LATENCY, OPT_DROP, OPT_EXCEPTION,
+           OPT_STATS, OPT_SEED };
+    static struct option long_options[] = {
+        {"mode",      required_argument, 0, 'm'},
+        {"address",   required_argument, 0, 'a'},
+        {"port",      required_argument, 0, 'p'},
+        {"slave",     required_argument, 0, 's'},
+        {"baudrate",  required_argument, 0, 'b'},
+        {"link",      required_argument, 0, 'l'},
+        {"coils",     required_argument, 0, OPT_COILS},
+        {"discrete",  required_argument, 0, OPT_DISCRETE},
+        {"holding",   required_argument, 0, OPT_HOLDING},
+        {"input",     required_argument, 0, OPT_INPUT},
+        {"latency",   required_argument, 0, OPT_LATENCY},
+        {"drop",      required_argument, 0, OPT_DROP},
+        {"exception", required_argument, 0, OPT_EXCEPTION},
+        {"script",    required_argument, 0, 'x'},
+        {"stats",     required_argument, 0, OPT_STATS},
+        {"seed",      required_argument, 0, OPT_SEED},
+        {"help",      no_argument,       0, 'h'},
+        {0, 0, 0, 0}
+    };
+
+    int option_index = 0;
+    int c;
+    bool valid = true;
+    long first = 0;
+    long second = 0;
+
+    while ((c = getopt_long(argc, argv, "m:a:p:s:b:l:x:h", long_options, &option_index)) != -1) {
+        switch (c) {
+            case 'm': options.mode = optarg; break;
+            case 'a': options.address = optarg; break;
+            case 'p': options.port = std::atoi(optarg); break;
+            case 's': options.slave_id = std::atoi(optarg); break;
+            case 'b': options.baudrate = std::atoi(optarg); break;
+            case 'l': options.pty_link = optarg; break;
+            case 'x': options.script = optarg; break;
+            case OPT_COILS: valid = valid && parse_range(optarg, options.coils); break;
+            case OPT_DISCRETE: valid = valid && parse_range(optarg, options.discrete_inputs); break;
+            case OPT_HOLDING: valid = valid && parse_range(optarg, options.holding_registers); break;
+            case OPT_INPUT: valid = valid && parse_range(optarg, options.input_registers); break;
+            case OPT_LATENCY:
+                second = -1;
+                valid = valid && parse_pair(optarg, first, second) && first >= 0;
+                options.faults.min_latency_ms = static_cast<int>(first);
+                options.faults.max_latency_ms = static_cast<int>(second < 0 ? first : second);
+                valid = valid && options.faults.max_latency_ms >= options.faults.min_latency_ms;
+                break;
+            case OPT_DROP: options.faults.drop_percent = std::atof(optarg); break;
+            case OPT_EXCEPTION:
+                second = options.faults.exception_code;
+                options.faults.exception_percent = std::atof(optarg);
+                if (const char* code = std::strchr(optarg, ':')) {
+                    second = std::atoi(code + 1);
+                }
+                options.faults.exception_code = static_cast<int>(second);
+                break;
+            case OPT_STATS: options.stats_interval = std::atoi(optarg); break;
+            case OPT_SEED: options.seed = static_cast<uint32_t>(std::strtoul(optarg, nullptr, 10)); break;
+            case 'h':
+                print_usage(argv[0]);
+                return 0;
+            default:
+                print_usage(argv[0]);
+                return 1;
+        }
+    }
+    if (!valid || (options.mode != "tcp" && options.mode != "rtu")) {
+        print_usage(argv[0]);
+        return 1;
+    }
+
+    ModbusSimulator simulator;
+    if (!simulator.start(options)) {
+        return 1;
+    }
+
+    g_simulator = &simulator;
+    signal(SIGINT, term_handler);
+    signal(SIGTERM, term_handler);
+
+    simulator.run();
+
+    g_simulator = nullptr;
+    return 0;
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include "southbound/Types.hpp"
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <vector>
+
+namespace southbound {
+
+/**
+ * @brief 异步请求的取消令牌
+ * 复制得到的令牌共享同一取消状态。默认构造的令牌不可取消，需要取消时用 create() 创建。
+ */
+class CancelToken {
+public:
+	CancelToken() = default;
+
+	/**
+	 * 创建可取消的令牌
+	 */
+	static CancelToken create() {
+		CancelToken token;
+		token.m_cancelled = std::make_shared<std::atomic<bool>>(false);
+		return token;
+	}
+
+	/**
+	 * 取消所有持有该状态的请求；对不可取消的令牌无操作
+	 */
+	void cancel() const {
+		if (m_cancelled) {
+			m_cancelled->store(true);
+		}
+	}
+
+	bool cancelled() const { return m_cancelled && m_cancelled->load(); }
+
+private:
+	std::shared_ptr<std::atomic<bool>> m_cancelled;
+};
+
+/**
+ * @brief 异步请求选项
+ */
+struct AsyncOptions {
+	std::chrono::steady_clock::time_point deadline { std::chrono::steady_clock::time_point::max() }; // 截止时间，默认不限
+	CancelToken cancel;
+
+	/**
+	 * 以相对超时设置截止时间
+	 */
+	static AsyncOptions within(std::chrono::milliseconds timeout, CancelToken token = CancelToken()) {
+		AsyncOptions options;
+		options.deadline = std::chrono::steady_clock::now() + timeout;
+		options.cancel = token;
+		return options;
+	}
+
+	/**
+	 * 请求开始执行前检查：已取消返回 Cancelled，已过截止时间返回 Timeout，否则返回 OK
+	 */
+	StatusCode admit() const {
+		if (cancel.cancelled()) {
+			return StatusCode::Cancelled;
+		}
+		if (std::chrono::steady_clock::now() >= deadline) {
+			return StatusCode::Timeout;
+		}
+		return StatusCode::OK;
+	}
+};
+
+/**
+ * @brief 异步读取结果（future 形式）
+ */
+struct AsyncReadResult {
+	StatusCode status { StatusCode::Error };
+	std::vector<DataValue> values;
+};
+
+// 异步读取完成回调，values 与请求的标签一一对应
+using ReadHandler = std::function<void(StatusCode status, std::vector<DataValue> values)>;
+
+// 异步写入完成回调
+using WriteHandler = std::function<void(StatusCode status)>;
+
+} // namespace southbound
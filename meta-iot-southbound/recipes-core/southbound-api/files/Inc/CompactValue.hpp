@@ -0,0 +1,244 @@
+#pragma once
+
+#include "southbound/Types.hpp"
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace southbound {
+
+/**
+ * @brief 紧凑数据值的类型标记，取值与 DataValue::value 的变体下标一致
+ */
+enum class ValueType : uint8_t {
+	Bool,
+	Int32,
+	UInt32,
+	Float,
+	Double,
+	String,
+	Int64
+};
+
+/**
+ * @brief 字符串池
+ * 紧凑数据值中的字符串存放在池中，值内只记录 (偏移, 长度)；池内容为一段连续字节，
+ * 可与值数组一起整体复制或放入共享内存。非线程安全，同一个池只能由一个线程写入。
+ */
+class CompactStringPool {
+public:
+	/**
+	 * 追加字符串
+	 * @return 字符串引用（高 32 位为偏移，低 32 位为长度）
+	 */
+	uint64_t append(std::string_view text) {
+		uint64_t ref = static_cast<uint64_t>(m_chars.size()) << 32 | static_cast<uint32_t>(text.size());
+		m_chars.append(text.data(), text.size());
+		return ref;
+	}
+
+	/**
+	 * 按引用取字符串；越界时返回空串
+	 */
+	std::string_view view(uint64_t ref) const {
+		size_t offset = static_cast<size_t>(ref >> 32);
+		size_t length = static_cast<uint32_t>(ref);
+		if (offset + length > m_chars.size()) {
+			return std::string_view();
+		}
+		return std::string_view(m_chars.data() + offset, length);
+	}
+
+	void clear() { m_chars.clear(); }
+	size_t size() const { return m_chars.size(); }
+	const char *data() const { return m_chars.data(); }
+
+private:
+	std::string m_chars;
+};
+
+/**
+ * @brief 紧凑数据值
+ * 16 字节、可平凡复制：8 字节数值（按类型以原生表示存放），48 位毫秒时间戳，类型标记与质量。
+ * 字符串不在值内，payload 为 CompactStringPool 中的引用。值数组可直接 memcpy 或跨进程共享
+ * （含字符串时需连同字符串池一起复制）。
+ */
+struct CompactValue {
+	uint64_t payload { 0 };         // 数值的内存表示，或字符串引用
+	uint32_t timestamp_low { 0 };   // 时间戳低 32 位
+	uint16_t timestamp_high { 0 };  // 时间戳高 16 位（48 位毫秒时间戳可表示到公元 10000 年以后）
+	ValueType type { ValueType::Bool };
+	uint8_t quality { 0 };          // 与 DataValue::quality 相同，0=Bad, 1=Good
+
+	uint64_t timestamp_ms() const {
+		return static_cast<uint64_t>(timestamp_high) << 32 | timestamp_low;
+	}
+
+	void set_timestamp_ms(uint64_t timestamp) {
+		timestamp_low = static_cast<uint32_t>(timestamp);
+		timestamp_high = static_cast<uint16_t>(timestamp >> 32);
+	}
+
+	/**
+	 * 写入数值并设置类型标记
+	 * T 为 bool、int32_t、uint32_t、int64_t、float、double 之一
+	 */
+	template <typename T>
+	void set(T value) {
+		type = type_of<T>();
+		payload = 0;
+		std::memcpy(&payload, &value, sizeof(T));
+	}
+
+	/**
+	 * 按 T 读取数值，调用方须先检查 type
+	 */
+	template <typename T>
+	T get() const {
+		static_assert(type_of<T>() != ValueType::String, "unsupported type");
+		T value;
+		std::memcpy(&value, &payload, sizeof(T));
+		return value;
+	}
+
+	/**
+	 * 取数值的 double 值
+	 * @return 非数值类型（bool/string）返回 false
+	 */
+	bool as_double(double &out) const {
+		switch (type) {
+		case ValueType::Int32: out = get<int32_t>(); return true;
+		case ValueType::UInt32: out = get<uint32_t>(); return true;
+		case ValueType::Int64: out = static_cast<double>(get<int64_t>()); return true;
+		case ValueType::Float: out = get<float>(); return true;
+		case ValueType::Double: out = get<double>(); return true;
+		default: return false;
+		}
+	}
+
+	template <typename T>
+	static constexpr ValueType type_of() {
+		if constexpr (std::is_same_v<T, bool>) return ValueType::Bool;
+		else if constexpr (std::is_same_v<T, int32_t>) return ValueType::Int32;
+		else if constexpr (std::is_same_v<T, uint32_t>) return ValueType::UInt32;
+		else if constexpr (std::is_same_v<T, int64_t>) return ValueType::Int64;
+		else if constexpr (std::is_same_v<T, float>) return ValueType::Float;
+		else if constexpr (std::is_same_v<T, double>) return ValueType::Double;
+		else return ValueType::String;
+	}
+};
+
+static_assert(sizeof(CompactValue) == 16, "CompactValue must stay 16 bytes");
+static_assert(std::is_trivially_copyable_v<CompactValue>, "CompactValue must be trivially copyable");
+static_assert(std::is_standard_layout_v<CompactValue>, "CompactValue must be standard layout");
+
+/**
+ * @brief DataValue 转为紧凑数据值
+ * @param value 原数据值
+ * @param out 输出
+ * @param strings 字符串池；为空时字符串值转换失败
+ * @return 转换成功返回 true
+ */
+inline bool to_compact(const DataValue &value, CompactValue &out, CompactStringPool *strings = nullptr) {
+	out.set_timestamp_ms(value.timestamp_ms);
+	out.quality = value.quality;
+	if (const auto *text = std::get_if<std::string>(&value.value)) {
+		if (!strings) {
+			return false;
+		}
+		out.type = ValueType::String;
+		out.payload = strings->append(*text);
+		return true;
+	}
+	std::visit([&out](const auto &v) {
+		using T = std::decay_t<decltype(v)>;
+		if constexpr (!std::is_same_v<T, std::string>) {
+			out.set<T>(v);
+		}
+	}, value.value);
+	return true;
+}
+
+/**
+ * @brief 紧凑数据值转为 DataValue
+ * @param value 紧凑数据值
+ * @param strings 字符串池；为空时字符串值还原为空串
+ * @return 数据值
+ */
+inline DataValue to_data_value(const CompactValue &value, const CompactStringPool *strings = nullptr) {
+	DataValue out;
+	out.timestamp_ms = value.timestamp_ms();
+	out.quality = value.quality;
+	switch (value.type) {
+	case ValueType::Bool: out.value = value.get<bool>(); break;
+	case ValueType::Int32: out.value = value.get<int32_t>(); break;
+	case ValueType::UInt32: out.value = value.get<uint32_t>(); break;
+	case ValueType::Int64: out.value = value.get<int64_t>(); break;
+	case ValueType::Float: out.value = value.get<float>(); break;
+	case ValueType::Double: out.value = value.get<double>(); break;
+	case ValueType::String: out.value = strings ? std::string(strings->view(value.payload)) : std::string(); break;
+	}
+	return out;
+}
+
+/**
+ * @brief 批量转为紧凑数据值
+ * @return 全部转换成功返回 true；失败的值类型为 String、质量为 0
+ */
+inline bool to_compact(const std::vector<DataValue> &values, std::vector<CompactValue> &out,
+					   CompactStringPool *strings = nullptr) {
+	bool ok = true;
+	out.resize(values.size());
+	for (size_t i = 0; i < values.size(); ++i) {
+		if (!to_compact(values[i], out[i], strings)) {
+			out[i].type = ValueType::String;
+			out[i].payload = 0;
+			out[i].quality = 0;
+			ok = false;
+		}
+	}
+	return ok;
+}
+
+/**
+ * @brief 批量还原为 DataValue
+ */
+inline void to_data_values(const std::vector<CompactValue> &values, std::vector<DataValue> &out,
+						   const CompactStringPool *strings = nullptr) {
+	out.resize(values.size());
+	for (size_t i = 0; i < values.size(); ++i) {
+		out[i] = to_data_value(values[i], strings);
+	}
+}
+
+/**
+ * @brief 批量回调中的一个点位值
+ */
+struct TagSample {
+	uint32_t index { 0 };   // 点位在订阅标签列表中的下标
+	CompactValue value;
+};
+
+static_assert(std::is_trivially_copyable_v<TagSample>, "TagSample must be trivially copyable");
+
+/**
+ * @brief 批量回调的点位值序列（连续存放，只在回调期间有效）
+ */
+struct TagSampleSpan {
+	const TagSample *data { nullptr };
+	size_t size { 0 };
+	const CompactStringPool *strings { nullptr }; // 字符串值所在的池，没有字符串值时可为空
+
+	const TagSample *begin() const { return data; }
+	const TagSample *end() const { return data + size; }
+	const TagSample &operator[](size_t i) const { return data[i]; }
+	bool empty() const { return size == 0; }
+};
+
+// 批量订阅回调：以订阅下标回传本周期的点位值，序列来自适配器复用的缓冲区
+using OnBatchDataCallback = std::function<void(const TagSampleSpan &)>;
+
+} // namespace southbound
@@ -1,6 +1,12 @@
 #pragma once
 
+#include "southbound/Async.hpp"
+#include "southbound/CompactValue.hpp"
+#include "southbound/TagRegistry.hpp"
 #include "southbound/Types.hpp"
+#include <chrono>
+#include <future>
+#include <memory>
 
 namespace southbound {
 
@@ -47,6 +53,190 @@ public:
 	 * 获取当前适配器的健康状态
 	 */
 	virtual StatusCode get_status() = 0;
+
+	// 初始接口之后增加的方法：新的虚函数只能追加在类末尾，已有虚函数的顺序保持不变，
+	// 按旧头文件构建、以 dlopen 加载的插件的虚表槽位因此仍然有效
+
+	/**
+	 * 获取适配器运行统计（可选，默认不支持）
+	 */
+	virtual StatusCode get_statistics(AdapterStatistics &stats) {
+		(void)stats;
+		return StatusCode::NotSupported;
+	}
+
+	/**
+	 * [同步] 写入后读取（组合控制周期）
+	 * 默认依次调用 write() 与 read()；支持组合事务的适配器可覆盖以减少往返。
+	 */
+	virtual StatusCode write_read(const std::map<DeviceTag, DataValue> &tags_and_values,
+								  const std::vector<DeviceTag> &read_tags, std::vector<DataValue> &values) {
+		StatusCode result = write(tags_and_values);
+		if (result != StatusCode::OK) {
+			return result;
+		}
+		return read(read_tags, values);
+	}
+
+	/**
+	 * [同步] 读取设备数据，允许使用不超过 max_age 的缓存值
+	 * 适配器可用扫描得到的最新值应答，只有过期或缺失的标签访问设备；默认总是调用 read()。
+	 */
+	virtual StatusCode read_cached(const std::vector<DeviceTag> &tags, std::vector<DataValue> &values,
+								   std::chrono::milliseconds max_age) {
+		(void)max_age;
+		return read(tags, values);
+	}
+
+	/**
+	 * [同步] 按 TagId 读取设备数据
+	 * 默认还原为 DeviceTag 后调用 read()；适配器可按 TagId 缓存解析结果，免去属性解析与比较。
+	 * @param registry 点位登记表
+	 * @param ids 点位 TagId 列表
+	 * @param values 输出数据值，与 ids 一一对应
+	 */
+	virtual StatusCode read_ids(const TagRegistry &registry, const std::vector<TagId> &ids, std::vector<DataValue> &values) {
+		std::vector<DeviceTag> tags;
+		tags.reserve(ids.size());
+		for (TagId id : ids) {
+			tags.push_back(registry.tag(id));
+		}
+		return read(tags, values);
+	}
+
+	/**
+	 * [同步] 按 TagId 向设备写入数据
+	 * 默认还原为 DeviceTag 后调用 write()。
+	 * @param registry 点位登记表
+	 * @param values 待写入的点位与数值
+	 */
+	virtual StatusCode write_ids(const TagRegistry &registry, const std::vector<TagValue> &values) {
+		std::map<DeviceTag, DataValue> tags_and_values;
+		for (const TagValue &value : values) {
+			tags_and_values[registry.tag(value.id)] = value.value;
+		}
+		return write(tags_and_values);
+	}
+
+	/**
+	 * [异步] 按 TagId 订阅数据变化，回调以 TagId 回传数值
+	 * 登记表只在调用期间使用。默认还原为 DeviceTag 后调用 subscribe()，回调中按点位反查 TagId。
+	 * @param registry 点位登记表
+	 * @param ids 订阅的点位 TagId 列表
+	 * @param callback 数据到达时回调
+	 */
+	virtual StatusCode subscribe_ids(const TagRegistry &registry, const std::vector<TagId> &ids, OnTagDataCallback callback) {
+		std::vector<DeviceTag> tags;
+		auto index = std::make_shared<std::map<DeviceTag, TagId>>();
+		tags.reserve(ids.size());
+		for (TagId id : ids) {
+			tags.push_back(registry.tag(id));
+			index->emplace(tags.back(), id);
+		}
+		return subscribe(tags, [index, callback](const std::map<DeviceTag, DataValue> &tags_and_values) {
+			std::vector<TagValue> values;
+			values.reserve(tags_and_values.size());
+			for (const auto &pair : tags_and_values) {
+				auto it = index->find(pair.first);
+				if (it != index->end()) {
+					values.push_back(TagValue { it->second, pair.second });
+				}
+			}
+			callback(values);
+		});
+	}
+
+	/**
+	 * [异步] 订阅数据变化，以连续的 (订阅下标, 紧凑数据值) 序列回调
+	 * 稳态下适配器复用同一缓冲区，回调路径不分配内存、不复制 DeviceTag。
+	 * 默认在 subscribe() 的 map 回调上转换，不具备上述性质；适配器可直接实现。
+	 * @param tags 订阅的设备标签列表，回调中的下标即其中的位置
+	 * @param callback 数据到达时回调，序列只在回调期间有效
+	 */
+	virtual StatusCode subscribe_batch(const std::vector<DeviceTag> &tags, OnBatchDataCallback callback) {
+		struct Buffer {
+			std::map<DeviceTag, uint32_t> index;
+			std::vector<TagSample> samples;
+			CompactStringPool strings;
+		};
+		auto buffer = std::make_shared<Buffer>();
+		for (size_t i = 0; i < tags.size(); ++i) {
+			buffer->index.emplace(tags[i], static_cast<uint32_t>(i));
+		}
+		return subscribe(tags, [buffer, callback](const std::map<DeviceTag, DataValue> &tags_and_values) {
+			buffer->samples.clear();
+			buffer->strings.clear();
+			for (const auto &pair : tags_and_values) {
+				auto it = buffer->index.find(pair.first);
+				if (it != buffer->index.end()) {
+					TagSample sample;
+					sample.index = it->second;
+					to_compact(pair.second, sample.value, &buffer->strings);
+					buffer->samples.push_back(sample);
+				}
+			}
+			callback(TagSampleSpan { buffer->samples.data(), buffer->samples.size(), &buffer->strings });
+		});
+	}
+
+	/**
+	 * [异步] 读取设备数据，完成时调用 handler
+	 * 取消与截止时间在请求开始访问设备前检查，命中时 handler 收到 Cancelled 或 Timeout；
+	 * 已开始的请求执行到完成。每个请求的 handler 恰好调用一次，调用线程由适配器决定，
+	 * 但不得是执行设备 I/O 的线程：handler 中可以调用本适配器的任何方法（包括 unsubscribe()、disconnect()）。
+	 * 默认在调用线程上同步执行 read() 后调用 handler；适配器可覆盖以使多个请求并发进行。
+	 * @param tags 待读取的设备标签列表
+	 * @param options 截止时间与取消令牌
+	 * @param handler 完成回调
+	 */
+	virtual void read_async(const std::vector<DeviceTag> &tags, const AsyncOptions &options, ReadHandler handler) {
+		std::vector<DataValue> values;
+		StatusCode result = options.admit();
+		if (result == StatusCode::OK) {
+			result = read(tags, values);
+		}
+		handler(result, std::move(values));
+	}
+
+	/**
+	 * [异步] 向设备写入数据，完成时调用 handler
+	 * 取消、截止时间与 handler 的约定同 read_async()；默认在调用线程上同步执行 write()。
+	 * @param tags_and_values 待写入的标签与数值映射
+	 * @param options 截止时间与取消令牌
+	 * @param handler 完成回调
+	 */
+	virtual void write_async(const std::map<DeviceTag, DataValue> &tags_and_values, const AsyncOptions &options,
+							 WriteHandler handler) {
+		StatusCode result = options.admit();
+		if (result == StatusCode::OK) {
+			result = write(tags_and_values);
+		}
+		handler(result);
+	}
+
+	/**
+	 * [异步] 读取设备数据，以 future 返回结果
+	 */
+	std::future<AsyncReadResult> read_async(const std::vector<DeviceTag> &tags,
+											const AsyncOptions &options = AsyncOptions()) {
+		auto promise = std::make_shared<std::promise<AsyncReadResult>>();
+		std::future<AsyncReadResult> result = promise->get_future();
+		read_async(tags, options, [promise](StatusCode status, std::vector<DataValue> values) {
+			promise->set_value(AsyncReadResult { status, std::move(values) });
+		});
+		return result;
+	}
+
+	/**
+	 * [异步] 向设备写入数据，以 future 返回状态码
+	 */
+	std::future<StatusCode> write_async(const std::map<DeviceTag, DataValue> &tags_and_values,
+										const AsyncOptions &options = AsyncOptions()) {
+		auto promise = std::make_shared<std::promise<StatusCode>>();
+		std::future<StatusCode> result = promise->get_future();
+		write_async(tags_and_values, options, [promise](StatusCode status) { promise->set_value(status); });
+		return result;
+	}
 };
 
 } // namespace southbound 
\ No newline at end of file
@@ -0,0 +1,274 @@
+#pragma once
+
+#include "southbound/Types.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace southbound {
+
+/**
+ * @brief 已登记点位的紧凑句柄，由 TagRegistry 按登记顺序从 0 分配
+ */
+using TagId = uint32_t;
+
+constexpr TagId INVALID_TAG_ID = std::numeric_limits<TagId>::max();
+
+/**
+ * @brief 以 TagId 标识的点位值
+ */
+struct TagValue {
+	TagId id { INVALID_TAG_ID };
+	DataValue value;
+};
+
+// 以 TagId 回传的异步订阅回调，一次可回传多个点位的最新值
+using OnTagDataCallback = std::function<void(const std::vector<TagValue> &)>;
+
+/**
+ * @brief 点位登记表
+ * 每个 DeviceTag 只登记一次，得到稠密的整数 TagId。属性键与值的字符串全局去重后存放在一块连续缓冲中，
+ * 每个点位只保存若干 (键, 值) 字符串编号；按 DeviceTag 查找使用开放寻址哈希表。
+ * 热路径（读写、订阅回调）以 TagId 传递点位，不再比较属性 map。
+ * 登记与查询可并发调用；已分配的 TagId 在登记表生命周期内保持不变。
+ */
+class TagRegistry {
+public:
+	TagRegistry() : m_uid(next_uid()) {}
+
+	TagRegistry(const TagRegistry &) = delete;
+	TagRegistry &operator=(const TagRegistry &) = delete;
+
+	/**
+	 * 登记点位，已登记时返回原有 TagId
+	 */
+	TagId intern(const DeviceTag &tag) {
+		std::unique_lock<std::shared_mutex> lock(m_mutex);
+		std::vector<Attribute> attributes;
+		attributes.reserve(tag.attributes.size());
+		for (const auto &pair : tag.attributes) {
+			attributes.push_back(Attribute { intern_text(pair.first), intern_text(pair.second) });
+		}
+
+		uint64_t hash = hash_attributes(attributes.data(), attributes.size());
+		TagId id = find_tag(attributes, hash);
+		if (id != INVALID_TAG_ID) {
+			return id;
+		}
+
+		id = static_cast<TagId>(m_tags.size());
+		m_tags.push_back(Range { static_cast<uint32_t>(m_attributes.size()), static_cast<uint32_t>(attributes.size()) });
+		m_attributes.insert(m_attributes.end(), attributes.begin(), attributes.end());
+		grow(m_tag_slots, m_tags.size(), [this](uint32_t tag_id) {
+			const Range &range = m_tags[tag_id];
+			return hash_attributes(m_attributes.data() + range.offset, range.count);
+		});
+		insert_slot(m_tag_slots, hash, id);
+		return id;
+	}
+
+	/**
+	 * 查找点位，未登记时返回 INVALID_TAG_ID
+	 */
+	TagId find(const DeviceTag &tag) const {
+		std::shared_lock<std::shared_mutex> lock(m_mutex);
+		std::vector<Attribute> attributes;
+		attributes.reserve(tag.attributes.size());
+		for (const auto &pair : tag.attributes) {
+			uint32_t key = find_text(pair.first);
+			uint32_t value = find_text(pair.second);
+			if (key == EMPTY || value == EMPTY) {
+				return INVALID_TAG_ID;
+			}
+			attributes.push_back(Attribute { key, value });
+		}
+		return find_tag(attributes, hash_attributes(attributes.data(), attributes.size()));
+	}
+
+	/**
+	 * 还原点位属性；TagId 无效时返回空点位
+	 */
+	DeviceTag tag(TagId id) const {
+		std::shared_lock<std::shared_mutex> lock(m_mutex);
+		DeviceTag tag;
+		if (id < m_tags.size()) {
+			const Range &range = m_tags[id];
+			for (uint32_t i = 0; i < range.count; ++i) {
+				const Attribute &attribute = m_attributes[range.offset + i];
+				tag.attributes.emplace(text(attribute.key), text(attribute.value));
+			}
+		}
+		return tag;
+	}
+
+	/**
+	 * 读取单个属性
+	 * @return 点位含该属性时返回 true
+	 */
+	bool attribute(TagId id, std::string_view key, std::string &value) const {
+		std::shared_lock<std::shared_mutex> lock(m_mutex);
+		if (id >= m_tags.size()) {
+			return false;
+		}
+		const Range &range = m_tags[id];
+		for (uint32_t i = 0; i < range.count; ++i) {
+			const Attribute &attribute = m_attributes[range.offset + i];
+			if (text(attribute.key) == key) {
+				value = text(attribute.value);
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * 已登记的点位数（TagId 取值范围为 [0, size())）
+	 */
+	size_t size() const {
+		std::shared_lock<std::shared_mutex> lock(m_mutex);
+		return m_tags.size();
+	}
+
+	/**
+	 * 登记表占用的内存（字节，按容量估算）
+	 */
+	size_t memory_usage() const {
+		std::shared_lock<std::shared_mutex> lock(m_mutex);
+		return sizeof(*this) + m_chars.capacity() + m_texts.capacity() * sizeof(Text)
+			+ m_text_slots.capacity() * sizeof(uint32_t) + m_attributes.capacity() * sizeof(Attribute)
+			+ m_tags.capacity() * sizeof(Range) + m_tag_slots.capacity() * sizeof(uint32_t);
+	}
+
+	/**
+	 * 进程内唯一的登记表编号，适配器据此判断按 TagId 缓存的解析结果是否仍然适用
+	 */
+	uint64_t uid() const { return m_uid; }
+
+private:
+	static constexpr uint32_t EMPTY = std::numeric_limits<uint32_t>::max();
+
+	struct Text {
+		uint32_t offset;
+		uint32_t length;
+	};
+
+	struct Attribute {
+		uint32_t key;   // 字符串编号
+		uint32_t value;
+	};
+
+	struct Range {
+		uint32_t offset; // m_attributes 中的起始位置
+		uint32_t count;
+	};
+
+	mutable std::shared_mutex m_mutex;
+	const uint64_t m_uid;
+	std::string m_chars;                // 去重后的字符串，首尾相接
+	std::vector<Text> m_texts;          // 字符串编号 -> 位置
+	std::vector<uint32_t> m_text_slots; // 字符串哈希表（开放寻址，存字符串编号）
+	std::vector<Attribute> m_attributes;
+	std::vector<Range> m_tags;          // TagId -> 属性区间（按键升序，与 DeviceTag 相同）
+	std::vector<uint32_t> m_tag_slots;  // 点位哈希表（开放寻址，存 TagId）
+
+	static uint64_t next_uid() {
+		static std::atomic<uint64_t> counter { 0 };
+		return ++counter;
+	}
+
+	// FNV-1a
+	static uint64_t hash_bytes(const void *data, size_t size, uint64_t hash = 14695981039346656037ull) {
+		const unsigned char *bytes = static_cast<const unsigned char *>(data);
+		for (size_t i = 0; i < size; ++i) {
+			hash = (hash ^ bytes[i]) * 1099511628211ull;
+		}
+		return hash;
+	}
+
+	static uint64_t hash_attributes(const Attribute *attributes, size_t count) {
+		return hash_bytes(attributes, count * sizeof(Attribute));
+	}
+
+	std::string_view text(uint32_t id) const {
+		return std::string_view(m_chars.data() + m_texts[id].offset, m_texts[id].length);
+	}
+
+	uint32_t find_text(std::string_view value) const {
+		if (m_text_slots.empty()) {
+			return EMPTY;
+		}
+		size_t mask = m_text_slots.size() - 1;
+		for (size_t slot = hash_bytes(value.data(), value.size()) & mask;; slot = (slot + 1) & mask) {
+			uint32_t id = m_text_slots[slot];
+			if (id == EMPTY || text(id) == value) {
+				return id;
+			}
+		}
+	}
+
+	uint32_t intern_text(std::string_view value) {
+		uint32_t id = find_text(value);
+		if (id != EMPTY) {
+			return id;
+		}
+		id = static_cast<uint32_t>(m_texts.size());
+		m_texts.push_back(Text { static_cast<uint32_t>(m_chars.size()), static_cast<uint32_t>(value.size()) });
+		m_chars.append(value.data(), value.size());
+		grow(m_text_slots, m_texts.size(), [this](uint32_t text_id) {
+			std::string_view stored = text(text_id);
+			return hash_bytes(stored.data(), stored.size());
+		});
+		insert_slot(m_text_slots, hash_bytes(value.data(), value.size()), id);
+		return id;
+	}
+
+	TagId find_tag(const std::vector<Attribute> &attributes, uint64_t hash) const {
+		if (m_tag_slots.empty()) {
+			return INVALID_TAG_ID;
+		}
+		size_t mask = m_tag_slots.size() - 1;
+		for (size_t slot = hash & mask;; slot = (slot + 1) & mask) {
+			TagId id = m_tag_slots[slot];
+			if (id == EMPTY) {
+				return INVALID_TAG_ID;
+			}
+			const Range &range = m_tags[id];
+			if (range.count == attributes.size()
+				&& std::equal(attributes.begin(), attributes.end(), m_attributes.begin() + range.offset,
+							  [](const Attribute &a, const Attribute &b) { return a.key == b.key && a.value == b.value; })) {
+				return id;
+			}
+		}
+	}
+
+	static void insert_slot(std::vector<uint32_t> &slots, uint64_t hash, uint32_t id) {
+		size_t mask = slots.size() - 1;
+		size_t slot = hash & mask;
+		while (slots[slot] != EMPTY) {
+			slot = (slot + 1) & mask;
+		}
+		slots[slot] = id;
+	}
+
+	/**
+	 * 装载率超过 1/2 时将哈希表扩大一倍并重新插入编号 [0, count - 1)
+	 */
+	template <typename Hash>
+	static void grow(std::vector<uint32_t> &slots, size_t count, Hash hash) {
+		if (count * 2 <= slots.size()) {
+			return;
+		}
+		slots.assign(std::max<size_t>(16, slots.size() * 2), EMPTY);
+		for (uint32_t id = 0; id + 1 < count; ++id) {
+			insert_slot(slots, hash(id), id);
+		}
+	}
+};
+
+} // namespace southbound
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstdio>
+#include <cstdlib>
+
+/**
+ * @brief 单元测试断言：条件不成立时打印位置并以失败状态退出
+ * 与 assert 不同，不受 NDEBUG 影响，Release 构建下同样生效。
+ * 供 API 自身与各适配器的单元测试共用，只应在测试程序中包含。
+ */
+#define CHECK(condition) \
+	do { \
+		if (!(condition)) { \
+			std::fprintf(stderr, "%s:%d: CHECK(%s) failed\n", __FILE__, __LINE__, #condition); \
+			std::exit(1); \
+		} \
+	} while (0)
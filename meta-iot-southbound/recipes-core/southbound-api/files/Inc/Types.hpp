@@ -22,7 +22,8 @@ enum class StatusCode {
 	AlreadyConnected,
 	NotInitialized,
 	InvalidParam,
-	NotSupported
+	NotSupported,
+	Cancelled
 };
 
 /**
@@ -56,7 +57,7 @@ struct DeviceTag {
  * 
  */
 struct DataValue {
-	std::variant<bool, int32_t, uint32_t, float, double, std::string> value;
+	std::variant<bool, int32_t, uint32_t, float, double, std::string, int64_t> value; // 新类型只能追加在末尾，保持已有下标不变
 	uint64_t timestamp_ms { 0 }; // Unix epoch in milliseconds
 	uint8_t quality { 0 };      // 0=Bad, 1=Good, etc.
 };
@@ -64,6 +65,9 @@ struct DataValue {
 // 统一配置键值格式, 约定的 key 需由具体适配器文档说明
 using AdapterConfig = std::map<std::string, std::string>;
 
+// 适配器运行统计，键名由具体适配器文档说明
+using AdapterStatistics = std::map<std::string, uint64_t>;
+
 // 异步订阅回调，一次可回传多个点位的最新值
 using OnDataReceivedCallback = std::function<void(const std::map<DeviceTag, DataValue> &)>;
 
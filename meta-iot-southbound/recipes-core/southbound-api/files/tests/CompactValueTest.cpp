@@ -0,0 +1,164 @@
+#include <southbound/CompactValue.hpp>
+#include <southbound/TestCheck.hpp>
+#include <cstring>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+using namespace southbound;
+
+namespace {
+
+DataValue make_value(decltype(DataValue::value) value, uint64_t timestamp_ms = 0, uint8_t quality = 1) {
+	DataValue out;
+	out.value = std::move(value);
+	out.timestamp_ms = timestamp_ms;
+	out.quality = quality;
+	return out;
+}
+
+/**
+ * 两个数据值的类型、数值（按位比较，NaN 也视为相等）、时间戳与质量都相同
+ */
+bool same_value(const DataValue &a, const DataValue &b) {
+	if (a.value.index() != b.value.index() || a.timestamp_ms != b.timestamp_ms || a.quality != b.quality) {
+		return false;
+	}
+	return std::visit([&b](const auto &x) {
+		using V = std::decay_t<decltype(x)>;
+		const V &y = std::get<V>(b.value);
+		if constexpr (std::is_same_v<V, std::string>) {
+			return x == y;
+		} else {
+			return std::memcmp(&x, &y, sizeof(V)) == 0;
+		}
+	}, a.value);
+}
+
+/**
+ * 类型标记与 DataValue::value 的变体下标一致
+ */
+void test_type_index() {
+	const std::vector<DataValue> values = {
+		make_value(true), make_value(int32_t(1)), make_value(uint32_t(1)), make_value(1.0f),
+		make_value(1.0), make_value(std::string("x")), make_value(int64_t(1)),
+	};
+	CompactStringPool strings;
+	for (const DataValue &value : values) {
+		CompactValue compact;
+		CHECK(to_compact(value, compact, &strings));
+		CHECK(static_cast<size_t>(compact.type) == value.value.index());
+	}
+}
+
+/**
+ * 各数值类型的边界值往返不变，时间戳保留 48 位
+ */
+void test_round_trip() {
+	const uint64_t timestamp = (uint64_t(1) << 48) - 1;
+	const std::vector<DataValue> values = {
+		make_value(false, 0, 0),
+		make_value(true, 1700000000123ull),
+		make_value(std::numeric_limits<int32_t>::min(), timestamp),
+		make_value(std::numeric_limits<uint32_t>::max()),
+		make_value(std::numeric_limits<int64_t>::min()),
+		make_value(std::numeric_limits<int64_t>::max()),
+		make_value(-0.0f),
+		make_value(std::numeric_limits<float>::quiet_NaN()),
+		make_value(std::numeric_limits<double>::denorm_min()),
+		make_value(-std::numeric_limits<double>::infinity(), 42, 0),
+	};
+	for (const DataValue &value : values) {
+		CompactValue compact;
+		CHECK(to_compact(value, compact));
+		CHECK(compact.timestamp_ms() == value.timestamp_ms && compact.quality == value.quality);
+		CHECK(same_value(to_data_value(compact), value));
+	}
+
+	CompactValue compact;
+	compact.set<int32_t>(-1);
+	compact.set<bool>(true); // 重新写入时清除高位
+	CHECK(compact.type == ValueType::Bool && compact.payload == 1);
+}
+
+/**
+ * 字符串存放在池中；没有池时转换失败，越界引用还原为空串
+ */
+void test_strings() {
+	CompactStringPool strings;
+	CompactValue first, second, empty;
+	CHECK(to_compact(make_value(std::string("hello"), 7), first, &strings));
+	CHECK(to_compact(make_value(std::string("world!"), 8), second, &strings));
+	CHECK(to_compact(make_value(std::string()), empty, &strings));
+	CHECK(strings.size() == 11 && std::string(strings.data(), strings.size()) == "helloworld!");
+
+	CHECK(same_value(to_data_value(first, &strings), make_value(std::string("hello"), 7)));
+	CHECK(same_value(to_data_value(second, &strings), make_value(std::string("world!"), 8)));
+	CHECK(same_value(to_data_value(empty, &strings), make_value(std::string())));
+	CHECK(std::get<std::string>(to_data_value(first).value).empty());
+
+	CompactValue without_pool;
+	CHECK(!to_compact(make_value(std::string("hello")), without_pool));
+
+	CHECK(strings.view(uint64_t(100) << 32 | 1).empty());
+	CHECK(strings.view(uint64_t(10) << 32 | 2).empty());
+	strings.clear();
+	CHECK(strings.size() == 0 && strings.view(first.payload).empty());
+}
+
+/**
+ * 批量转换：失败的值标记为 String、质量 0，其余照常转换
+ */
+void test_batch() {
+	std::vector<DataValue> values = {
+		make_value(int32_t(5), 10), make_value(std::string("text"), 20), make_value(2.5, 30),
+	};
+	std::vector<CompactValue> compact;
+	CHECK(!to_compact(values, compact));
+	CHECK(compact.size() == 3);
+	CHECK(compact[1].type == ValueType::String && compact[1].payload == 0 && compact[1].quality == 0);
+
+	std::vector<DataValue> restored;
+	to_data_values(compact, restored);
+	CHECK(restored.size() == 3);
+	CHECK(same_value(restored[0], values[0]) && same_value(restored[2], values[2]));
+
+	CompactStringPool strings;
+	CHECK(to_compact(values, compact, &strings));
+	to_data_values(compact, restored, &strings);
+	for (size_t i = 0; i < values.size(); ++i) {
+		CHECK(same_value(restored[i], values[i]));
+	}
+}
+
+/**
+ * as_double 只接受数值类型
+ */
+void test_as_double() {
+	CompactValue value;
+	double out = 0;
+	value.set<int64_t>(-3);
+	CHECK(value.as_double(out) && out == -3.0);
+	value.set<uint32_t>(4000000000u);
+	CHECK(value.as_double(out) && out == 4000000000.0);
+	value.set<float>(0.5f);
+	CHECK(value.as_double(out) && out == 0.5);
+	value.set<bool>(true);
+	CHECK(!value.as_double(out));
+	value.type = ValueType::String;
+	CHECK(!value.as_double(out));
+}
+
+} // namespace
+
+int main() {
+	test_type_index();
+	test_round_trip();
+	test_strings();
+	test_batch();
+	test_as_double();
+	std::cout << "CompactValueTest passed" << std::endl;
+	return 0;
+}
@@ -0,0 +1,149 @@
+#include <southbound/TagRegistry.hpp>
+#include <southbound/TestCheck.hpp>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace southbound;
+
+namespace {
+
+DeviceTag make_tag(std::map<std::string, std::string> attributes) {
+	DeviceTag tag;
+	tag.attributes = std::move(attributes);
+	return tag;
+}
+
+DeviceTag numbered_tag(int i) {
+	return make_tag({ { "register_address", std::to_string(i) }, { "data_type", i % 2 ? "float32" : "int16" } });
+}
+
+/**
+ * 同一点位只登记一次，TagId 按登记顺序从 0 分配
+ */
+void test_intern() {
+	TagRegistry registry;
+	DeviceTag a = make_tag({ { "register_address", "100" }, { "data_type", "int16" } });
+	DeviceTag b = make_tag({ { "register_address", "101" }, { "data_type", "int16" } });
+	DeviceTag c = make_tag({ { "register_address", "100" } });
+
+	CHECK(registry.intern(a) == 0);
+	CHECK(registry.intern(b) == 1);
+	CHECK(registry.intern(c) == 2); // 属性子集是不同的点位
+	CHECK(registry.intern(a) == 0);
+	CHECK(registry.intern(make_tag({ { "data_type", "int16" }, { "register_address", "101" } })) == 1);
+	CHECK(registry.intern(DeviceTag()) == 3);
+	CHECK(registry.intern(DeviceTag()) == 3);
+	CHECK(registry.size() == 4);
+}
+
+/**
+ * 查找不登记：未登记的点位、未出现过的字符串与键值错位都返回 INVALID_TAG_ID
+ */
+void test_find() {
+	TagRegistry registry;
+	DeviceTag a = make_tag({ { "register_address", "100" }, { "data_type", "int16" } });
+	CHECK(registry.find(a) == INVALID_TAG_ID);
+
+	TagId id = registry.intern(a);
+	CHECK(registry.find(a) == id);
+	CHECK(registry.find(make_tag({ { "register_address", "100" }, { "data_type", "float32" } })) == INVALID_TAG_ID);
+	CHECK(registry.find(make_tag({ { "register_address", "int16" }, { "data_type", "100" } })) == INVALID_TAG_ID);
+	CHECK(registry.find(make_tag({ { "register_address", "100" } })) == INVALID_TAG_ID);
+	CHECK(registry.find(DeviceTag()) == INVALID_TAG_ID);
+	CHECK(registry.size() == 1);
+}
+
+/**
+ * 由 TagId 还原点位与单个属性；无效 TagId 返回空点位
+ */
+void test_lookup() {
+	TagRegistry registry;
+	DeviceTag a = make_tag({ { "register_address", "100" }, { "data_type", "int16" }, { "byte_order", "" } });
+	TagId id = registry.intern(a);
+
+	CHECK(registry.tag(id).attributes == a.attributes);
+	CHECK(registry.tag(id + 1).attributes.empty());
+	CHECK(registry.tag(INVALID_TAG_ID).attributes.empty());
+
+	std::string value;
+	CHECK(registry.attribute(id, "data_type", value) && value == "int16");
+	CHECK(registry.attribute(id, "byte_order", value) && value.empty());
+	CHECK(!registry.attribute(id, "slave_id", value));
+	CHECK(!registry.attribute(INVALID_TAG_ID, "data_type", value));
+}
+
+/**
+ * 大量点位：哈希表多次扩容后 TagId 不变，重复的字符串只存一份
+ */
+void test_growth() {
+	TagRegistry registry;
+	const int count = 5000;
+	for (int i = 0; i < count; ++i) {
+		CHECK(registry.intern(numbered_tag(i)) == static_cast<TagId>(i));
+	}
+	size_t usage = registry.memory_usage();
+	for (int i = 0; i < count; ++i) {
+		CHECK(registry.find(numbered_tag(i)) == static_cast<TagId>(i));
+		CHECK(registry.intern(numbered_tag(i)) == static_cast<TagId>(i));
+		CHECK(registry.tag(static_cast<TagId>(i)).attributes == numbered_tag(i).attributes);
+	}
+	CHECK(registry.size() == static_cast<size_t>(count));
+	CHECK(registry.memory_usage() == usage);
+}
+
+/**
+ * 并发登记同一组点位：每个点位只分配一个 TagId，各线程得到相同结果
+ */
+void test_concurrent() {
+	TagRegistry registry;
+	const int count = 1000;
+	std::vector<std::vector<TagId>> results(4, std::vector<TagId>(count));
+	std::vector<std::thread> threads;
+	for (size_t t = 0; t < results.size(); ++t) {
+		threads.emplace_back([&registry, &results, t] {
+			for (int i = 0; i < count; ++i) {
+				int index = t % 2 ? count - 1 - i : i;
+				results[t][index] = registry.intern(numbered_tag(index));
+			}
+		});
+	}
+	for (std::thread &thread : threads) {
+		thread.join();
+	}
+
+	CHECK(registry.size() == static_cast<size_t>(count));
+	std::vector<bool> seen(count, false);
+	for (int i = 0; i < count; ++i) {
+		TagId id = results[0][i];
+		CHECK(id < static_cast<TagId>(count) && !seen[id]);
+		seen[id] = true;
+		for (const std::vector<TagId> &result : results) {
+			CHECK(result[i] == id);
+		}
+		CHECK(registry.tag(id).attributes == numbered_tag(i).attributes);
+	}
+}
+
+/**
+ * 每个登记表有进程内唯一的编号
+ */
+void test_uid() {
+	TagRegistry first;
+	TagRegistry second;
+	CHECK(first.uid() != second.uid());
+}
+
+} // namespace
+
+int main() {
+	test_intern();
+	test_find();
+	test_lookup();
+	test_growth();
+	test_concurrent();
+	test_uid();
+	std::cout << "TagRegistryTest passed" << std::endl;
+	return 0;
+}
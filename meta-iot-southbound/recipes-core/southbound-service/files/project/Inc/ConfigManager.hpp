@@ -1,5 +1,6 @@
 #pragma once
 
+#include <southbound/TagRegistry.hpp>
 #include <southbound/Types.hpp>
 #include <string>
 #include <map>
@@ -14,7 +15,7 @@ struct DeviceConfig {
     std::string name;                    // 设备名称
     std::string adapter_type;            // 适配器类型（如modbus-adapter）
     AdapterConfig adapter_config;        // 适配器特定配置
-    std::vector<DeviceTag> tags;         // 设备标签列表
+    std::vector<TagId> tags;             // 设备标签列表（登记表中的 TagId）
 };
 
 /**
@@ -73,8 +74,15 @@ public:
      */
     bool reload_config();
 
+    /**
+     * @brief 获取点位登记表
+     * @return 登记表引用；配置中的设备标签均已登记，重新加载配置后已有 TagId 保持不变
+     */
+    TagRegistry& get_tag_registry();
+
 private:
     ServiceConfig m_config;
+    TagRegistry m_tag_registry;          // 设备标签登记表
     std::string m_config_file;
 
     /**
@@ -57,6 +57,19 @@ public:
                                const std::vector<DeviceTag>& tags, 
                                std::vector<DataValue>& values);
 
+    /**
+     * @brief 读取设备数据，允许使用缓存值
+     * @param device_name 设备名称
+     * @param tags 标签列表
+     * @param values 输出数据值
+     * @param max_age 允许的最长缓存时间，更旧或缺失的标签从设备读取
+     * @return 操作状态码
+     */
+    StatusCode read_device_data(const std::string& device_name, 
+                               const std::vector<DeviceTag>& tags, 
+                               std::vector<DataValue>& values,
+                               std::chrono::milliseconds max_age);
+
     /**
      * @brief 写入设备数据
      * @param device_name 设备名称
@@ -66,6 +79,44 @@ public:
     StatusCode write_device_data(const std::string& device_name, 
                                 const std::map<DeviceTag, DataValue>& tags_and_values);
 
+    /**
+     * @brief 写入设备数据后读取（组合控制周期）
+     * @param device_name 设备名称
+     * @param tags_and_values 待写入的标签和值的映射
+     * @param read_tags 写入后读取的标签列表
+     * @param values 输出数据值
+     * @return 操作状态码
+     */
+    StatusCode write_read_device_data(const std::string& device_name,
+                                      const std::map<DeviceTag, DataValue>& tags_and_values,
+                                      const std::vector<DeviceTag>& read_tags,
+                                      std::vector<DataValue>& values);
+
+    /**
+     * @brief 异步读取设备数据
+     * 立即返回，完成时调用 handler；对多个设备发起时各设备的总线访问并发进行。
+     * @param device_name 设备名称
+     * @param tags 标签列表
+     * @param options 截止时间与取消令牌
+     * @param handler 完成回调（设备不存在时以 NotConnected 立即调用）
+     */
+    void read_device_data_async(const std::string& device_name,
+                                const std::vector<DeviceTag>& tags,
+                                const AsyncOptions& options,
+                                ReadHandler handler);
+
+    /**
+     * @brief 异步写入设备数据
+     * @param device_name 设备名称
+     * @param tags_and_values 标签和值的映射
+     * @param options 截止时间与取消令牌
+     * @param handler 完成回调（设备不存在时以 NotConnected 立即调用）
+     */
+    void write_device_data_async(const std::string& device_name,
+                                 const std::map<DeviceTag, DataValue>& tags_and_values,
+                                 const AsyncOptions& options,
+                                 WriteHandler handler);
+
     /**
      * @brief 订阅设备数据变化
      * @param device_name 设备名称
@@ -77,6 +128,54 @@ public:
                                    const std::vector<DeviceTag>& tags, 
                                    OnDataReceivedCallback callback);
 
+    /**
+     * @brief 批量订阅设备数据变化
+     * @param device_name 设备名称
+     * @param tags 标签列表
+     * @param callback 数据变化回调，以标签在 tags 中的下标回传紧凑数据值
+     * @return 操作状态码
+     */
+    StatusCode subscribe_device_batch(const std::string& device_name,
+                                    const std::vector<DeviceTag>& tags,
+                                    OnBatchDataCallback callback);
+
+    /**
+     * @brief 按 TagId 读取设备数据
+     * @param device_name 设备名称
+     * @param ids 点位 TagId 列表（来自 get_tag_registry()）
+     * @param values 输出数据值
+     * @return 操作状态码
+     */
+    StatusCode read_device_data(const std::string& device_name,
+                               const std::vector<TagId>& ids,
+                               std::vector<DataValue>& values);
+
+    /**
+     * @brief 按 TagId 写入设备数据
+     * @param device_name 设备名称
+     * @param values 待写入的点位与数值
+     * @return 操作状态码
+     */
+    StatusCode write_device_data(const std::string& device_name,
+                                const std::vector<TagValue>& values);
+
+    /**
+     * @brief 按 TagId 订阅设备数据变化
+     * @param device_name 设备名称
+     * @param ids 点位 TagId 列表
+     * @param callback 数据变化回调，以 TagId 回传数值
+     * @return 操作状态码
+     */
+    StatusCode subscribe_device_data(const std::string& device_name,
+                                   const std::vector<TagId>& ids,
+                                   OnTagDataCallback callback);
+
+    /**
+     * @brief 获取点位登记表
+     * @return 登记表引用，可登记配置之外的点位
+     */
+    TagRegistry& get_tag_registry();
+
     /**
      * @brief 获取服务状态
      * @return 服务状态信息
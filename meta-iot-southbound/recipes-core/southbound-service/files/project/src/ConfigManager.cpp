@@ -76,6 +76,15 @@ const std::vector<DeviceConfig>& ConfigManager::get_all_devices() const {
     return m_config.devices;
 }
 
+/**
+ * @brief 获取点位登记表
+ * @return 点位登记表引用
+ * @details 配置中的每个设备标签只登记一次，DeviceConfig 中只保存 TagId
+ */
+TagRegistry& ConfigManager::get_tag_registry() {
+    return m_tag_registry;
+}
+
 /**
  * @brief 验证配置的有效性
  * @return true 配置有效，false 配置无效
@@ -234,7 +243,7 @@ bool ConfigManager::parse_device_section(const std::vector<std::string>& lines,
                 }
                 
                 if (!tag.attributes.empty()) {
-                    device.tags.push_back(tag);
+                    device.tags.push_back(m_tag_registry.intern(tag));
                 }
             } else {
                 // 其他配置项作为适配器配置
@@ -273,12 +282,12 @@ bool ConfigManager::parse_key_value(const std::string& line, std::string& key, s
  * @details 去除字符串开头和结尾的空格、制表符等空白字符
  */
 std::string ConfigManager::trim(const std::string& str) const {
-    size_t first = str.find_first_not_of(' \t');
+    size_t first = str.find_first_not_of(" \t");
     if (first == std::string::npos) {
         return "";
     }
     
-    size_t last = str.find_last_not_of(' \t');
+    size_t last = str.find_last_not_of(" \t");
     return str.substr(first, (last - first + 1));
 }
 
@@ -153,6 +153,29 @@ StatusCode SouthboundService::read_device_data(const std::string& device_name,
     return adapter->read(tags, values);
 }
 
+/**
+ * @brief 读取设备数据，允许使用缓存值
+ * @param device_name 设备名称
+ * @param tags 要读取的标签列表
+ * @param values 输出的数据值列表
+ * @param max_age 允许的最长缓存时间
+ * @return 操作状态码
+ * @details 适配器以订阅扫描维护的最新值应答不超过 max_age 的标签，只有过期或缺失的标签访问设备；
+ *          HMI 与历史库读取相同标签时不再重复占用总线
+ */
+StatusCode SouthboundService::read_device_data(const std::string& device_name, 
+                                             const std::vector<DeviceTag>& tags, 
+                                             std::vector<DataValue>& values,
+                                             std::chrono::milliseconds max_age) {
+    IAdapter* adapter = get_device_adapter(device_name);
+    if (!adapter) {
+        log(0, "Device not found: " + device_name);
+        return StatusCode::NotConnected;
+    }
+    
+    return adapter->read_cached(tags, values, max_age);
+}
+
 /**
  * @brief 写入设备数据
  * @param device_name 设备名称
@@ -171,6 +194,71 @@ StatusCode SouthboundService::write_device_data(const std::string& device_name,
     return adapter->write(tags_and_values);
 }
 
+/**
+ * @brief 写入设备数据后读取
+ * @param device_name 设备名称
+ * @param tags_and_values 待写入的标签和值的映射
+ * @param read_tags 写入后读取的标签列表
+ * @param values 输出数据值
+ * @return 操作状态码
+ * @details 写入与读取配对的控制周期，适配器支持时以一次组合事务完成（如 Modbus FC23）
+ */
+StatusCode SouthboundService::write_read_device_data(const std::string& device_name,
+                                                   const std::map<DeviceTag, DataValue>& tags_and_values,
+                                                   const std::vector<DeviceTag>& read_tags,
+                                                   std::vector<DataValue>& values) {
+    IAdapter* adapter = get_device_adapter(device_name);
+    if (!adapter) {
+        log(0, "Device not found: " + device_name);
+        return StatusCode::NotConnected;
+    }
+    
+    return adapter->write_read(tags_and_values, read_tags, values);
+}
+
+/**
+ * @brief 异步读取设备数据
+ * @param device_name 设备名称
+ * @param tags 要读取的标签列表
+ * @param options 截止时间与取消令牌
+ * @param handler 完成回调
+ * @details 请求交给适配器后立即返回，不等待总线访问完成
+ */
+void SouthboundService::read_device_data_async(const std::string& device_name,
+                                               const std::vector<DeviceTag>& tags,
+                                               const AsyncOptions& options,
+                                               ReadHandler handler) {
+    IAdapter* adapter = get_device_adapter(device_name);
+    if (!adapter) {
+        log(0, "Device not found: " + device_name);
+        handler(StatusCode::NotConnected, std::vector<DataValue>());
+        return;
+    }
+    
+    adapter->read_async(tags, options, handler);
+}
+
+/**
+ * @brief 异步写入设备数据
+ * @param device_name 设备名称
+ * @param tags_and_values 标签和值的映射
+ * @param options 截止时间与取消令牌
+ * @param handler 完成回调
+ */
+void SouthboundService::write_device_data_async(const std::string& device_name,
+                                                const std::map<DeviceTag, DataValue>& tags_and_values,
+                                                const AsyncOptions& options,
+                                                WriteHandler handler) {
+    IAdapter* adapter = get_device_adapter(device_name);
+    if (!adapter) {
+        log(0, "Device not found: " + device_name);
+        handler(StatusCode::NotConnected);
+        return;
+    }
+    
+    adapter->write_async(tags_and_values, options, handler);
+}
+
 /**
  * @brief 订阅设备数据
  * @param device_name 设备名称
@@ -191,10 +279,95 @@ StatusCode SouthboundService::subscribe_device_data(const std::string& device_na
     return adapter->subscribe(tags, callback);
 }
 
+/**
+ * @brief 批量订阅设备数据
+ * @param device_name 设备名称
+ * @param tags 要订阅的标签列表
+ * @param callback 数据接收回调函数
+ * @return 操作状态码
+ * @details 回调收到的序列来自适配器复用的缓冲区，只在回调期间有效
+ */
+StatusCode SouthboundService::subscribe_device_batch(const std::string& device_name,
+                                                   const std::vector<DeviceTag>& tags,
+                                                   OnBatchDataCallback callback) {
+    IAdapter* adapter = get_device_adapter(device_name);
+    if (!adapter) {
+        log(0, "Device not found: " + device_name);
+        return StatusCode::NotConnected;
+    }
+    
+    return adapter->subscribe_batch(tags, callback);
+}
+
+/**
+ * @brief 按 TagId 读取设备数据
+ * @param device_name 设备名称
+ * @param ids 点位 TagId 列表
+ * @param values 输出的数据值列表
+ * @return 操作状态码
+ * @details 点位以登记表中的 TagId 传递，适配器按 TagId 缓存解析结果
+ */
+StatusCode SouthboundService::read_device_data(const std::string& device_name,
+                                             const std::vector<TagId>& ids,
+                                             std::vector<DataValue>& values) {
+    IAdapter* adapter = get_device_adapter(device_name);
+    if (!adapter) {
+        log(0, "Device not found: " + device_name);
+        return StatusCode::NotConnected;
+    }
+    
+    return adapter->read_ids(m_config_manager->get_tag_registry(), ids, values);
+}
+
+/**
+ * @brief 按 TagId 写入设备数据
+ * @param device_name 设备名称
+ * @param values 待写入的点位与数值
+ * @return 操作状态码
+ */
+StatusCode SouthboundService::write_device_data(const std::string& device_name,
+                                              const std::vector<TagValue>& values) {
+    IAdapter* adapter = get_device_adapter(device_name);
+    if (!adapter) {
+        log(0, "Device not found: " + device_name);
+        return StatusCode::NotConnected;
+    }
+    
+    return adapter->write_ids(m_config_manager->get_tag_registry(), values);
+}
+
+/**
+ * @brief 按 TagId 订阅设备数据
+ * @param device_name 设备名称
+ * @param ids 点位 TagId 列表
+ * @param callback 数据接收回调函数
+ * @return 操作状态码
+ * @details 回调以 TagId 回传数值，不构造以 DeviceTag 为键的 map
+ */
+StatusCode SouthboundService::subscribe_device_data(const std::string& device_name,
+                                                  const std::vector<TagId>& ids,
+                                                  OnTagDataCallback callback) {
+    IAdapter* adapter = get_device_adapter(device_name);
+    if (!adapter) {
+        log(0, "Device not found: " + device_name);
+        return StatusCode::NotConnected;
+    }
+    
+    return adapter->subscribe_ids(m_config_manager->get_tag_registry(), ids, callback);
+}
+
+/**
+ * @brief 获取点位登记表
+ * @return 点位登记表引用
+ */
+TagRegistry& SouthboundService::get_tag_registry() {
+    return m_config_manager->get_tag_registry();
+}
+
 /**
  * @brief 获取服务状态
  * @return 服务状态字符串
- * @details 返回服务的详细状态信息，包括运行状态、插件数量、设备数量等
+ * @details 返回服务的详细状态信息，包括运行状态、插件数量、设备数量以及各设备适配器的运行统计
  */
 std::string SouthboundService::get_service_status() const {
     std::lock_guard<std::mutex> lock(m_mutex);
@@ -205,6 +378,18 @@ std::string SouthboundService::get_service_status() const {
     status += "  Loaded Plugins: " + std::to_string(m_plugin_manager->get_loaded_plugins().size()) + "\n";
     status += "  Connected Devices: " + std::to_string(m_device_adapters.size()) + "\n";
     
+    // 适配器运行统计（扫描周期、抖动、错过的截止时间等）
+    for (const auto& pair : m_device_adapters) {
+        AdapterStatistics stats;
+        if (pair.second->get_statistics(stats) != StatusCode::OK) {
+            continue;
+        }
+        status += "  Device " + pair.first + ":\n";
+        for (const auto& item : stats) {
+            status += "    " + item.first + ": " + std::to_string(item.second) + "\n";
+        }
+    }
+    
     return status;
 }
 
@@ -0,0 +1,330 @@
+#include "ConfigManager.hpp"
+#include <southbound/TagRegistry.hpp>
+#include <southbound/Types.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <getopt.h>
+#include <iostream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+using namespace southbound;
+
+// 全局分配计数，用于统计每次操作的堆分配次数
+static std::atomic<uint64_t> g_allocations{0};
+
+void* operator new(std::size_t size) {
+    ++g_allocations;
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+/**
+ * @brief 单项测量结果
+ */
+struct BenchmarkResult {
+    std::string name;
+    size_t tags;
+    uint64_t iterations;
+    double ns_per_op;   // 每次操作（处理全部标签）的耗时
+    double ns_per_tag;  // 折算到每个标签的耗时
+    double allocs_per_op{0.0}; // 每次操作的堆分配次数
+};
+
+/**
+ * @brief 运行参数
+ */
+struct BenchmarkOptions {
+    std::vector<size_t> sizes{10, 100, 1000, 10000, 100000};
+    std::string filter;
+    std::chrono::milliseconds min_time{200};
+    std::string output;
+};
+
+// 防止被测代码被优化掉
+volatile uint64_t g_sink = 0;
+
+/**
+ * @brief 重复执行 body 直到累计耗时不少于 min_time，返回平均耗时
+ * 迭代次数按上一轮耗时倍增，计时不含 setup。
+ * @param body 被测操作，返回校验值
+ */
+template <typename Body>
+BenchmarkResult measure(const std::string& name, size_t tags, const BenchmarkOptions& options, Body&& body) {
+    using clock = std::chrono::steady_clock;
+    uint64_t iterations = 1;
+    for (;;) {
+        uint64_t checksum = 0;
+        uint64_t allocations = g_allocations;
+        auto start = clock::now();
+        for (uint64_t i = 0; i < iterations; ++i) {
+            checksum += body();
+        }
+        auto elapsed = clock::now() - start;
+        allocations = g_allocations - allocations;
+        g_sink = g_sink + checksum;
+        if (elapsed >= options.min_time || iterations >= (uint64_t(1) << 30)) {
+            double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+            double per_op = ns / static_cast<double>(iterations);
+            return BenchmarkResult{name, tags, iterations, per_op, per_op / static_cast<double>(tags),
+                                   static_cast<double>(allocations) / static_cast<double>(iterations)};
+        }
+        iterations *= elapsed < options.min_time / 10 ? 10 : 2;
+    }
+}
+
+/**
+ * @brief 生成 n 个配置文件写法的保持寄存器标签
+ */
+std::vector<DeviceTag> make_tags(size_t n) {
+    std::vector<DeviceTag> tags(n);
+    for (size_t i = 0; i < n; ++i) {
+        tags[i].attributes["address"] = std::to_string(40001 + i % 65535);
+        tags[i].attributes["type"] = "holding";
+        tags[i].attributes["slave"] = std::to_string(1 + i / 65535);
+    }
+    return tags;
+}
+
+/**
+ * @brief 生成含一个设备、n 个标签的配置文件
+ * @return 文件路径；失败返回空串
+ */
+std::string write_config(const std::vector<DeviceTag>& tags) {
+    char path[] = "/tmp/southbound-bench-XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {
+        return std::string();
+    }
+    close(fd);
+
+    std::ofstream file(path);
+    file << "plugin_dir = /usr/lib/southbound/plugins\n"
+         << "log_level = 1\n\n"
+         << "[bench_device]\n"
+         << "adapter_type = modbus-adapter\n"
+         << "connection_type = tcp\n"
+         << "ip_address = 127.0.0.1\n";
+    for (const DeviceTag& tag : tags) {
+        file << "tag = ";
+        const char* separator = "";
+        for (const auto& pair : tag.attributes) {
+            file << separator << pair.first << ":" << pair.second;
+            separator = ",";
+        }
+        file << "\n";
+    }
+    return file ? std::string(path) : std::string();
+}
+
+/**
+ * @brief 运行一种标签数量下的全部测量
+ */
+void run_size(size_t n, const BenchmarkOptions& options, std::vector<BenchmarkResult>& results) {
+    std::vector<DeviceTag> tags = make_tags(n);
+
+    auto run = [&](const char* name, auto&& body) {
+        if (options.filter.empty() || std::strstr(name, options.filter.c_str())) {
+            results.push_back(measure(name, n, options, body));
+            std::cerr << name << " tags=" << n << " " << results.back().ns_per_tag << " ns/tag "
+                      << results.back().allocs_per_op << " allocs/op" << std::endl;
+        }
+    };
+
+    // 配置文件解析（含标签登记）
+    std::string config = write_config(tags);
+    if (!config.empty()) {
+        run("config_load", [&]() -> uint64_t {
+            ConfigManager manager;
+            manager.load_config(config);
+            return manager.get_tag_registry().size();
+        });
+        std::remove(config.c_str());
+    }
+
+    // 新登记表中登记全部标签
+    run("tag_intern", [&]() -> uint64_t {
+        TagRegistry registry;
+        uint64_t sum = 0;
+        for (const DeviceTag& tag : tags) {
+            sum += registry.intern(tag);
+        }
+        return sum;
+    });
+
+    TagRegistry registry;
+    std::vector<TagId> ids(n);
+    for (size_t i = 0; i < n; ++i) {
+        ids[i] = registry.intern(tags[i]);
+    }
+
+    // 以 DeviceTag 查找已登记的 TagId（按 DeviceTag 调用的服务接口）
+    run("tag_find", [&]() -> uint64_t {
+        uint64_t sum = 0;
+        for (const DeviceTag& tag : tags) {
+            sum += registry.find(tag);
+        }
+        return sum;
+    });
+
+    // 读取单个属性（适配器按 TagId 编译标签）
+    std::string value;
+    run("tag_attribute", [&]() -> uint64_t {
+        uint64_t sum = 0;
+        for (TagId id : ids) {
+            sum += registry.attribute(id, "address", value) ? value.size() : 0;
+        }
+        return sum;
+    });
+
+    // 由 TagId 还原 DeviceTag（回调给按 DeviceTag 订阅的调用方）
+    run("tag_resolve", [&]() -> uint64_t {
+        uint64_t sum = 0;
+        for (TagId id : ids) {
+            sum += registry.tag(id).attributes.size();
+        }
+        return sum;
+    });
+}
+
+/**
+ * @brief 转义 JSON 字符串
+ */
+std::string json_string(const std::string& text) {
+    std::string out = "\"";
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            out += '\\';
+        }
+        out += c;
+    }
+    return out + "\"";
+}
+
+/**
+ * @brief 以 JSON 输出全部结果（格式与 modbus-bench 相同）
+ */
+void write_json(std::ostream& out, const std::vector<BenchmarkResult>& results, const BenchmarkOptions& options) {
+    out << "{\n"
+        << "  \"suite\": \"southbound-service\",\n"
+        << "  \"timestamp\": " << std::time(nullptr) << ",\n"
+        << "  \"compiler\": " << json_string(__VERSION__) << ",\n"
+        << "  \"min_time_ms\": " << options.min_time.count() << ",\n"
+        << "  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); ++i) {
+        const BenchmarkResult& r = results[i];
+        out << "    {\"name\": " << json_string(r.name) << ", \"tags\": " << r.tags
+            << ", \"iterations\": " << r.iterations << ", \"ns_per_op\": " << r.ns_per_op
+            << ", \"ns_per_tag\": " << r.ns_per_tag << ", \"allocs_per_op\": " << r.allocs_per_op << "}"
+            << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+/**
+ * @brief 打印使用说明
+ */
+void print_usage(const char* program_name) {
+    std::cout << "Usage: " << program_name << " [OPTIONS]\n"
+              << "Options:\n"
+              << "  -s, --sizes N,N,...   标签数量 (默认: 10,100,1000,10000,100000)\n"
+              << "  -f, --filter TEXT     只运行名称包含 TEXT 的测量\n"
+              << "  -t, --min-time MS     每项测量的最短计时 (默认: 200)\n"
+              << "  -o, --output FILE     JSON 输出文件 (默认: 标准输出)\n"
+              << "  -h, --help            显示此帮助信息\n"
+              << std::endl;
+}
+
+/**
+ * @brief 解析逗号分隔的标签数量
+ */
+bool parse_sizes(const char* text, std::vector<size_t>& sizes) {
+    sizes.clear();
+    std::stringstream stream(text);
+    for (std::string item; std::getline(stream, item, ',');) {
+        char* end = nullptr;
+        unsigned long value = std::strtoul(item.c_str(), &end, 10);
+        if (item.empty() || *end != '\0' || value == 0) {
+            return false;
+        }
+        sizes.push_back(value);
+    }
+    return !sizes.empty();
+}
+
+} // namespace
+
+/**
+ * @brief 主程序入口函数
+ * 进度输出到标准错误，JSON 结果输出到标准输出或 --output 指定的文件。
+ */
+int main(int argc, char* argv[]) {
+    BenchmarkOptions options;
+
+    static struct option long_options[] = {
+        {"sizes",    required_argument, 0, 's'},
+        {"filter",   required_argument, 0, 'f'},
+        {"min-time", required_argument, 0, 't'},
+        {"output",   required_argument, 0, 'o'},
+        {"help",     no_argument,       0, 'h'},
+        {0, 0, 0, 0}
+    };
+
+    int c;
+    while ((c = getopt_long(argc, argv, "s:f:t:o:h", long_options, nullptr)) != -1) {
+        switch (c) {
+            case 's':
+                if (!parse_sizes(optarg, options.sizes)) {
+                    print_usage(argv[0]);
+                    return 1;
+                }
+                break;
+            case 'f': options.filter = optarg; break;
+            case 't': options.min_time = std::chrono::milliseconds(std::atoi(optarg)); break;
+            case 'o': options.output = optarg; break;
+            case 'h':
+                print_usage(argv[0]);
+                return 0;
+            default:
+                print_usage(argv[0]);
+                return 1;
+        }
+    }
+
+    std::vector<BenchmarkResult> results;
+    for (size_t n : options.sizes) {
+        run_size(n, options, results);
+    }
+
+    if (options.output.empty()) {
+        write_json(std::cout, results, options);
+    } else {
+        std::ofstream file(options.output);
+        if (!file) {
+            std::cerr << "无法写入 " << options.output << std::endl;
+            return 1;
+        }
+        write_json(file, results, options);
+    }
+    return 0;
+}